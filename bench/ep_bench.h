@@ -0,0 +1,137 @@
+/**
+ * @brief expression processor benchmark declarations header
+ */
+
+#ifndef EP_BENCH_H_
+#define EP_BENCH_H_
+
+#include <stdint.h>
+
+#include "ep.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// @brief deterministic pseudo-random number generator (splitmix64) representation structure
+typedef struct __EpbRandom {
+    uint64_t state; ///< generator state
+} EpbRandom;
+
+/**
+ * @brief next pseudo-random number getting function
+ * 
+ * @param[in,out] random generator (non-null)
+ * 
+ * @return pseudo-random 64-bit number
+ */
+uint64_t epbRandomNext( EpbRandom *random );
+
+/**
+ * @brief pseudo-random number in range [0, bound) getting function
+ * 
+ * @param[in,out] random generator (non-null)
+ * @param[in]     bound  range bound (non-zero)
+ * 
+ * @return pseudo-random number
+ */
+uint64_t epbRandomBelow( EpbRandom *random, uint64_t bound );
+
+/// @brief count of variables generated expressions use
+#define EPB_VARIABLE_COUNT ((size_t)4)
+
+/// @brief variable names generated expressions use (first one is variable transforms are done by)
+extern const char *const epbVariableNames[EPB_VARIABLE_COUNT];
+
+/// @brief maximal generated expression depth
+#define EPB_MAX_DEPTH 65536u
+
+/// @brief generated node kind
+typedef enum __EpbKind {
+    EPB_KIND_CONSTANT, ///< constant leaf
+    EPB_KIND_VARIABLE, ///< variable leaf
+    EPB_KIND_ADD,      ///< addition
+    EPB_KIND_SUB,      ///< substraction
+    EPB_KIND_MUL,      ///< multiplication
+    EPB_KIND_DIV,      ///< division
+    EPB_KIND_POW,      ///< raising to a power
+    EPB_KIND_POWI,     ///< raising to a small integer power
+    EPB_KIND_NEG,      ///< negation
+    EPB_KIND_LN,       ///< natural logarithm
+    EPB_KIND_EXP,      ///< exponent
+    EPB_KIND_SQRT,     ///< square root
+    EPB_KIND_SIN,      ///< sine
+    EPB_KIND_COS,      ///< cosine
+    EPB_KIND_TAN,      ///< tangent
+    EPB_KIND_ATAN,     ///< arctangent
+
+    EPB_KIND_COUNT,    ///< count of kinds (not a kind)
+} EpbKind;
+
+/// @brief operator mix (relative node kind weights) representation structure
+typedef struct __EpbMix {
+    unsigned int weights[EPB_KIND_COUNT]; ///< kind weights (leaf kinds are used only for leaves, operator kinds only for inner nodes)
+} EpbMix;
+
+/**
+ * @brief operator mix parsing function
+ * 
+ * @param[in]  str mix preset name ('balanced', 'polynomial' or 'transcendental') or 'kind=weight,...' list
+ * @param[out] dst mix destination (non-null)
+ * 
+ * @note kinds are 'const', 'var', 'add', 'sub', 'mul', 'div', 'pow', 'powi' and unary operator names,
+ * list is applied to zero weights.
+ * 
+ * @return true if parsed, false if string is not a mix
+ */
+bool epbMixParse( const char *str, EpbMix *dst );
+
+/// @brief random expression generation parameters representation structure
+typedef struct __EpbGenParams {
+    size_t       size;  ///< approximate node count (generated tree is smaller if depth limit is reached)
+    unsigned int depth; ///< maximal tree depth (at most EPB_MAX_DEPTH)
+    uint64_t     seed;  ///< generator seed, same parameters produce same expression
+    EpbMix       mix;   ///< operator mix
+} EpbGenParams;
+
+/**
+ * @brief random expression generation function
+ * 
+ * @param[in] params generation parameters (non-null, mix has at least one leaf and one operator weight)
+ * 
+ * @return generated expression (NULL if allocation failed)
+ */
+EpNode * epbGenerate( const EpbGenParams *params );
+
+/**
+ * @brief node count getting function
+ * 
+ * @param[in] node node (non-null)
+ * 
+ * @return count of nodes in tree
+ */
+size_t epbNodeCount( const EpNode *node );
+
+/// @brief fixed expression corpus (null-terminated, expressions of epbVariableNames variables)
+extern const char *const epbCorpus[];
+
+/**
+ * @brief allocation counting availability checking function
+ * 
+ * @return true if allocations are counted (malloc family is interposed), false if not
+ */
+bool epbAllocCountingAvailable( void );
+
+/**
+ * @brief allocation counters getting function
+ * 
+ * @param[out] count allocation (malloc, calloc and realloc call) count destination (non-null)
+ * @param[out] bytes allocated byte count destination (non-null)
+ */
+void epbAllocCounters( uint64_t *count, uint64_t *bytes );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // !defined(EP_BENCH_H_)
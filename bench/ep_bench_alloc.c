@@ -0,0 +1,74 @@
+/**
+ * @brief benchmark allocation counting implementation file
+ * 
+ * @note malloc, calloc and realloc are interposed by benchmark executable definitions that forward
+ * to glibc implementation, so allocations made by library (and by libc on its behalf) are counted too.
+ */
+
+#include <stdlib.h>
+
+#include "ep_bench.h"
+
+/// @brief allocation count (atomic)
+static uint64_t epbAllocationCount = 0;
+
+/// @brief allocated byte count (atomic)
+static uint64_t epbAllocatedBytes = 0;
+
+/**
+ * @brief allocation accounting function
+ * 
+ * @param[in] size allocation size
+ */
+static inline void epbAllocAccount( size_t size ) {
+    __atomic_fetch_add(&epbAllocationCount, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&epbAllocatedBytes, (uint64_t)size, __ATOMIC_RELAXED);
+} // epbAllocAccount
+
+#if defined(__GLIBC__)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void * __libc_malloc( size_t size );
+void * __libc_calloc( size_t count, size_t size );
+void * __libc_realloc( void *ptr, size_t size );
+
+void * malloc( size_t size ) __THROW {
+    epbAllocAccount(size);
+    return __libc_malloc(size);
+} // malloc
+
+void * calloc( size_t count, size_t size ) __THROW {
+    epbAllocAccount(count * size);
+    return __libc_calloc(count, size);
+} // calloc
+
+void * realloc( void *ptr, size_t size ) __THROW {
+    epbAllocAccount(size);
+    return __libc_realloc(ptr, size);
+} // realloc
+
+#ifdef __cplusplus
+}
+#endif
+
+bool epbAllocCountingAvailable( void ) {
+    return true;
+} // epbAllocCountingAvailable
+
+#else
+
+bool epbAllocCountingAvailable( void ) {
+    return false;
+} // epbAllocCountingAvailable
+
+#endif // defined(__GLIBC__)
+
+void epbAllocCounters( uint64_t *count, uint64_t *bytes ) {
+    *count = __atomic_load_n(&epbAllocationCount, __ATOMIC_RELAXED);
+    *bytes = __atomic_load_n(&epbAllocatedBytes, __ATOMIC_RELAXED);
+} // epbAllocCounters
+
+// ep_bench_alloc.c
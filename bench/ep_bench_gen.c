@@ -0,0 +1,359 @@
+/**
+ * @brief benchmark expression generator and corpus implementation file
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ep_bench.h"
+
+const char *const epbVariableNames[EPB_VARIABLE_COUNT] = {"x", "y", "z", "w"};
+
+const char *const epbCorpus[] = {
+    // trigonometric identity
+    "sin(x) ^ 2 + cos(x) ^ 2",
+    // normal distribution density
+    "exp(-(x - y) ^ 2 / (2 * z ^ 2)) / (z * sqrt(2 * 3.141592653589793))",
+    // logistic function
+    "1 / (1 + exp(-z * (x - y)))",
+    // Planck's law (frequency form, w is temperature)
+    "2 * 6.62607015e-34 * x ^ 3 / 299792458 ^ 2 / (exp(6.62607015e-34 * x / (1.380649e-23 * w)) - 1)",
+    // Rosenbrock function
+    "(1 - x) ^ 2 + 100 * (y - x ^ 2) ^ 2",
+    // damped oscillator
+    "w * exp(-z * x) * cos(y * x + 0.25)",
+    // relativistic kinetic energy
+    "z * 299792458 ^ 2 * (1 / sqrt(1 - x ^ 2 / 299792458 ^ 2) - 1)",
+    // Lennard-Jones potential
+    "4 * w * ((z / x) ^ 12 - (z / x) ^ 6)",
+    // Rastrigin function
+    "20 + x ^ 2 - 10 * cos(2 * 3.141592653589793 * x) + y ^ 2 - 10 * cos(2 * 3.141592653589793 * y)",
+    // softplus with arctangent tail
+    "ln(1 + exp(x)) + atan(x * y) / (1 + z ^ 2)",
+    // projectile range
+    "x ^ 2 * sin(2 * y) / 9.80665 + tan(y) * w",
+    NULL,
+};
+
+/// @brief kind names (in EpbKind order)
+static const char *const epbKindNames[EPB_KIND_COUNT] = {
+    "const", "var", "add", "sub", "mul", "div", "pow", "powi",
+    "neg", "ln", "exp", "sqrt", "sin", "cos", "tan", "atan",
+};
+
+uint64_t epbRandomNext( EpbRandom *random ) {
+    uint64_t z = (random->state += 0x9E3779B97F4A7C15ull);
+
+    z = (z ^ z >> 30) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ z >> 27) * 0x94D049BB133111EBull;
+    return z ^ z >> 31;
+} // epbRandomNext
+
+uint64_t epbRandomBelow( EpbRandom *random, uint64_t bound ) {
+    assert(bound != 0);
+
+    return epbRandomNext(random) % bound;
+} // epbRandomBelow
+
+bool epbMixParse( const char *str, EpbMix *dst ) {
+    assert(str != NULL);
+    assert(dst != NULL);
+
+    //                                               const var add sub mul div pow powi neg ln exp sqrt sin cos tan atan
+    static const EpbMix balanced       = { .weights = {2,    3,  3,  2,  3,  1,  1,  1,   1,  1, 1,  1,   1,  1,  0,  0} };
+    static const EpbMix polynomial     = { .weights = {3,    4,  4,  2,  4,  0,  0,  2,   1,  0, 0,  0,   0,  0,  0,  0} };
+    static const EpbMix transcendental = { .weights = {1,    2,  2,  1,  2,  1,  1,  0,   1,  2, 2,  1,   2,  2,  1,  1} };
+
+    if (strcmp(str, "balanced") == 0) {
+        *dst = balanced;
+        return true;
+    }
+    if (strcmp(str, "polynomial") == 0) {
+        *dst = polynomial;
+        return true;
+    }
+    if (strcmp(str, "transcendental") == 0) {
+        *dst = transcendental;
+        return true;
+    }
+
+    memset(dst, 0, sizeof(EpbMix));
+
+    while (*str != '\0') {
+        const char *separator = strchr(str, '=');
+
+        if (separator == NULL)
+            return false;
+
+        size_t kind = 0;
+
+        while (kind < EPB_KIND_COUNT && !(true
+            && strlen(epbKindNames[kind]) == (size_t)(separator - str)
+            && memcmp(epbKindNames[kind], str, (size_t)(separator - str)) == 0
+        ))
+            kind++;
+
+        if (kind == EPB_KIND_COUNT)
+            return false;
+
+        char *end = NULL;
+        const unsigned long weight = strtoul(separator + 1, &end, 10);
+
+        if (end == separator + 1 || (*end != ',' && *end != '\0'))
+            return false;
+
+        dst->weights[kind] = (unsigned int)weight;
+        str = *end == ',' ? end + 1 : end;
+    }
+
+    return true;
+} // epbMixParse
+
+/**
+ * @brief weighted kind selection function
+ * 
+ * @param[in,out] random generator (non-null)
+ * @param[in]     mix    operator mix (non-null)
+ * @param[in]     first  first kind to select from
+ * @param[in]     last   last kind to select from (inclusive)
+ * 
+ * @return selected kind (EPB_KIND_COUNT if all weights in range are zero)
+ */
+static EpbKind epbSelectKind( EpbRandom *random, const EpbMix *mix, EpbKind first, EpbKind last ) {
+    uint64_t total = 0;
+
+    for (int kind = first; kind <= last; kind++)
+        total += mix->weights[kind];
+
+    if (total == 0)
+        return EPB_KIND_COUNT;
+
+    uint64_t value = epbRandomBelow(random, total);
+
+    for (int kind = first; kind <= last; kind++) {
+        if (value < mix->weights[kind])
+            return (EpbKind)kind;
+        value -= mix->weights[kind];
+    }
+
+    return EPB_KIND_COUNT;
+} // epbSelectKind
+
+/// @brief generation stack frame
+typedef struct __EpbGenFrame {
+    size_t       budget; ///< node budget of subtree
+    unsigned int depth;  ///< subtree depth limit
+    EpbKind      kind;   ///< subtree root kind (EPB_KIND_COUNT if not selected yet, operands are generated otherwise)
+} EpbGenFrame;
+
+/**
+ * @brief array growth function
+ * 
+ * @param[in,out] array    array pointer (non-null)
+ * @param[in,out] capacity array capacity (non-null)
+ * @param[in]     required required element count
+ * @param[in]     elemSize element size
+ * 
+ * @return true if array has required capacity, false if allocation failed
+ */
+static bool epbReserve( void **array, size_t *capacity, size_t required, size_t elemSize ) {
+    if (required <= *capacity)
+        return true;
+
+    size_t newCapacity = *capacity == 0 ? 64 : *capacity * 2;
+
+    while (newCapacity < required)
+        newCapacity *= 2;
+
+    void *newArray = realloc(*array, newCapacity * elemSize);
+
+    if (newArray == NULL)
+        return false;
+
+    *array = newArray;
+    *capacity = newCapacity;
+    return true;
+} // epbReserve
+
+/**
+ * @brief generated leaf construction function
+ * 
+ * @param[in,out] random generator (non-null)
+ * @param[in]     mix    operator mix (non-null)
+ * 
+ * @return leaf node (NULL if allocation failed)
+ */
+static EpNode * epbGenerateLeaf( EpbRandom *random, const EpbMix *mix ) {
+    if (epbSelectKind(random, mix, EPB_KIND_CONSTANT, EPB_KIND_VARIABLE) == EPB_KIND_CONSTANT)
+        return epNodeConstant((double)(1 + epbRandomBelow(random, 999)) / 100.0);
+    return epNodeVariable(epbVariableNames[epbRandomBelow(random, EPB_VARIABLE_COUNT)]);
+} // epbGenerateLeaf
+
+/**
+ * @brief operator node from operands construction function
+ * 
+ * @param[in,out] random generator (non-null)
+ * @param[in]     kind   operator kind
+ * @param[in]     lhs    left hand side or operand (ownership is taken)
+ * @param[in]     rhs    right hand side (ownership is taken, NULL for unary operators and POWI)
+ * 
+ * @return operator node (NULL if allocation failed)
+ */
+static EpNode * epbGenerateOperator( EpbRandom *random, EpbKind kind, EpNode *lhs, EpNode *rhs ) {
+    switch (kind) {
+    case EPB_KIND_ADD  : return epNodeBinaryOperator(EP_BINARY_OPERATOR_ADD, lhs, rhs);
+    case EPB_KIND_SUB  : return epNodeBinaryOperator(EP_BINARY_OPERATOR_SUB, lhs, rhs);
+    case EPB_KIND_MUL  : return epNodeBinaryOperator(EP_BINARY_OPERATOR_MUL, lhs, rhs);
+    case EPB_KIND_DIV  : return epNodeBinaryOperator(EP_BINARY_OPERATOR_DIV, lhs, rhs);
+    case EPB_KIND_POW  : return epNodeBinaryOperator(EP_BINARY_OPERATOR_POW, lhs, rhs);
+    case EPB_KIND_POWI : return epNodeBinaryOperator(EP_BINARY_OPERATOR_POWI, lhs, epNodeConstant((double)(2 + epbRandomBelow(random, 3))));
+    case EPB_KIND_NEG  : return epNodeUnaryOperator(EP_UNARY_OPERATOR_NEG, lhs);
+    case EPB_KIND_LN   : return epNodeUnaryOperator(EP_UNARY_OPERATOR_LN, lhs);
+    case EPB_KIND_EXP  : return epNodeUnaryOperator(EP_UNARY_OPERATOR_EXP, lhs);
+    case EPB_KIND_SQRT : return epNodeUnaryOperator(EP_UNARY_OPERATOR_SQRT, lhs);
+    case EPB_KIND_SIN  : return epNodeUnaryOperator(EP_UNARY_OPERATOR_SIN, lhs);
+    case EPB_KIND_COS  : return epNodeUnaryOperator(EP_UNARY_OPERATOR_COS, lhs);
+    case EPB_KIND_TAN  : return epNodeUnaryOperator(EP_UNARY_OPERATOR_TAN, lhs);
+    case EPB_KIND_ATAN : return epNodeUnaryOperator(EP_UNARY_OPERATOR_ATAN, lhs);
+
+    default:
+        epNodeDtor(lhs);
+        epNodeDtor(rhs);
+        return NULL;
+    }
+} // epbGenerateOperator
+
+EpNode * epbGenerate( const EpbGenParams *params ) {
+    assert(params != NULL);
+
+    EpbRandom random = { .state = params->seed };
+    EpbGenFrame *frames = NULL;
+    size_t frameCount = 0;
+    size_t frameCapacity = 0;
+    EpNode **operands = NULL;
+    size_t operandCount = 0;
+    size_t operandCapacity = 0;
+    EpNode *result = NULL;
+
+    if (!epbReserve((void **)&frames, &frameCapacity, 1, sizeof(EpbGenFrame)))
+        return NULL;
+
+    frames[frameCount++] = (EpbGenFrame) {
+        .budget = params->size == 0 ? 1 : params->size,
+        .depth = params->depth > EPB_MAX_DEPTH ? EPB_MAX_DEPTH : params->depth,
+        .kind = EPB_KIND_COUNT,
+    };
+
+    // tree is generated by explicit stack, operands are generated before their operator is constructed
+    while (frameCount != 0) {
+        const EpbGenFrame frame = frames[--frameCount];
+
+        if (!epbReserve((void **)&frames, &frameCapacity, frameCount + 3, sizeof(EpbGenFrame))
+            || !epbReserve((void **)&operands, &operandCapacity, operandCount + 1, sizeof(EpNode *))
+        )
+            goto __epbGenerate__end;
+
+        if (frame.kind != EPB_KIND_COUNT) {
+            const bool isBinary = frame.kind >= EPB_KIND_ADD && frame.kind <= EPB_KIND_POW;
+            EpNode *rhs = isBinary ? operands[--operandCount] : NULL;
+            EpNode *lhs = operands[--operandCount];
+
+            if ((operands[operandCount] = epbGenerateOperator(&random, frame.kind, lhs, rhs)) == NULL)
+                goto __epbGenerate__end;
+            operandCount++;
+            continue;
+        }
+
+        // binary operators (and integer power with constant exponent) take at least 3 nodes
+        EpbKind kind = EPB_KIND_COUNT;
+
+        if (frame.budget >= 3 && frame.depth > 1)
+            kind = epbSelectKind(&random, &params->mix, EPB_KIND_ADD, EPB_KIND_ATAN);
+        else if (frame.budget == 2 && frame.depth > 1)
+            kind = epbSelectKind(&random, &params->mix, EPB_KIND_NEG, EPB_KIND_ATAN);
+
+        if (kind == EPB_KIND_COUNT) {
+            if ((operands[operandCount] = epbGenerateLeaf(&random, &params->mix)) == NULL)
+                goto __epbGenerate__end;
+            operandCount++;
+            continue;
+        }
+
+        frames[frameCount++] = (EpbGenFrame) { .budget = frame.budget, .depth = frame.depth, .kind = kind };
+
+        if (kind >= EPB_KIND_ADD && kind <= EPB_KIND_POW) {
+            const size_t lhsBudget = 1 + (size_t)epbRandomBelow(&random, frame.budget - 2);
+
+            frames[frameCount++] = (EpbGenFrame) { .budget = frame.budget - 1 - lhsBudget, .depth = frame.depth - 1, .kind = EPB_KIND_COUNT };
+            frames[frameCount++] = (EpbGenFrame) { .budget = lhsBudget, .depth = frame.depth - 1, .kind = EPB_KIND_COUNT };
+        } else {
+            frames[frameCount++] = (EpbGenFrame) {
+                .budget = frame.budget - (kind == EPB_KIND_POWI ? 2 : 1),
+                .depth = frame.depth - 1,
+                .kind = EPB_KIND_COUNT,
+            };
+        }
+    }
+
+    assert(operandCount == 1);
+    result = operands[--operandCount];
+
+__epbGenerate__end:
+    for (size_t i = 0; i < operandCount; i++)
+        epNodeDtor(operands[i]);
+    free(operands);
+    free(frames);
+    return result;
+} // epbGenerate
+
+size_t epbNodeCount( const EpNode *node ) {
+    assert(node != NULL);
+
+    const EpNode *localStack[64];
+    const EpNode **stack = localStack;
+    size_t stackSize = 0;
+    size_t stackCapacity = sizeof(localStack) / sizeof(localStack[0]);
+    size_t count = 0;
+
+    stack[stackSize++] = node;
+
+    while (stackSize != 0) {
+        const EpNode *current = stack[--stackSize];
+
+        count++;
+
+        if (stackSize + 2 > stackCapacity) {
+            const EpNode **newStack = (const EpNode **)malloc(sizeof(EpNode *) * stackCapacity * 2);
+
+            if (newStack == NULL)
+                break;
+
+            memcpy(newStack, stack, sizeof(EpNode *) * stackSize);
+            if (stack != localStack)
+                free(stack);
+            stack = newStack;
+            stackCapacity *= 2;
+        }
+
+        switch (current->type) {
+        case EP_NODE_BINARY_OPERATOR:
+            stack[stackSize++] = current->binaryOperator.rhs;
+            stack[stackSize++] = current->binaryOperator.lhs;
+            break;
+
+        case EP_NODE_UNARY_OPERATOR:
+            stack[stackSize++] = current->unaryOperator.operand;
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    if (stack != localStack)
+        free(stack);
+    return count;
+} // epbNodeCount
+
+// ep_bench_gen.c
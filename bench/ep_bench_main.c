@@ -0,0 +1,565 @@
+/**
+ * @brief expression processor benchmark main function
+ * 
+ * @note results are written as JSON document, so runs can be compared by scripts
+ */
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "ep_bench.h"
+
+/// @brief maximal count of generated expression sizes
+#define EPB_MAX_SIZES ((size_t)16)
+
+/// @brief benchmark case (expression set operation is applied to) representation structure
+typedef struct __EpbCase {
+    char      name[32];  ///< case name
+    EpNode ** nodes;     ///< expressions
+    char   ** texts;     ///< expression infix dumps (parsing input)
+    size_t    count;     ///< count of expressions
+    size_t    nodeCount; ///< total count of nodes in expressions
+} EpbCase;
+
+/// @brief benchmark run context representation structure
+typedef struct __EpbContext {
+    double          minTime;                        ///< minimal measured time of single benchmark (in seconds)
+    unsigned int    taylorOrder;                    ///< count of Taylor series participants
+    size_t          taylorMaxNodes;                 ///< maximal case node count Taylor series is benchmarked on
+    const char    * filter;                         ///< 'case/operation' substring benchmarks are filtered by (nullable)
+    EpNode        * taylorPoint;                    ///< Taylor series point
+    EpNode        * substitution;                   ///< expression first variable is substituted by
+    EpVariable      variables[EPB_VARIABLE_COUNT];  ///< computation variable values
+    EpBuffer        dumpBuffer;                     ///< reused dump buffer
+    volatile double sink;                           ///< computation result sink (keeps results alive)
+    FILE          * out;                            ///< JSON output
+    bool            anyResult;                      ///< true if at least one result is written
+} EpbContext;
+
+/**
+ * @brief benchmarked operation function pointer
+ * 
+ * @param[in,out] context   benchmark context (non-null)
+ * @param[in]     benchCase case to apply operation to each expression of (non-null)
+ * 
+ * @return true if succeeded, false if operation failed
+ */
+typedef bool (* EpbOperation)( EpbContext *context, const EpbCase *benchCase );
+
+/**
+ * @brief parsing benchmark operation
+ * 
+ * @param[in,out] context   benchmark context (non-null)
+ * @param[in]     benchCase case (non-null)
+ * 
+ * @return true if succeeded, false if operation failed
+ */
+static bool epbOperationParse( EpbContext *context, const EpbCase *benchCase ) {
+    (void)context; // operation has no parameters
+
+    for (size_t i = 0; i < benchCase->count; i++) {
+        EpParseExpressionResult result = epParseExpression(benchCase->texts[i]);
+
+        if (result.status != EP_PARSE_EXPRESSION_OK)
+            return false;
+        epNodeDtor(result.ok.result);
+    }
+    return true;
+} // epbOperationParse
+
+/**
+ * @brief optimization benchmark operation
+ * 
+ * @param[in,out] context   benchmark context (non-null)
+ * @param[in]     benchCase case (non-null)
+ * 
+ * @return true if succeeded, false if operation failed
+ */
+static bool epbOperationOptimize( EpbContext *context, const EpbCase *benchCase ) {
+    (void)context; // operation has no parameters
+
+    for (size_t i = 0; i < benchCase->count; i++) {
+        EpNode *result = epNodeOptimize(benchCase->nodes[i]);
+
+        if (result == NULL)
+            return false;
+        epNodeDtor(result);
+    }
+    return true;
+} // epbOperationOptimize
+
+/**
+ * @brief derivative benchmark operation
+ * 
+ * @param[in,out] context   benchmark context (non-null)
+ * @param[in]     benchCase case (non-null)
+ * 
+ * @return true if succeeded, false if operation failed
+ */
+static bool epbOperationDerivative( EpbContext *context, const EpbCase *benchCase ) {
+    (void)context; // operation has no parameters
+
+    for (size_t i = 0; i < benchCase->count; i++) {
+        EpNode *result = epNodeDerivative(benchCase->nodes[i], epbVariableNames[0]);
+
+        if (result == NULL)
+            return false;
+        epNodeDtor(result);
+    }
+    return true;
+} // epbOperationDerivative
+
+/**
+ * @brief Taylor series benchmark operation
+ * 
+ * @param[in,out] context   benchmark context (non-null)
+ * @param[in]     benchCase case (non-null)
+ * 
+ * @return true if succeeded, false if operation failed
+ */
+static bool epbOperationTaylor( EpbContext *context, const EpbCase *benchCase ) {
+    for (size_t i = 0; i < benchCase->count; i++) {
+        EpNode *result = epNodeTaylor(benchCase->nodes[i], epbVariableNames[0], context->taylorPoint, context->taylorOrder);
+
+        if (result == NULL)
+            return false;
+        epNodeDtor(result);
+    }
+    return true;
+} // epbOperationTaylor
+
+/**
+ * @brief substitution benchmark operation
+ * 
+ * @param[in,out] context   benchmark context (non-null)
+ * @param[in]     benchCase case (non-null)
+ * 
+ * @return true if succeeded, false if operation failed
+ */
+static bool epbOperationSubstitute( EpbContext *context, const EpbCase *benchCase ) {
+    const EpSubstitution substitution = { .name = epbVariableNames[0], .node = context->substitution };
+
+    for (size_t i = 0; i < benchCase->count; i++) {
+        EpNode *result = epNodeSubstitute(benchCase->nodes[i], &substitution, 1);
+
+        if (result == NULL)
+            return false;
+        epNodeDtor(result);
+    }
+    return true;
+} // epbOperationSubstitute
+
+/**
+ * @brief computation benchmark operation
+ * 
+ * @param[in,out] context   benchmark context (non-null)
+ * @param[in]     benchCase case (non-null)
+ * 
+ * @return true if succeeded, false if operation failed
+ */
+static bool epbOperationCompute( EpbContext *context, const EpbCase *benchCase ) {
+    for (size_t i = 0; i < benchCase->count; i++) {
+        EpNodeComputeResult result = epNodeCompute(benchCase->nodes[i], context->variables, EPB_VARIABLE_COUNT);
+
+        if (result.status != EP_NODE_COMPUTE_OK)
+            return false;
+        context->sink = context->sink + result.ok;
+    }
+    return true;
+} // epbOperationCompute
+
+/**
+ * @brief dumping benchmark operation
+ * 
+ * @param[in,out] context   benchmark context (non-null)
+ * @param[in]     benchCase case (non-null)
+ * 
+ * @note dump is written to reused buffer, so file output is not measured
+ * 
+ * @return true if succeeded, false if operation failed
+ */
+static bool epbOperationDump( EpbContext *context, const EpbCase *benchCase ) {
+    for (size_t i = 0; i < benchCase->count; i++) {
+        context->dumpBuffer.size = 0;
+
+        if (!epNodeDumpToBuffer(&context->dumpBuffer, benchCase->nodes[i], EP_DUMP_INFIX_EXPRESSION))
+            return false;
+    }
+    return true;
+} // epbOperationDump
+
+/// @brief benchmarked operations
+static const struct {
+    const char   * name;      ///< operation name
+    EpbOperation   operation; ///< operation
+} epbOperations[] = {
+    {"parse",      epbOperationParse     },
+    {"optimize",   epbOperationOptimize  },
+    {"derivative", epbOperationDerivative},
+    {"taylor",     epbOperationTaylor    },
+    {"substitute", epbOperationSubstitute},
+    {"compute",    epbOperationCompute   },
+    {"dump",       epbOperationDump      },
+};
+
+/**
+ * @brief monotonic time getting function
+ * 
+ * @return time (in seconds)
+ */
+static double epbTime( void ) {
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double)time.tv_sec + (double)time.tv_nsec * 1e-9;
+} // epbTime
+
+/**
+ * @brief JSON number writing function
+ * 
+ * @param[in] out   output file (non-null)
+ * @param[in] value value to write (null is written for non-finite ones)
+ */
+static void epbWriteNumber( FILE *out, double value ) {
+    char text[EP_DOUBLE_FORMAT_SIZE];
+
+    if (!isfinite(value)) {
+        fputs("null", out);
+        return;
+    }
+
+    fwrite(text, 1, epDoubleFormat(value, text), out);
+} // epbWriteNumber
+
+/**
+ * @brief single benchmark running function
+ * 
+ * @param[in,out] context   benchmark context (non-null)
+ * @param[in]     benchCase case (non-null)
+ * @param[in]     name      operation name (non-null)
+ * @param[in]     operation operation (non-null)
+ * 
+ * @note operation is repeated with growing iteration count until measurement takes at least minimal time
+ */
+static void epbRun( EpbContext *context, const EpbCase *benchCase, const char *name, EpbOperation operation ) {
+    char fullName[64];
+
+    snprintf(fullName, sizeof(fullName), "%s/%s", benchCase->name, name);
+    if (context->filter != NULL && strstr(fullName, context->filter) == NULL)
+        return;
+
+    // warm up (and check if operation succeeds at all)
+    if (!operation(context, benchCase)) {
+        fprintf(stderr, "%s: operation failed\n", fullName);
+        return;
+    }
+
+    uint64_t iterations = 1;
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+    double elapsed = 0.0;
+
+    for (;;) {
+        uint64_t allocationsBefore, bytesBefore, allocationsAfter, bytesAfter;
+
+        epbAllocCounters(&allocationsBefore, &bytesBefore);
+        const double start = epbTime();
+
+        for (uint64_t i = 0; i < iterations; i++)
+            operation(context, benchCase);
+
+        elapsed = epbTime() - start;
+        epbAllocCounters(&allocationsAfter, &bytesAfter);
+
+        allocations = allocationsAfter - allocationsBefore;
+        bytes = bytesAfter - bytesBefore;
+
+        if (elapsed >= context->minTime)
+            break;
+
+        // next iteration count is estimated to take minimal time with 20% margin, but grows at most tenfold
+        const double estimate = elapsed > 0.0
+            ? (double)iterations * context->minTime * 1.2 / elapsed
+            : (double)iterations * 10.0;
+
+        iterations = estimate > (double)iterations * 10.0
+            ? iterations * 10
+            : (uint64_t)estimate + 1;
+    }
+
+    const double secondsPerOp = elapsed / (double)iterations;
+    const bool countAllocations = epbAllocCountingAvailable();
+
+    fprintf(context->out, "%s\n    {\"case\": \"%s\", \"operation\": \"%s\", \"expressions\": %zu, \"nodes\": %zu, \"iterations\": %llu, \"nsPerOp\": ",
+        context->anyResult ? "," : "",
+        benchCase->name,
+        name,
+        benchCase->count,
+        benchCase->nodeCount,
+        (unsigned long long)iterations
+    );
+    epbWriteNumber(context->out, secondsPerOp * 1e9);
+    fputs(", \"nodesPerSecond\": ", context->out);
+    epbWriteNumber(context->out, (double)benchCase->nodeCount / secondsPerOp);
+    fputs(", \"allocationsPerOp\": ", context->out);
+    epbWriteNumber(context->out, countAllocations ? (double)allocations / (double)iterations : NAN);
+    fputs(", \"bytesPerOp\": ", context->out);
+    epbWriteNumber(context->out, countAllocations ? (double)bytes / (double)iterations : NAN);
+    fputs("}", context->out);
+    fflush(context->out);
+
+    context->anyResult = true;
+} // epbRun
+
+/**
+ * @brief case from nodes construction function
+ * 
+ * @param[out] dst   case destination (non-null)
+ * @param[in]  name  case name (non-null)
+ * @param[in]  nodes expressions (ownership is taken, array is allocated by malloc)
+ * @param[in]  count count of expressions
+ * 
+ * @return true if succeeded, false if allocation failed (case is destroyed then)
+ */
+static bool epbCaseCtor( EpbCase *dst, const char *name, EpNode **nodes, size_t count ) {
+    snprintf(dst->name, sizeof(dst->name), "%s", name);
+    dst->nodes = nodes;
+    dst->count = count;
+    dst->nodeCount = 0;
+    dst->texts = (char **)calloc(count, sizeof(char *));
+
+    if (dst->texts == NULL)
+        return false;
+
+    for (size_t i = 0; i < count; i++) {
+        dst->nodeCount += epbNodeCount(nodes[i]);
+        if ((dst->texts[i] = epNodeDumpToString(nodes[i], EP_DUMP_INFIX_EXPRESSION)) == NULL)
+            return false;
+    }
+
+    return true;
+} // epbCaseCtor
+
+/**
+ * @brief case destructor
+ * 
+ * @param[in] benchCase case to destroy (non-null)
+ */
+static void epbCaseDtor( EpbCase *benchCase ) {
+    for (size_t i = 0; i < benchCase->count; i++) {
+        epNodeDtor(benchCase->nodes[i]);
+        if (benchCase->texts != NULL)
+            free(benchCase->texts[i]);
+    }
+
+    free(benchCase->nodes);
+    free(benchCase->texts);
+} // epbCaseDtor
+
+/**
+ * @brief all operations on case running function
+ * 
+ * @param[in,out] context   benchmark context (non-null)
+ * @param[in]     benchCase case (non-null)
+ */
+static void epbRunCase( EpbContext *context, const EpbCase *benchCase ) {
+    for (size_t i = 0; i < sizeof(epbOperations) / sizeof(epbOperations[0]); i++) {
+        // Taylor series takes several derivatives, so its size grows too fast on big expressions
+        if (epbOperations[i].operation == epbOperationTaylor && benchCase->nodeCount > context->taylorMaxNodes)
+            continue;
+
+        epbRun(context, benchCase, epbOperations[i].name, epbOperations[i].operation);
+    }
+} // epbRunCase
+
+/**
+ * @brief usage printing function
+ */
+static void epbPrintUsage( void ) {
+    printf("usage: ./exproc_bench [options]\n");
+    printf("    --size N[,N...]     generated expression sizes (in nodes, default 64,4096,262144)\n");
+    printf("    --depth N           generated expression maximal depth (default 48)\n");
+    printf("    --seed N            generator seed (default 1)\n");
+    printf("    --mix MIX           operator mix: balanced, polynomial, transcendental or kind=weight,... (default balanced)\n");
+    printf("    --min-time SECONDS  minimal measured time of single benchmark (default 0.25)\n");
+    printf("    --taylor-order N    count of Taylor series participants (default 4)\n");
+    printf("    --taylor-max N      maximal expression size Taylor series is benchmarked on (default 256)\n");
+    printf("    --filter TEXT       run only benchmarks 'case/operation' name of contains TEXT\n");
+    printf("    --no-corpus         don't benchmark fixed expression corpus\n");
+    printf("    --output PATH       JSON output file (default is standard output)\n");
+} // epbPrintUsage
+
+/**
+ * @brief benchmark main function
+ * 
+ * @param[in] argc argument count
+ * @param[in] argv argument values
+ * 
+ * @return exit status
+ */
+int main( const int argc, const char **argv ) {
+    size_t sizes[EPB_MAX_SIZES] = {64, 4096, 262144};
+    size_t sizeCount = 3;
+    EpbGenParams params = { .size = 0, .depth = 48, .seed = 1, .mix = { .weights = {0} } };
+    const char *mixName = "balanced";
+    const char *outputPath = NULL;
+    bool useCorpus = true;
+    EpbContext context = {
+        .minTime = 0.25,
+        .taylorOrder = 4,
+        .taylorMaxNodes = 256,
+        .filter = NULL,
+        .taylorPoint = NULL,
+        .substitution = NULL,
+        .variables = {
+            {epbVariableNames[0], 0.37},
+            {epbVariableNames[1], 1.25},
+            {epbVariableNames[2], 0.8},
+            {epbVariableNames[3], 2.5},
+        },
+        .dumpBuffer = { .data = NULL, .size = 0, .capacity = 0 },
+        .sink = 0.0,
+        .out = NULL,
+        .anyResult = false,
+    };
+
+    for (int i = 1; i < argc; i++) {
+        const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+
+        if (strcmp(argv[i], "--help") == 0) {
+            epbPrintUsage();
+            return 0;
+        }
+
+        if (strcmp(argv[i], "--no-corpus") == 0) {
+            useCorpus = false;
+            continue;
+        }
+
+        if (value == NULL) {
+            epbPrintUsage();
+            return 1;
+        }
+        i++;
+
+        if (strcmp(argv[i - 1], "--size") == 0) {
+            sizeCount = 0;
+            for (const char *str = value; *str != '\0' && sizeCount < EPB_MAX_SIZES; ) {
+                char *end = NULL;
+
+                sizes[sizeCount++] = (size_t)strtoull(str, &end, 10);
+                str = *end == ',' ? end + 1 : end;
+            }
+        } else if (strcmp(argv[i - 1], "--depth") == 0) {
+            params.depth = (unsigned int)strtoul(value, NULL, 10);
+        } else if (strcmp(argv[i - 1], "--seed") == 0) {
+            params.seed = strtoull(value, NULL, 10);
+        } else if (strcmp(argv[i - 1], "--mix") == 0) {
+            mixName = value;
+        } else if (strcmp(argv[i - 1], "--min-time") == 0) {
+            context.minTime = strtod(value, NULL);
+        } else if (strcmp(argv[i - 1], "--taylor-order") == 0) {
+            context.taylorOrder = (unsigned int)strtoul(value, NULL, 10);
+        } else if (strcmp(argv[i - 1], "--taylor-max") == 0) {
+            context.taylorMaxNodes = (size_t)strtoull(value, NULL, 10);
+        } else if (strcmp(argv[i - 1], "--filter") == 0) {
+            context.filter = value;
+        } else if (strcmp(argv[i - 1], "--output") == 0) {
+            outputPath = value;
+        } else {
+            epbPrintUsage();
+            return 1;
+        }
+    }
+
+    if (!epbMixParse(mixName, &params.mix)) {
+        fprintf(stderr, "Invalid operator mix \"%s\".\n", mixName);
+        return 1;
+    }
+
+    context.out = outputPath != NULL ? fopen(outputPath, "w") : stdout;
+    if (context.out == NULL) {
+        fprintf(stderr, "Can't open \"%s\" for writing.\n", outputPath);
+        return 1;
+    }
+
+    context.taylorPoint = epNodeConstant(0.5);
+    context.substitution = epNodeBinaryOperator(EP_BINARY_OPERATOR_ADD, epNodeVariable(epbVariableNames[1]), epNodeConstant(1.0));
+
+#ifdef __OPTIMIZE__
+    const bool optimized = true;
+#else
+    const bool optimized = false;
+#endif
+
+    fprintf(context.out, "{\n  \"optimized\": %s,\n  \"allocationCounting\": %s,\n  \"mix\": \"%s\",\n  \"depth\": %u,\n  \"seed\": %llu,\n  \"minTime\": ",
+        optimized ? "true" : "false",
+        epbAllocCountingAvailable() ? "true" : "false",
+        mixName,
+        params.depth,
+        (unsigned long long)params.seed
+    );
+    epbWriteNumber(context.out, context.minTime);
+    fprintf(context.out, ",\n  \"taylorOrder\": %u,\n  \"results\": [", context.taylorOrder);
+
+    int status = 0;
+
+    if (useCorpus) {
+        size_t count = 0;
+
+        while (epbCorpus[count] != NULL)
+            count++;
+
+        EpNode **nodes = (EpNode **)calloc(count, sizeof(EpNode *));
+        EpbCase benchCase = {};
+
+        for (size_t i = 0; nodes != NULL && i < count; i++) {
+            EpParseExpressionResult result = epParseExpression(epbCorpus[i]);
+
+            assert(result.status == EP_PARSE_EXPRESSION_OK);
+            nodes[i] = result.ok.result;
+        }
+
+        if (nodes != NULL && epbCaseCtor(&benchCase, "corpus", nodes, count))
+            epbRunCase(&context, &benchCase);
+        else
+            status = 1;
+
+        epbCaseDtor(&benchCase);
+    }
+
+    for (size_t i = 0; i < sizeCount; i++) {
+        char name[32];
+        EpNode **nodes = (EpNode **)malloc(sizeof(EpNode *));
+        EpbCase benchCase = {};
+
+        params.size = sizes[i];
+        snprintf(name, sizeof(name), "gen-%zu", sizes[i]);
+
+        if (nodes != NULL && (nodes[0] = epbGenerate(&params)) != NULL && epbCaseCtor(&benchCase, name, nodes, 1)) {
+            epbRunCase(&context, &benchCase);
+        } else {
+            if (nodes != NULL && benchCase.nodes == NULL)
+                free(nodes);
+            status = 1;
+        }
+
+        epbCaseDtor(&benchCase);
+    }
+
+    fprintf(context.out, "\n  ]\n}\n");
+
+    epNodeDtor(context.taylorPoint);
+    epNodeDtor(context.substitution);
+    epBufferDtor(&context.dumpBuffer);
+
+    if (context.out != stdout)
+        fclose(context.out);
+    return status;
+} // main
+
+// ep_bench_main.c
@@ -6,130 +6,628 @@
 
 #include <string.h>
 #include <assert.h>
+#include <limits.h>
 #include <math.h>
 
-#include "ep.h"
+#include "ep_internal.h"
 
 bool epDoubleIsSame( double lhs, double rhs ) {
     return fabs(lhs - rhs) < EP_DOUBLE_EPSILON;
 } // epDoubleIsSame
 
-bool epNodeIsSame( const EpNode *lhs, const EpNode *rhs ) {
-    assert(lhs != NULL);
-    assert(rhs != NULL);
+bool epDoubleIsInteger( double value ) {
+    return value >= (double)INT_MIN && value <= (double)INT_MAX && value == (double)(int)value;
+} // epDoubleIsInteger
 
-    if (lhs->type != rhs->type)
-        return false;
+/**
+ * @brief raising to an integer power function
+ * 
+ * @param[in] base     base
+ * @param[in] exponent exponent
+ * 
+ * @return base raised to exponent (computed by squaring, so costs O(log(exponent)) multiplications)
+ */
+static double epPowi( double base, int exponent ) {
+    unsigned int n = exponent < 0
+        ? 0u - (unsigned int)exponent
+        : (unsigned int)exponent;
+    double result = 1.0;
+
+    while (n != 0) {
+        if (n & 1)
+            result *= base;
+        base *= base;
+        n >>= 1;
+    }
+
+    return exponent < 0
+        ? 1.0 / result
+        : result;
+} // epPowi
+
+/**
+ * @brief node constants equality checking function
+ * 
+ * @param[in] lhs left hand side
+ * @param[in] rhs right hand side
+ * 
+ * @return true if constant nodes with these values are same, false otherwise
+ */
+static bool epNodeConstantIsSame( double lhs, double rhs ) {
+#ifdef EP_EXACT_CONSTANT_EQUALITY
+    return lhs == rhs;
+#else
+    return epDoubleIsSame(lhs, rhs);
+#endif
+} // epNodeConstantIsSame
+
+/**
+ * @brief hash mixing function
+ * 
+ * @param[in] hash  current hash
+ * @param[in] value value to mix into hash
+ * 
+ * @return mixed hash
+ */
+static uint32_t epNodeHashMix( uint32_t hash, uint32_t value ) {
+    hash ^= value * 0xCC9E2D51u;
+    hash = (hash << 13) | (hash >> 19);
+    return hash * 5 + 0xE6546B64u;
+} // epNodeHashMix
+
+/**
+ * @brief node hash from fields calculation function
+ * 
+ * @param[in] node node to calculate hash of (non-null, operands must have valid hashes)
+ * 
+ * @return node hash
+ */
+static uint32_t epNodeCalculateHash( const EpNode *node ) {
+    uint32_t hash = epNodeHashMix(0x9E3779B9u, (uint32_t)node->type);
 
-    switch (lhs->type) {
+    switch (node->type) {
     case EP_NODE_VARIABLE:
-        return strcmp(lhs->variable, rhs->variable) == 0;
+        hash = epNodeHashMix(hash, node->variable);
+        break;
 
-    case EP_NODE_CONSTANT:
-        return epDoubleIsSame(lhs->constant, rhs->constant);
+    case EP_NODE_CONSTANT: {
+#ifdef EP_EXACT_CONSTANT_EQUALITY
+        // +0.0 and -0.0 are equal
+        const double value = node->constant == 0.0 ? 0.0 : node->constant;
+        uint64_t bits;
+
+        memcpy(&bits, &value, sizeof(bits));
+        hash = epNodeHashMix(epNodeHashMix(hash, (uint32_t)bits), (uint32_t)(bits >> 32));
+#endif
+        break;
+    }
 
     case EP_NODE_BINARY_OPERATOR:
-        return true
-            && lhs->binaryOperator.op == rhs->binaryOperator.op
-            && epNodeIsSame(lhs->binaryOperator.lhs, rhs->binaryOperator.lhs)
-            && epNodeIsSame(lhs->binaryOperator.rhs, rhs->binaryOperator.rhs)
-        ;
+        hash = epNodeHashMix(hash, (uint32_t)node->binaryOperator.op);
+        hash = epNodeHashMix(hash, node->binaryOperator.lhs->hash);
+        hash = epNodeHashMix(hash, node->binaryOperator.rhs->hash);
+        break;
 
     case EP_NODE_UNARY_OPERATOR:
-        return lhs->unaryOperator.op == rhs->unaryOperator.op
-            && epNodeIsSame(lhs->unaryOperator.operand, rhs->unaryOperator.operand);
+        hash = epNodeHashMix(hash, (uint32_t)node->unaryOperator.op);
+        hash = epNodeHashMix(hash, node->unaryOperator.operand->hash);
+        break;
     }
-} // epNodeIsSame
 
+    // finalize
+    hash ^= hash >> 16;
+    hash *= 0x85EBCA6Bu;
+    hash ^= hash >> 13;
+    return hash;
+} // epNodeCalculateHash
 
-EpNode * epNodeCopy( const EpNode *const node ) {
+void epNodeUpdateHash( EpNode *node ) {
     assert(node != NULL);
-    EpNode *copy = (EpNode *)calloc(1, sizeof(EpNode));
 
-    if (copy == NULL)
-        return NULL;
+    node->hash = epNodeCalculateHash(node);
+} // epNodeUpdateHash
+
+uint32_t epNodeHash( const EpNode *node ) {
+    assert(node != NULL);
 
-    copy->type = node->type;
+    return node->hash;
+} // epNodeHash
 
-    switch (node->type) {
+/**
+ * @brief node allocation function
+ * 
+ * @return created node pointer (NULL if allocation failed)
+ */
+static EpNode * epNodeAlloc( void ) {
+    EpNode *node = epNodeAllocatorAlloc(epNodeAllocatorGet());
 
-    // these cases do not require further copying
-    case EP_NODE_VARIABLE: {
-        memcpy(copy->variable, node->variable, EP_NODE_VAR_MAX);
-        return copy;
+    if (node != NULL)
+        EP_STATS_COUNT(EP_STATS_COUNTER_NODE_ALLOCATIONS, 1);
+    return node;
+} // epNodeAlloc
+
+bool epStackReserve( void **stack, size_t *capacity, size_t required, size_t elemSize, void *localStack ) {
+    if (required <= *capacity)
+        return true;
+
+    size_t newCapacity = *capacity * 2;
+    while (newCapacity < required)
+        newCapacity *= 2;
+
+    void *newStack = *stack == localStack
+        ? malloc(newCapacity * elemSize)
+        : realloc(*stack, newCapacity * elemSize);
+
+    if (newStack == NULL)
+        return false;
+
+    if (*stack == localStack)
+        memcpy(newStack, localStack, *capacity * elemSize);
+
+    *stack = newStack;
+    *capacity = newCapacity;
+    return true;
+} // epStackReserve
+
+bool epArrayReserve( void **data, size_t *capacity, size_t required, size_t elemSize ) {
+    if (required <= *capacity)
+        return true;
+
+    size_t newCapacity = *capacity == 0 ? 64 : *capacity * 2;
+    while (newCapacity < required)
+        newCapacity *= 2;
+
+    void *newData = realloc(*data, newCapacity * elemSize);
+
+    if (newData == NULL)
+        return false;
+
+    *data = newData;
+    *capacity = newCapacity;
+    return true;
+} // epArrayReserve
+
+EpSymbol * epSymbolsResolve( const void *items, size_t count, size_t itemSize, EpSymbol *localSymbols ) {
+    assert(count == 0 || (count != 0 && items != NULL));
+    assert(itemSize >= sizeof(const char *));
+
+    EpSymbol *symbols = count <= EP_LOCAL_SYMBOL_COUNT
+        ? localSymbols
+        : (EpSymbol *)malloc(count * sizeof(EpSymbol));
+
+    if (symbols == NULL)
+        return NULL;
+
+    for (size_t i = 0; i < count; i++) {
+        const char *name;
+
+        memcpy(&name, (const char *)items + i * itemSize, sizeof(const char *));
+        symbols[i] = epSymbolFind(name);
     }
 
-    case EP_NODE_CONSTANT: {
-        copy->constant = node->constant;
-        return copy;
+    return symbols;
+} // epSymbolsResolve
+
+void epSymbolsRelease( EpSymbol *symbols, EpSymbol *localSymbols ) {
+    if (symbols != localSymbols)
+        free(symbols);
+} // epSymbolsRelease
+
+/// @brief node comparison stack entry representation structure
+typedef struct __EpNodeIsSameEntry {
+    const EpNode * lhs;   ///< left hand side
+    const EpNode * rhs;   ///< right hand side
+    size_t         depth; ///< pair depth
+} EpNodeIsSameEntry;
+
+/**
+ * @brief node comparison function
+ * 
+ * @param[in] lhs       left hand side (non-null)
+ * @param[in] rhs       right hand side (non-null)
+ * @param[in] identical true if constants are compared bit-exactly, false if they are compared by epNodeConstantIsSame
+ * 
+ * @return true if nodes are same, false otherwise (or if allocation failed)
+ */
+static bool epNodeCompare( const EpNode *lhs, const EpNode *rhs, bool identical ) {
+    assert(lhs != NULL);
+    assert(rhs != NULL);
+
+    // pending right hand side subtree pairs, left subtrees are compared without pushing
+    EpNodeIsSameEntry localStack[EP_LOCAL_STACK_SIZE];
+    EpNodeIsSameEntry *stack = localStack;
+    size_t stackSize = 0;
+    size_t stackCapacity = EP_LOCAL_STACK_SIZE;
+    size_t comparedNodes = 0;
+    size_t depth = 1;
+    size_t maxDepth = 1;
+    bool same = true;
+
+    for (;;) {
+        bool descended = false;
+
+        comparedNodes++;
+        if (depth > maxDepth)
+            maxDepth = depth;
+
+        if (lhs->hash != rhs->hash || lhs->type != rhs->type) {
+            same = false;
+            break;
+        }
+
+        switch (lhs->type) {
+        case EP_NODE_VARIABLE:
+            same = lhs->variable == rhs->variable;
+            break;
+
+        case EP_NODE_CONSTANT:
+            same = identical
+                ? memcmp(&lhs->constant, &rhs->constant, sizeof(double)) == 0
+                : epNodeConstantIsSame(lhs->constant, rhs->constant);
+            break;
+
+        case EP_NODE_BINARY_OPERATOR:
+            if (lhs->binaryOperator.op != rhs->binaryOperator.op) {
+                same = false;
+                break;
+            }
+
+            if (!epStackReserve((void **)&stack, &stackCapacity, stackSize + 1, sizeof(EpNodeIsSameEntry), localStack)) {
+                same = false;
+                break;
+            }
+
+            stack[stackSize++] = (EpNodeIsSameEntry) { .lhs = lhs->binaryOperator.rhs, .rhs = rhs->binaryOperator.rhs, .depth = depth + 1 };
+            lhs = lhs->binaryOperator.lhs;
+            rhs = rhs->binaryOperator.lhs;
+            descended = true;
+            break;
+
+        case EP_NODE_UNARY_OPERATOR:
+            if (lhs->unaryOperator.op != rhs->unaryOperator.op) {
+                same = false;
+                break;
+            }
+
+            lhs = lhs->unaryOperator.operand;
+            rhs = rhs->unaryOperator.operand;
+            descended = true;
+            break;
+        }
+
+        if (!same)
+            break;
+
+        if (descended) {
+            depth++;
+            continue;
+        }
+
+        if (stackSize == 0)
+            break;
+
+        stackSize--;
+        lhs = stack[stackSize].lhs;
+        rhs = stack[stackSize].rhs;
+        depth = stack[stackSize].depth;
     }
 
-    case EP_NODE_BINARY_OPERATOR: {
-        copy->binaryOperator.op = node->binaryOperator.op;
+    if (stack != localStack)
+        free(stack);
+    if (!identical)
+        EP_STATS_IS_SAME(comparedNodes, maxDepth);
+    return same;
+} // epNodeCompare
 
-        copy->binaryOperator.lhs = epNodeCopy(node->binaryOperator.lhs);
-        copy->binaryOperator.rhs = epNodeCopy(node->binaryOperator.rhs);
+bool epNodeIsSame( const EpNode *lhs, const EpNode *rhs ) {
+    return epNodeCompare(lhs, rhs, false);
+} // epNodeIsSame
 
-        if (copy->binaryOperator.lhs == NULL || copy->binaryOperator.rhs == NULL) {
-            epNodeDtor(copy->binaryOperator.lhs);
-            epNodeDtor(copy->binaryOperator.rhs);
-            free(copy);
-            return NULL;
+bool epNodeIsIdentical( const EpNode *lhs, const EpNode *rhs ) {
+    return epNodeCompare(lhs, rhs, true);
+} // epNodeIsIdentical
+
+bool epNodeIdentityHash( const EpNode *node, uint32_t *dst ) {
+    assert(node != NULL);
+    assert(dst != NULL);
+
+    // node hash covers structure, constant bits are mixed in preorder
+    const EpNode *localStack[EP_LOCAL_STACK_SIZE];
+    const EpNode **stack = localStack;
+    size_t stackSize = 0;
+    size_t stackCapacity = EP_LOCAL_STACK_SIZE;
+    uint32_t hash = node->hash;
+    bool hashed = true;
+
+    stack[stackSize++] = node;
+
+    while (stackSize != 0) {
+        const EpNode *current = stack[--stackSize];
+
+        if (!epStackReserve((void **)&stack, &stackCapacity, stackSize + 2, sizeof(const EpNode *), localStack)) {
+            hashed = false;
+            break;
+        }
+
+        switch (current->type) {
+        case EP_NODE_VARIABLE:
+            break;
+
+        case EP_NODE_CONSTANT: {
+            uint64_t bits;
+
+            memcpy(&bits, &current->constant, sizeof(bits));
+            hash = epNodeHashMix(epNodeHashMix(hash, (uint32_t)bits), (uint32_t)(bits >> 32));
+            break;
+        }
+
+        case EP_NODE_BINARY_OPERATOR:
+            stack[stackSize++] = current->binaryOperator.rhs;
+            stack[stackSize++] = current->binaryOperator.lhs;
+            break;
+
+        case EP_NODE_UNARY_OPERATOR:
+            stack[stackSize++] = current->unaryOperator.operand;
+            break;
         }
-        return copy;
     }
 
-    case EP_NODE_UNARY_OPERATOR: {
-        copy->unaryOperator.op = node->unaryOperator.op;
-        copy->unaryOperator.operand = epNodeCopy(node->unaryOperator.operand);
+    if (stack != localStack)
+        free(stack);
+    *dst = hash;
+    return hashed;
+} // epNodeIdentityHash
 
-        if (copy->unaryOperator.operand == NULL) {
-            free(copy);
-            return NULL;
+/// @brief node copying stack entry representation structure
+typedef struct __EpNodeCopyEntry {
+    const EpNode  * node; ///< node to copy
+    EpNode       ** dst;  ///< copy destination
+} EpNodeCopyEntry;
+
+/// @brief count of variable collection hash set slots stored on thread stack (power of 2)
+#define EP_NODE_COLLECT_LOCAL_SLOT_COUNT ((size_t)128)
+
+/**
+ * @brief variable collection hash set slot index function
+ * 
+ * @param[in] symbol symbol
+ * @param[in] mask   slot count - 1
+ * 
+ * @return first slot to probe
+ */
+static size_t epNodeCollectSlot( EpSymbol symbol, size_t mask ) {
+    return (size_t)(symbol * 0x9E3779B1u) & mask;
+} // epNodeCollectSlot
+
+bool epNodeCollectVariables( const EpNode *node, EpSymbol **symbols, size_t *symbolCount ) {
+    assert(node != NULL);
+    assert(symbols != NULL);
+    assert(symbolCount != NULL);
+
+    // pending right hand side subtrees, left subtrees are visited without pushing
+    const EpNode *localStack[EP_LOCAL_STACK_SIZE];
+    const EpNode **stack = localStack;
+    size_t stackSize = 0;
+    size_t stackCapacity = EP_LOCAL_STACK_SIZE;
+
+    // already collected symbols (open addressing, EP_SYMBOL_INVALID is empty slot)
+    EpSymbol localSlots[EP_NODE_COLLECT_LOCAL_SLOT_COUNT];
+    EpSymbol *slots = localSlots;
+    size_t slotCount = EP_NODE_COLLECT_LOCAL_SLOT_COUNT;
+
+    EpSymbol *result = NULL;
+    size_t resultCount = 0;
+    size_t resultCapacity = 0;
+    bool succeeded = false;
+
+    for (size_t i = 0; i < slotCount; i++)
+        slots[i] = EP_SYMBOL_INVALID;
+
+    for (;;) {
+        // descend by left spine
+        while (node->type == EP_NODE_BINARY_OPERATOR || node->type == EP_NODE_UNARY_OPERATOR) {
+            if (node->type == EP_NODE_UNARY_OPERATOR) {
+                node = node->unaryOperator.operand;
+                continue;
+            }
+
+            if (!epStackReserve((void **)&stack, &stackCapacity, stackSize + 1, sizeof(const EpNode *), localStack))
+                goto __epNodeCollectVariables__end;
+
+            stack[stackSize++] = node->binaryOperator.rhs;
+            node = node->binaryOperator.lhs;
         }
 
-        return copy;
+        if (node->type == EP_NODE_VARIABLE) {
+            size_t slot = epNodeCollectSlot(node->variable, slotCount - 1);
+
+            while (slots[slot] != EP_SYMBOL_INVALID && slots[slot] != node->variable)
+                slot = (slot + 1) & (slotCount - 1);
+
+            if (slots[slot] == EP_SYMBOL_INVALID) {
+                if (resultCount + 1 > resultCapacity) {
+                    const size_t newCapacity = resultCapacity == 0 ? 16 : resultCapacity * 2;
+                    EpSymbol *newResult = (EpSymbol *)realloc(result, newCapacity * sizeof(EpSymbol));
+
+                    if (newResult == NULL)
+                        goto __epNodeCollectVariables__end;
+
+                    result = newResult;
+                    resultCapacity = newCapacity;
+                }
+
+                result[resultCount++] = node->variable;
+                slots[slot] = node->variable;
+
+                // keep load factor under 1/2, set is rebuilt from collected symbols
+                if (resultCount * 2 > slotCount) {
+                    const size_t newSlotCount = slotCount * 2;
+                    EpSymbol *newSlots = (EpSymbol *)malloc(newSlotCount * sizeof(EpSymbol));
+
+                    if (newSlots == NULL)
+                        goto __epNodeCollectVariables__end;
+
+                    for (size_t i = 0; i < newSlotCount; i++)
+                        newSlots[i] = EP_SYMBOL_INVALID;
+
+                    for (size_t i = 0; i < resultCount; i++) {
+                        size_t newSlot = epNodeCollectSlot(result[i], newSlotCount - 1);
+
+                        while (newSlots[newSlot] != EP_SYMBOL_INVALID)
+                            newSlot = (newSlot + 1) & (newSlotCount - 1);
+                        newSlots[newSlot] = result[i];
+                    }
+
+                    if (slots != localSlots)
+                        free(slots);
+                    slots = newSlots;
+                    slotCount = newSlotCount;
+                }
+            }
+        }
+
+        if (stackSize == 0)
+            break;
+
+        node = stack[--stackSize];
     }
+
+    succeeded = true;
+
+__epNodeCollectVariables__end:
+    if (stack != localStack)
+        free(stack);
+    if (slots != localSlots)
+        free(slots);
+
+    if (!succeeded) {
+        free(result);
+        return false;
+    }
+
+    *symbols = result;
+    *symbolCount = resultCount;
+    return true;
+} // epNodeCollectVariables
+
+EpNode * epNodeCopy( const EpNode *const node ) {
+    assert(node != NULL);
+
+    EpNodeCopyEntry localStack[EP_LOCAL_STACK_SIZE];
+    EpNodeCopyEntry *stack = localStack;
+    size_t stackSize = 0;
+    size_t stackCapacity = EP_LOCAL_STACK_SIZE;
+    EpNode *copy = NULL;
+    size_t copiedNodes = 0;
+
+    stack[stackSize++] = (EpNodeCopyEntry) { .node = node, .dst = &copy };
+
+    // nodes are copied in preorder, so partially built copy is always a valid tree
+    while (stackSize != 0) {
+        EpNodeCopyEntry entry = stack[--stackSize];
+        EpNode *dst = epNodeAlloc();
+
+        if (dst == NULL)
+            goto __epNodeCopy__fail;
+
+        copiedNodes++;
+        *dst = *entry.node;
+        *entry.dst = dst;
+
+        switch (dst->type) {
+        case EP_NODE_VARIABLE:
+        case EP_NODE_CONSTANT:
+            break;
+
+        case EP_NODE_BINARY_OPERATOR:
+            dst->binaryOperator.lhs = NULL;
+            dst->binaryOperator.rhs = NULL;
+
+            if (!epStackReserve((void **)&stack, &stackCapacity, stackSize + 2, sizeof(EpNodeCopyEntry), localStack))
+                goto __epNodeCopy__fail;
+
+            stack[stackSize++] = (EpNodeCopyEntry) { .node = entry.node->binaryOperator.rhs, .dst = &dst->binaryOperator.rhs };
+            stack[stackSize++] = (EpNodeCopyEntry) { .node = entry.node->binaryOperator.lhs, .dst = &dst->binaryOperator.lhs };
+            break;
+
+        case EP_NODE_UNARY_OPERATOR:
+            dst->unaryOperator.operand = NULL;
+
+            if (!epStackReserve((void **)&stack, &stackCapacity, stackSize + 1, sizeof(EpNodeCopyEntry), localStack))
+                goto __epNodeCopy__fail;
+
+            stack[stackSize++] = (EpNodeCopyEntry) { .node = entry.node->unaryOperator.operand, .dst = &dst->unaryOperator.operand };
+            break;
+        }
     }
 
-    free(copy);
+    if (stack != localStack)
+        free(stack);
+    EP_STATS_COUNT(EP_STATS_COUNTER_COPY_CALLS, 1);
+    EP_STATS_COUNT(EP_STATS_COUNTER_COPIED_NODES, copiedNodes);
+    return copy;
+
+__epNodeCopy__fail:
+    if (stack != localStack)
+        free(stack);
+    EP_STATS_COUNT(EP_STATS_COUNTER_COPY_CALLS, 1);
+    EP_STATS_COUNT(EP_STATS_COUNTER_COPIED_NODES, copiedNodes);
+    epNodeDtor(copy);
     return NULL;
 } // epNodeCopy
 
 void epNodeDtor( EpNode *node ) {
-    if (node == NULL)
-        return;
+    // binary operator nodes with unvisited rhs, linked through their lhs field
+    EpNode *pending = NULL;
+    size_t freedNodes = 0;
+    const EpAllocator *allocator = node != NULL
+        ? epNodeAllocatorGet()
+        : NULL;
+
+    for (;;) {
+        if (node == NULL) {
+            if (pending == NULL) {
+                EP_STATS_COUNT(EP_STATS_COUNTER_NODE_FREES, freedNodes);
+                return;
+            }
+
+            EpNode *next = pending;
+            pending = next->binaryOperator.lhs;
+            node = next->binaryOperator.rhs;
+            epNodeAllocatorFree(allocator, next);
+            freedNodes++;
+            continue;
+        }
 
-    switch (node->type) {
-    case EP_NODE_VARIABLE:
-        break;
+        EpNode *next = NULL;
 
-    case EP_NODE_CONSTANT:
-        break;
+        switch (node->type) {
+        case EP_NODE_VARIABLE:
+        case EP_NODE_CONSTANT:
+            break;
 
-    case EP_NODE_BINARY_OPERATOR: {
-        epNodeDtor(node->binaryOperator.lhs);
-        epNodeDtor(node->binaryOperator.rhs);
-        break;
-    }
+        case EP_NODE_BINARY_OPERATOR:
+            next = node->binaryOperator.lhs;
 
-    case EP_NODE_UNARY_OPERATOR: {
-        epNodeDtor(node->unaryOperator.operand);
-        break;
-    }
-    }
+            if (node->binaryOperator.rhs != NULL) {
+                // node itself is freed after its rhs is taken from pending list
+                node->binaryOperator.lhs = pending;
+                pending = node;
+                node = next;
+                continue;
+            }
+            break;
 
-    free(node);
-} // epNodeDtor
+        case EP_NODE_UNARY_OPERATOR:
+            next = node->unaryOperator.operand;
+            break;
+        }
 
-/**
- * @brief node allocation function
- * 
- * @return created node pointer (NULL if allocation failed)
- */
-static EpNode * epNodeAlloc( void ) {
-    return (EpNode *)calloc(sizeof(EpNode), 1);
-} // epNodeAllocZeroed
+        epNodeAllocatorFree(allocator, node);
+        freedNodes++;
+        node = next;
+    }
+} // epNodeDtor
 
 EpNode * epNodeConstant( double value ) {
     EpNode *node = epNodeAlloc();
@@ -139,6 +637,7 @@ EpNode * epNodeConstant( double value ) {
 
     node->type = EP_NODE_CONSTANT;
     node->constant = value;
+    node->hash = epNodeCalculateHash(node);
 
     return node;
 } // epNodeConstant
@@ -146,21 +645,28 @@ EpNode * epNodeConstant( double value ) {
 EpNode * epNodeVariable( const char *varName ) {
     assert(varName != NULL);
 
-    const size_t length = strlen(varName);
+    const EpSymbol symbol = epSymbolIntern(varName);
 
-    if (length > EP_NODE_VAR_MAX - 1)
+    if (symbol == EP_SYMBOL_INVALID)
         return NULL;
 
+    return epNodeVariableSymbol(symbol);
+} // epNodeVariable
+
+EpNode * epNodeVariableSymbol( EpSymbol symbol ) {
+    assert(symbol != EP_SYMBOL_INVALID);
+
     EpNode *node = epNodeAlloc();
 
     if (node == NULL)
         return NULL;
 
     node->type = EP_NODE_VARIABLE;
-    memcpy(node->variable, varName, length);
+    node->variable = symbol;
+    node->hash = epNodeCalculateHash(node);
 
     return node;
-} // epNodeVariable
+} // epNodeVariableSymbol
 
 EpNode * epNodeBinaryOperator( EpBinaryOperator op, EpNode *lhs, EpNode *rhs ) {
     if (lhs == NULL || rhs == NULL) {
@@ -182,6 +688,7 @@ EpNode * epNodeBinaryOperator( EpBinaryOperator op, EpNode *lhs, EpNode *rhs ) {
     node->binaryOperator.op  = op;
     node->binaryOperator.lhs = lhs;
     node->binaryOperator.rhs = rhs;
+    node->hash = epNodeCalculateHash(node);
 
     return node;
 } // epNodeBinaryOperator
@@ -192,13 +699,16 @@ EpNode * epNodeUnaryOperator( EpUnaryOperator op, EpNode *operand ) {
 
     EpNode *node = epNodeAlloc();
 
-    if (node == NULL)
+    if (node == NULL) {
+        epNodeDtor(operand);
         return NULL;
+    }
 
     node->type = EP_NODE_UNARY_OPERATOR;
 
     node->unaryOperator.op      = op;
     node->unaryOperator.operand = operand;
+    node->hash = epNodeCalculateHash(node);
 
     return node;
 } // epNodeUnaryOperator
@@ -210,6 +720,7 @@ int epBinaryOperatorGetPriority( EpBinaryOperator op ) {
     case EP_BINARY_OPERATOR_MUL: return 2;
     case EP_BINARY_OPERATOR_DIV: return 2;
     case EP_BINARY_OPERATOR_POW: return 3;
+    case EP_BINARY_OPERATOR_POWI: return 3;
     }
 } // epBinaryOperatorGetPriority
 
@@ -229,6 +740,7 @@ const char * epBinaryOperatorStr( EpBinaryOperator op ) {
     case EP_BINARY_OPERATOR_MUL : return "*";
     case EP_BINARY_OPERATOR_DIV : return "/";
     case EP_BINARY_OPERATOR_POW : return "^";
+    case EP_BINARY_OPERATOR_POWI: return "powi";
     }
 } // epBinaryOperatorStr
 
@@ -246,6 +758,9 @@ const char * epUnaryOperatorStr( EpUnaryOperator op ) {
         case EP_UNARY_OPERATOR_ACOS : return "acos";
         case EP_UNARY_OPERATOR_ATAN : return "atan";
         case EP_UNARY_OPERATOR_ACOT : return "acot";
+
+        case EP_UNARY_OPERATOR_EXP  : return  "exp";
+        case EP_UNARY_OPERATOR_SQRT : return "sqrt";
     }
 } // epUnaryOperatorStr
 
@@ -263,6 +778,9 @@ double epUnaryOperatorApply( EpUnaryOperator op, double operand ) {
     case EP_UNARY_OPERATOR_ACOS: return acos(operand);
     case EP_UNARY_OPERATOR_ATAN: return atan(operand);
     case EP_UNARY_OPERATOR_ACOT: return atan(-operand) + M_PI_2;
+
+    case EP_UNARY_OPERATOR_EXP : return exp(operand);
+    case EP_UNARY_OPERATOR_SQRT: return sqrt(operand);
     }
 } // epUnaryOperatorApply
 
@@ -273,6 +791,9 @@ double epBinaryOperatorApply( EpBinaryOperator op, double lhs, double rhs ) {
     case EP_BINARY_OPERATOR_MUL: return lhs * rhs;
     case EP_BINARY_OPERATOR_DIV: return lhs / rhs;
     case EP_BINARY_OPERATOR_POW: return pow(lhs, rhs);
+
+    // non-integer exponent may occur only in manually constructed node
+    case EP_BINARY_OPERATOR_POWI: return epDoubleIsInteger(rhs) ? epPowi(lhs, (int)rhs) : pow(lhs, rhs);
     }
 } // epBinaryOperatorApply
 
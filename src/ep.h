@@ -6,6 +6,7 @@
 #define EP_H_
 
 #include <stdio.h>
+#include <stdint.h>
 #include <stdbool.h>
 
 #ifdef __cplusplus
@@ -25,9 +26,12 @@ extern "C" {
     #define EP_MUL(lhs, rhs) (epNodeBinaryOperator(EP_BINARY_OPERATOR_MUL, (lhs), (rhs)))
     #define EP_DIV(lhs, rhs) (epNodeBinaryOperator(EP_BINARY_OPERATOR_DIV, (lhs), (rhs)))
     #define EP_POW(lhs, rhs) (epNodeBinaryOperator(EP_BINARY_OPERATOR_POW, (lhs), (rhs)))
+    #define EP_POWI(lhs, rhs) (epNodeBinaryOperator(EP_BINARY_OPERATOR_POWI, (lhs), (rhs)))
 
     #define EP_NEG(op) (epNodeUnaryOperator(EP_UNARY_OPERATOR_NEG, (op)))
     #define EP_LN(op)  (epNodeUnaryOperator(EP_UNARY_OPERATOR_LN , (op)))
+    #define EP_EXP(op) (epNodeUnaryOperator(EP_UNARY_OPERATOR_EXP, (op)))
+    #define EP_SQRT(op) (epNodeUnaryOperator(EP_UNARY_OPERATOR_SQRT, (op)))
 
     #define EP_SIN(op) (epNodeUnaryOperator(EP_UNARY_OPERATOR_SIN, (op)))
     #define EP_COS(op) (epNodeUnaryOperator(EP_UNARY_OPERATOR_COS, (op)))
@@ -56,8 +60,77 @@ extern "C" {
  */
 bool epDoubleIsSame( double lhs, double rhs );
 
-/// @brief maximal length of node variable name
-#define EP_NODE_VAR_MAX ((size_t)16)
+/**
+ * @brief double integrality checking function
+ * 
+ * @param[in] value value to check
+ * 
+ * @return true if value is exactly integer and fits in int, false otherwise
+ */
+bool epDoubleIsInteger( double value );
+
+/// @brief size of buffer enough for any double formatted by epDoubleFormat (terminating null included)
+#define EP_DOUBLE_FORMAT_SIZE ((size_t)32)
+
+/**
+ * @brief shortest round-trip double formatting function
+ * 
+ * @param[in]  value value to format
+ * @param[out] dst   null-terminated text destination (at least EP_DOUBLE_FORMAT_SIZE characters)
+ * 
+ * @note finite values are written with shortest digit sequence that is parsed back to the same value
+ * (Grisu2, rarely one digit longer than shortest). Values from 1e-6 to 1e21 are written positionally
+ * ('0.25', '1500'), other ones in exponential form ('1.5e-7', '1e300'). Non-finite values are written
+ * as 'inf', '-inf' and 'nan'. Sign is written for negative values (and negative zero) only.
+ * 
+ * @return count of written characters (terminating null is not counted)
+ */
+size_t epDoubleFormat( double value, char *dst );
+
+/// @brief interned symbol (variable name) identifier
+typedef uint32_t EpSymbol;
+
+/// @brief invalid symbol identifier
+#define EP_SYMBOL_INVALID ((EpSymbol)UINT32_MAX)
+
+/**
+ * @brief symbol interning function
+ * 
+ * @param[in] name symbol name (non-null, any length)
+ * 
+ * @note symbol table is global and thread-safe, symbols are never freed
+ * 
+ * @return symbol identifier (EP_SYMBOL_INVALID if allocation failed)
+ */
+EpSymbol epSymbolIntern( const char *name );
+
+/**
+ * @brief symbol from string slice interning function
+ * 
+ * @param[in] name   symbol name (non-null if length != 0, not required to be null-terminated)
+ * @param[in] length symbol name length
+ * 
+ * @return symbol identifier (EP_SYMBOL_INVALID if allocation failed)
+ */
+EpSymbol epSymbolInternSlice( const char *name, size_t length );
+
+/**
+ * @brief already interned symbol finding function
+ * 
+ * @param[in] name symbol name (non-null)
+ * 
+ * @return symbol identifier (EP_SYMBOL_INVALID if there is no such symbol)
+ */
+EpSymbol epSymbolFind( const char *name );
+
+/**
+ * @brief symbol name getting function
+ * 
+ * @param[in] symbol symbol identifier (valid)
+ * 
+ * @return symbol name (valid until program termination)
+ */
+const char * epSymbolName( EpSymbol symbol );
 
 /// @brief node type (union tag, actually) representation enumeration
 typedef enum __EpNodeType {
@@ -83,6 +156,8 @@ typedef enum __EpBinaryOperator {
     EP_BINARY_OPERATOR_MUL, ///< multiplication
     EP_BINARY_OPERATOR_DIV, ///< division
     EP_BINARY_OPERATOR_POW, ///< raising to a power
+
+    EP_BINARY_OPERATOR_POWI, ///< raising to an integer power (rhs is integer constant, see epDoubleIsInteger, written and read as 'powi(x, n)')
 } EpBinaryOperator;
 
 /**
@@ -128,6 +203,9 @@ typedef enum __EpUnaryOperator {
     EP_UNARY_OPERATOR_ACOS, ///< arccosine
     EP_UNARY_OPERATOR_ATAN, ///< arctangent
     EP_UNARY_OPERATOR_ACOT, ///< arccotangent
+
+    EP_UNARY_OPERATOR_EXP,  ///< exponent
+    EP_UNARY_OPERATOR_SQRT, ///< square root
 } EpUnaryOperator;
 
 /**
@@ -149,15 +227,71 @@ const char * epUnaryOperatorStr( EpUnaryOperator op );
  */
 double epUnaryOperatorApply( EpUnaryOperator op, double operand );
 
+/// @brief math function accuracy representation enumeration
+typedef enum __EpMathAccuracy {
+    EP_MATH_ACCURACY_EXACT,    ///< libm functions
+    EP_MATH_ACCURACY_APPROX12, ///< polynomial approximations, relative error below 1e-12
+    EP_MATH_ACCURACY_APPROX7,  ///< polynomial approximations, relative error below 1e-7
+} EpMathAccuracy;
+
+/**
+ * @brief accuracy relative error bound getting function
+ * 
+ * @param[in] accuracy accuracy
+ * 
+ * @return relative error bound (0 for exact accuracy)
+ * 
+ * @note for raising to a power bound is multiplied by (1 + |exponent|)
+ */
+double epMathAccuracyBound( EpMathAccuracy accuracy );
+
+/**
+ * @brief unary operator with specified accuracy apply function
+ * 
+ * @param[in] op       unary operator
+ * @param[in] operand  operand
+ * @param[in] accuracy accuracy
+ * 
+ * @return result of applying 'op' operator on operand.
+ * 
+ * @note trigonometric functions keep accuracy for |operand| up to 1e6
+ */
+double epUnaryOperatorApplyApprox( EpUnaryOperator op, double operand, EpMathAccuracy accuracy );
+
+/**
+ * @brief binary operator with specified accuracy apply function
+ * 
+ * @param[in] op       binary operator
+ * @param[in] lhs      left hand side
+ * @param[in] rhs      right hand side
+ * @param[in] accuracy accuracy
+ * 
+ * @return result of applying op on lhs and rhs.
+ * 
+ * @note only raising to a non-integer power of positive base is approximated
+ */
+double epBinaryOperatorApplyApprox( EpBinaryOperator op, double lhs, double rhs, EpMathAccuracy accuracy );
+
+/**
+ * @brief approximate functions accuracy check function
+ * 
+ * @param[in] accuracy accuracy to check
+ * @param[in] out      file to write per-function maximal errors to (nullable)
+ * 
+ * @return true if every function error is in accuracy bound, false otherwise
+ */
+bool epMathApproxCheck( EpMathAccuracy accuracy, FILE *out );
+
 /// @brief node type forward declaration
 typedef struct __EpNode EpNode;
 
 /// @brief node tagged union representation structure
 struct __EpNode {
     EpNodeType type; ///< node type (union 'tag')
+    uint32_t   hash; ///< structural hash (computed by constructors, same nodes have same hashes)
 
     union {
-        char variable[EP_NODE_VAR_MAX]; ///< variable node name
+        EpSymbol variable;              ///< variable node name
 
         double constant;                ///< constnat node
 
@@ -174,16 +308,130 @@ struct __EpNode {
     };
 }; // struct __EpNode
 
+/// @brief node memory allocator representation structure
+typedef struct __EpAllocator {
+    void * (* alloc )( void *context, size_t size );            ///< zero-initialized memory allocation function (returns NULL if failed)
+    void   (* free  )( void *context, void *ptr, size_t size ); ///< memory freeing function (size is same as passed to alloc)
+    void   *  context;                                          ///< context passed to functions
+} EpAllocator;
+
+/**
+ * @brief global node allocator setting function
+ * 
+ * @param[in] allocator allocator (nullable, calloc and free are used if NULL, must outlive nodes allocated by it)
+ * 
+ * @note node must be destroyed with the same allocator it is allocated with, so allocator
+ * should be changed only when there are no nodes allocated by current one.
+ */
+void epNodeAllocatorSetGlobal( const EpAllocator *allocator );
+
+/**
+ * @brief calling thread node allocator setting function
+ * 
+ * @param[in] allocator allocator (nullable, global allocator is used if NULL)
+ * 
+ * @note allocator overrides global one for calling thread and for workers library starts on its behalf
+ * (e.g. by epNodeGenNodeFunctionInfo), so it is allocator of whole computation context.
+ * 
+ * @return previous calling thread allocator (NULL if there was none)
+ */
+const EpAllocator * epNodeAllocatorSetThread( const EpAllocator *allocator );
+
+/**
+ * @brief calling thread node allocator getting function
+ * 
+ * @return allocator nodes are allocated with (NULL if calloc and free are used)
+ */
+const EpAllocator * epNodeAllocatorGet( void );
+
+/// @brief tracking allocator (calloc and free with accounting and live byte limit) forward declaration
+typedef struct __EpTrackingAllocator EpTrackingAllocator;
+
+/// @brief tracking allocator statistics representation structure
+typedef struct __EpTrackingAllocatorStats {
+    size_t   limit;           ///< live byte limit (0 if unlimited)
+    size_t   liveBytes;       ///< currently allocated bytes
+    size_t   peakBytes;       ///< maximal allocated bytes
+    uint64_t allocationCount; ///< count of succeeded allocations
+    uint64_t freeCount;       ///< count of frees
+    uint64_t failedCount;     ///< count of allocations refused by limit or failed
+} EpTrackingAllocatorStats;
+
+/**
+ * @brief tracking allocator constructor
+ * 
+ * @param[in] limit live byte limit (0 if unlimited), allocation that exceeds it returns NULL
+ * 
+ * @note allocator is thread-safe, counters are shared by all threads using it
+ * 
+ * @return created tracking allocator (null if allocation failed)
+ */
+EpTrackingAllocator * epTrackingAllocatorCtor( size_t limit );
+
+/**
+ * @brief tracking allocator destructor
+ * 
+ * @param[in] tracking tracking allocator to destroy (nullable, must not be set as any node allocator)
+ */
+void epTrackingAllocatorDtor( EpTrackingAllocator *tracking );
+
+/**
+ * @brief tracking allocator interface getting function
+ * 
+ * @param[in] tracking tracking allocator (non-null)
+ * 
+ * @return allocator interface to pass to epNodeAllocatorSetGlobal or epNodeAllocatorSetThread (valid while tracking allocator exists)
+ */
+const EpAllocator * epTrackingAllocatorGetAllocator( EpTrackingAllocator *tracking );
+
+/**
+ * @brief tracking allocator statistics getting function
+ * 
+ * @param[in] tracking tracking allocator (non-null)
+ * 
+ * @return tracking allocator statistics
+ */
+EpTrackingAllocatorStats epTrackingAllocatorGetStats( const EpTrackingAllocator *tracking );
+
 /**
  * @brief node comparison function
  * 
  * @param[in] lhs left hand side (non-null)
  * @param[in] rhs right hand side (non-null)
  * 
+ * @note comparison uses explicit stack, so it's false also if this stack allocation failed (on very deep trees only)
+ * 
+ * @note nodes with different hashes are rejected immediately. Constants are compared with EP_DOUBLE_EPSILON threshold,
+ * which is not transitive, so constant values don't take part in hash. If EP_EXACT_CONSTANT_EQUALITY
+ * is defined during library build, constants are compared exactly and their values are hashed.
+ * 
  * @return true if nodes same, false if not.
  */
 bool epNodeIsSame( const EpNode *lhs, const EpNode *rhs );
 
+/**
+ * @brief node hash getting function
+ * 
+ * @param[in] node node to get hash of (non-null)
+ * 
+ * @return node structural hash (same nodes have same hashes, hash is not stable between program runs)
+ */
+uint32_t epNodeHash( const EpNode *node );
+
+/**
+ * @brief node variables (free parameters) collection function
+ * 
+ * @param[in]  node        node to collect variables of (non-null)
+ * @param[out] symbols     distinct variable symbols in order of first (left to right) occurrence destination
+ *                         (non-null, array must be freed by caller, NULL is written if node has no variables)
+ * @param[out] symbolCount count of distinct variables destination (non-null)
+ * 
+ * @note collection is linear in node size: tree is traversed with explicit stack and symbols are deduplicated by hash set
+ * 
+ * @return true if succeeded, false if allocation failed
+ */
+bool epNodeCollectVariables( const EpNode *node, EpSymbol **symbols, size_t *symbolCount );
+
 /**
  * @brief node copying function
  * 
@@ -214,10 +462,19 @@ EpNode * epNodeConstant( double constant );
  * 
  * @param[in] varName variable name (non-null)
  * 
- * @return created node pointer (null if allocation failed or name is longer than EP_NODE_VAR_MAX - 1)
+ * @return created node pointer (null if allocation failed)
  */
 EpNode * epNodeVariable( const char *varName );
 
+/**
+ * @brief variable node from symbol constructor
+ * 
+ * @param[in] symbol variable name symbol (valid)
+ * 
+ * @return created node pointer (null if allocation failed)
+ */
+EpNode * epNodeVariableSymbol( EpSymbol symbol );
+
 /**
  * @brief binary operator node constructor
  * 
@@ -289,10 +546,28 @@ EpNode * epNodeSubstitute(
     size_t                 substitutionCount
 );
 
+/**
+ * @brief node variable consuming substitution function
+ * 
+ * @param[in] node              node to substitute (nullable, ownership is transferred to function)
+ * @param[in] substitutions     substitution array (non-null if substitutionCount != 0)
+ * @param[in] substitutionCount count of substitutions
+ * 
+ * @note only substituted variable nodes are replaced, other nodes are kept in place
+ * 
+ * @return node with substituted variables (null if node is null or allocation failed, node is destroyed in this case)
+ */
+EpNode * epNodeSubstituteInPlace(
+    EpNode               * node,
+    const EpSubstitution * substitutions,
+    size_t                 substitutionCount
+);
+
 /// @brief computation status
 typedef enum __EpNodeComputeStatus {
     EP_NODE_COMPUTE_OK,               ///< computation succeeded
     EP_NODE_COMPUTE_UNKNOWN_VARIABLE, ///< unknown variable reference occured
+    EP_NODE_COMPUTE_INTERNAL_ERROR,   ///< internal error (allocation failure) occured
 } EpNodeComputeStatus;
 
 /// @brief node computation result (tagged union)
@@ -324,25 +599,362 @@ EpNodeComputeResult epNodeCompute(
     size_t             variableCount
 );
 
+/// @brief closed interval representation structure (empty if !(lo <= hi))
+typedef struct __EpInterval {
+    double lo; ///< lower bound (may be -infinity)
+    double hi; ///< upper bound (may be +infinity)
+} EpInterval;
+
+/**
+ * @brief interval emptiness checking function
+ * 
+ * @param[in] interval interval to check
+ * 
+ * @return true if interval contains no numbers (!(lo <= hi)), false otherwise
+ */
+bool epIntervalIsEmpty( EpInterval interval );
+
+/**
+ * @brief unary operator on interval apply function
+ * 
+ * @param[in] op      unary operator
+ * @param[in] operand operand interval
+ * 
+ * @return interval that contains op(x) for every x in operand op is defined at (empty if there are no such x)
+ * 
+ * @note bounds are rounded outwards, so enclosure holds despite floating point rounding
+ */
+EpInterval epUnaryOperatorApplyInterval( EpUnaryOperator op, EpInterval operand );
+
+/**
+ * @brief binary operator on intervals apply function
+ * 
+ * @param[in] op  binary operator
+ * @param[in] lhs left hand side interval
+ * @param[in] rhs right hand side interval
+ * 
+ * @return interval that contains op(x, y) for every x in lhs and y in rhs op is defined at (empty if there are no such x, y)
+ * 
+ * @note bounds are rounded outwards, so enclosure holds despite floating point rounding
+ */
+EpInterval epBinaryOperatorApplyInterval( EpBinaryOperator op, EpInterval lhs, EpInterval rhs );
+
+/// @brief interval variable representation structure
+typedef struct __EpIntervalVariable {
+    const char * name;  ///< variable name
+    EpInterval   value; ///< variable range
+} EpIntervalVariable;
+
+/// @brief node interval computation result (tagged union)
+typedef struct __EpNodeComputeIntervalResult {
+    EpNodeComputeStatus status; ///< compute status
+
+    union {
+        EpInterval   ok;              ///< range enclosure
+        const char * unknownVariable; ///< unknown variable
+    };
+} EpNodeComputeIntervalResult;
+
+/**
+ * @brief node range over box of variable intervals computation function
+ * 
+ * @param[in] node          node to compute (non-null)
+ * @param[in] variables     variable intervals array (non-null if variableCount != 0)
+ * @param[in] variableCount count of variables
+ * 
+ * @return computation result, ok is interval that contains node value at every point of box node is defined at
+ * (empty if node is defined nowhere in box)
+ * 
+ * @note enclosure is not tight if variable occurs several times in node (dependency problem of interval arithmetic),
+ * but it is always correct, so points of box can be skipped if it doesn't contain value of interest.
+ * Zero sign is not tracked, so infinities produced by division by negative zero may be out of enclosure.
+ */
+EpNodeComputeIntervalResult epNodeComputeInterval(
+    const EpNode             * node,
+    const EpIntervalVariable * variables,
+    size_t                     variableCount
+);
+
+/**
+ * @brief node partial evaluation (specialization) function
+ * 
+ * @param[in] node         node to specialize (non-null)
+ * @param[in] bindings     numeric variable bindings array (non-null if bindingCount != 0)
+ * @param[in] bindingCount count of bindings
+ * 
+ * @note bound variables are substituted and all variable-free subtrees are folded to constants in a single traversal
+ * 
+ * @return residual expression (null if allocation failed)
+ */
+EpNode * epNodeSpecialize(
+    const EpNode     * node,
+    const EpVariable * bindings,
+    size_t             bindingCount
+);
+
 /**
  * @brief node optimization function
  * 
  * @param[in] node to optimize (nullable)
  * 
  * @return optimized node (may be null)
+ * 
+ * @note rewrites keep value up to few ulps, not bit-exactly: constants are matched within EP_DOUBLE_EPSILON,
+ * 'x ^ n' becomes powi(x, n) (repeated squaring), nested integer powers are merged, 'x ^ 0.5' becomes sqrt(x)
+ * and 'e ^ x' becomes exp(x). Rewritten powers may also differ at signed zeros and infinities
+ * (sqrt(-0) is -0 and sqrt(-inf) is nan, while pow gives +0 and +inf).
  */
 EpNode * epNodeOptimize( const EpNode *node );
 
+/**
+ * @brief node consuming optimization function
+ * 
+ * @param[in] node node to optimize (nullable, ownership is transferred to function)
+ * 
+ * @note nodes of 'node' are relinked into result instead of being copied
+ * 
+ * @return optimized node (null if node is null or allocation failed, node is destroyed in this case)
+ */
+EpNode * epNodeOptimizeInPlace( EpNode *node );
+
+/// @brief pool node info word type field width
+#define EP_POOL_NODE_TYPE_BITS 2
+
+/// @brief pool node info word operator field width
+#define EP_POOL_NODE_OP_BITS 6
+
+/// @brief maximal symbol that can be stored in pool node info word
+#define EP_POOL_NODE_SYMBOL_MAX ((EpSymbol)(UINT32_MAX >> (EP_POOL_NODE_TYPE_BITS + EP_POOL_NODE_OP_BITS)))
+
+/// @brief pool node info word packing macro
+#define EP_POOL_NODE_INFO(type, op, symbol) ((uint32_t)(type) | (uint32_t)(op) << EP_POOL_NODE_TYPE_BITS | (uint32_t)(symbol) << (EP_POOL_NODE_TYPE_BITS + EP_POOL_NODE_OP_BITS))
+
+/// @brief pool node type from info word getting macro
+#define EP_POOL_NODE_TYPE(info) ((EpNodeType)((info) & ((1u << EP_POOL_NODE_TYPE_BITS) - 1)))
+
+/// @brief pool node operator from info word getting macro (EpBinaryOperator or EpUnaryOperator value)
+#define EP_POOL_NODE_OP(info) (((info) >> EP_POOL_NODE_TYPE_BITS) & ((1u << EP_POOL_NODE_OP_BITS) - 1))
+
+/// @brief pool node variable symbol from info word getting macro
+#define EP_POOL_NODE_SYMBOL(info) ((EpSymbol)((info) >> (EP_POOL_NODE_TYPE_BITS + EP_POOL_NODE_OP_BITS)))
+
+/// @brief pool trigonometric node role from info word getting macro (role is stored in place of symbol)
+#define EP_POOL_NODE_TRIG_ROLE(info) ((EpPoolTrigRole)EP_POOL_NODE_SYMBOL(info))
+
+/**
+ * @brief pool sin/cos/tan/cot node role
+ * 
+ * @note nodes of same argument are chained through 'rhs' field (0 terminates chain,
+ * because index 0 is always occupied by leaf), lead computes sine and cosine once and writes values of all chain nodes.
+ */
+typedef enum __EpPoolTrigRole {
+    EP_POOL_TRIG_SINGLE, ///< node is computed separately
+    EP_POOL_TRIG_LEAD,   ///< first node of group, computes values of whole group
+    EP_POOL_TRIG_MEMBER, ///< node value is written by group lead
+} EpPoolTrigRole;
+
+/// @brief compact (16 byte) pool node representation structure
+typedef struct __EpPoolNode {
+    uint32_t info;         ///< packed type, operator and variable symbol or trigonometric role (see EP_POOL_NODE_INFO)
+    uint32_t lhs;          ///< left hand side or operand node index (binary and unary operators only)
+
+    union {
+        uint32_t rhs;      ///< right hand side node index (binary operator) or next node of trigonometric group
+        double   constant; ///< constant node value
+    };
+} EpPoolNode;
+
+/// @brief index-based node pool representation structure
+typedef struct __EpNodePool {
+    EpPoolNode * nodes;     ///< nodes in postorder (children precede parents, root is last)
+    uint32_t     nodeCount; ///< count of nodes
+} EpNodePool;
+
+/**
+ * @brief node pool from node constructor
+ * 
+ * @param[in] node node to convert (non-null)
+ * 
+ * @note sin, cos, tan and cot nodes of structurally same arguments are grouped (see EpPoolTrigRole), so
+ * sine and cosine of every distinct argument are computed once (grouping is skipped if allocation failed)
+ * 
+ * @return created pool pointer (null if allocation failed or node has more than UINT32_MAX nodes)
+ */
+EpNodePool * epNodePoolFromNode( const EpNode *node );
+
+/**
+ * @brief node pool destructor
+ * 
+ * @param[in] pool pool to destroy (nullable)
+ */
+void epNodePoolDtor( EpNodePool *pool );
+
+/**
+ * @brief node from node pool constructor
+ * 
+ * @param[in] pool pool to convert (non-null, non-empty)
+ * 
+ * @return created node (null if allocation failed)
+ */
+EpNode * epNodePoolToNode( const EpNodePool *pool );
+
+/**
+ * @brief node pool value computation function
+ * 
+ * @param[in] pool          pool to compute (non-null, non-empty)
+ * @param[in] variables     variables used in computation array (non-null if variableCount != 0)
+ * @param[in] variableCount count of variables used in computation
+ * 
+ * @note pool is evaluated by single linear sweep without recursion
+ */
+EpNodeComputeResult epNodePoolCompute(
+    const EpNodePool * pool,
+    const EpVariable * variables,
+    size_t             variableCount
+);
+
+/// @brief variable of batch computation representation structure
+typedef struct __EpBatchVariable {
+    const char   * name;   ///< variable name
+    const double * values; ///< variable values (one per point)
+} EpBatchVariable;
+
+/**
+ * @brief node pool values at several points computation function
+ * 
+ * @param[in]  pool          pool to compute (non-null, non-empty)
+ * @param[in]  variables     variables used in computation array (non-null if variableCount != 0)
+ * @param[in]  variableCount count of variables used in computation
+ * @param[in]  pointCount    count of points to compute pool at
+ * @param[out] results       computation results destination (non-null if pointCount != 0, pointCount elements)
+ * 
+ * @note points are computed by blocks, every node is applied to whole block at once,
+ * so loops of arithmetic operators are vectorizable and per-node dispatch cost is shared by block
+ * 
+ * @return computation status (ok field is not used, results are written to results array)
+ */
+EpNodeComputeResult epNodePoolComputeBatch(
+    const EpNodePool      * pool,
+    const EpBatchVariable * variables,
+    size_t                  variableCount,
+    size_t                  pointCount,
+    double                * results
+);
+
+/**
+ * @brief node pool values at several points with specified math accuracy computation function
+ * 
+ * @param[in]  pool          pool to compute (non-null, non-empty)
+ * @param[in]  variables     variables used in computation array (non-null if variableCount != 0)
+ * @param[in]  variableCount count of variables used in computation
+ * @param[in]  pointCount    count of points to compute pool at
+ * @param[in]  accuracy      accuracy of math functions (see EpMathAccuracy)
+ * @param[out] results       computation results destination (non-null if pointCount != 0, pointCount elements)
+ * 
+ * @return computation status (ok field is not used, results are written to results array)
+ */
+EpNodeComputeResult epNodePoolComputeBatchApprox(
+    const EpNodePool      * pool,
+    const EpBatchVariable * variables,
+    size_t                  variableCount,
+    size_t                  pointCount,
+    EpMathAccuracy          accuracy,
+    double                * results
+);
+
+/// @brief transformation result cache forward declaration
+typedef struct __EpTransformCache EpTransformCache;
+
+/// @brief transformation result cache statistics representation structure
+typedef struct __EpTransformCacheStats {
+    size_t hitCount;      ///< count of lookups that found result
+    size_t missCount;     ///< count of lookups that computed result
+    size_t evictionCount; ///< count of least recently used entries evicted
+    size_t entryCount;    ///< count of currently cached results
+    size_t capacity;      ///< maximal count of cached results
+} EpTransformCacheStats;
+
+/**
+ * @brief transformation result cache constructor
+ * 
+ * @param[in] capacity maximal count of cached results (non-zero)
+ * 
+ * @note cache is not thread-safe, each thread should use its own cache
+ * 
+ * @return created cache (null if allocation failed)
+ */
+EpTransformCache * epTransformCacheCtor( size_t capacity );
+
+/**
+ * @brief transformation result cache destructor
+ * 
+ * @param[in] cache cache to destroy (nullable)
+ */
+void epTransformCacheDtor( EpTransformCache *cache );
+
+/**
+ * @brief transformation result cache statistics getting function
+ * 
+ * @param[in] cache cache to get statistics of (non-null)
+ * 
+ * @return cache statistics
+ */
+EpTransformCacheStats epTransformCacheGetStats( const EpTransformCache *cache );
+
+/**
+ * @brief cached node optimization function
+ * 
+ * @param[in] cache cache (nullable, epNodeOptimize is called if null)
+ * @param[in] node  node to optimize (nullable)
+ * 
+ * @return optimized node (owned by caller, null if node is null or allocation failed)
+ */
+EpNode * epNodeOptimizeCached( EpTransformCache *cache, const EpNode *node );
+
+/**
+ * @brief cached node derivative calculation function
+ * 
+ * @param[in] cache cache (nullable, epNodeDerivative is called if null)
+ * @param[in] node  node to get derivative of (nullable)
+ * @param[in] var   variable to calculate derivative by (non-null)
+ * 
+ * @return derivative (owned by caller, null if node is null or allocation failed)
+ */
+EpNode * epNodeDerivativeCached( EpTransformCache *cache, const EpNode *node, const char *var );
+
+/**
+ * @brief cached taylor series approximation getting function
+ * 
+ * @param[in] cache cache (nullable, same as epNodeTaylor if null)
+ * @param[in] node  node to unfold (non-null)
+ * @param[in] var   variable
+ * @param[in] point point to unfold in taylor series around
+ * @param[in] count count of sum participants
+ * 
+ * @note derivatives and their optimization are taken from cache, so expansions of same node
+ * of growing order cost only one new derivative each.
+ * 
+ * @return approximation function (null if allocation failed)
+ */
+EpNode * epNodeTaylorCached(
+    EpTransformCache * cache,
+    const EpNode     * node,
+    const char       * var,
+    const EpNode     * point,
+    unsigned int       count
+);
+
 /// @brief expression parsing status
 typedef enum __EpParseExpressionStatus {
     EP_PARSE_EXPRESSION_OK,                               ///< parsing succeeded
     EP_PARSE_EXPRESSION_INTERNAL_ERROR,                   ///< internal error occured
     EP_PARSE_EXPRESSION_NO_CLOSING_BRACKET,               ///< no closing bracket in binary operator
-    EP_PARSE_EXPRESSION_TOO_LONG_VAR_NAME,                ///< variable name exceeds EP_NODE_VAR_MAX
     EP_PARSE_EXPRESSION_UNKNOWN_TOKEN,                    ///< given text is not an expression
     EP_PARSE_EXPRESSION_NO_END,                           ///< expression end expected
     EP_PARSE_EXPRESSION_UNEXPECTED_EXPRESSION_END,        ///< unexpected expression end
     EP_PARSE_EXPRESSION_NUMBER_IDENT_OR_BRACKET_EXPECTED, ///< number or ident expected
+    EP_PARSE_EXPRESSION_NO_SEMICOLON,                     ///< ';' after let-binding expression expected
+    EP_PARSE_EXPRESSION_NO_COMMA,                         ///< ',' between call arguments expected
 } EpParseExpressionStatus;
 
 /// @brief expression parsing result representaiton structure (tagged union)
@@ -356,11 +968,6 @@ typedef struct __EpParseExpressionResult {
         } ok; ///< operation succeeded
 
         char unknownBinaryOperator; ///< unknown binary operator occured
-
-        struct {
-            const char *begin; ///< name begin
-            const char *end;   ///< name end (exclusive)
-        } tooLongVarName; ///< too long variable name occured
     };
 } EpParseExpressionResult;
 
@@ -370,13 +977,232 @@ typedef struct __EpParseExpressionResult {
  * @param[in] str text to parse
  * 
  * @return expression parsing result
+ * 
+ * @note expression may be prefixed by 'let name = expression;' bindings (as written by EP_DUMP_INFIX_EXPRESSION_LET dump),
+ * bound names are replaced by bound expressions
  */
 EpParseExpressionResult epParseExpression( const char *str );
 
+/**
+ * @brief infix expression from string slice parsing function
+ * 
+ * @param[in] begin text to parse begin (non-null)
+ * @param[in] end   text to parse end (exclusive, slice is not required to be null-terminated)
+ * 
+ * @return expression parsing result
+ */
+EpParseExpressionResult epParseExpressionSlice( const char *begin, const char *end );
+
+/**
+ * @brief expression parsing status corresponding string getting function
+ * 
+ * @param[in] status parsing status
+ * 
+ * @return corresponding string
+ */
+const char * epParseExpressionStatusStr( EpParseExpressionStatus status );
+
+/// @brief stream parsing entry representation structure
+typedef struct __EpParseStreamEntry {
+    size_t                  line;   ///< line number (1-based)
+    EpParseExpressionResult result; ///< line parsing result
+} EpParseStreamEntry;
+
+/// @brief stream parsing status
+typedef enum __EpParseStreamStatus {
+    EP_PARSE_STREAM_OK,             ///< stream parsed (individual lines still may fail)
+    EP_PARSE_STREAM_OPEN_FAILED,    ///< file opening or mapping failed
+    EP_PARSE_STREAM_INTERNAL_ERROR, ///< internal error (allocation or thread start) occured
+} EpParseStreamStatus;
+
+/// @brief stream parsing result representation structure
+typedef struct __EpParseStreamResult {
+    EpParseStreamStatus  status;     ///< stream parsing status
+
+    EpParseStreamEntry * entries;    ///< parsed non-empty lines in input order
+    size_t               entryCount; ///< count of entries
+
+    const char         * text;       ///< mapped file text (error results point into it)
+    size_t               textSize;   ///< mapped file size
+} EpParseStreamResult;
+
+/**
+ * @brief newline-separated expression file parsing function
+ * 
+ * @param[in] path        file path (non-null)
+ * @param[in] threadCount count of parsing threads (0 to use count of online processors)
+ * 
+ * @note file is mapped to memory and split to chunks at line boundaries, every chunk is parsed on separate thread.
+ * Whitespace-only lines are skipped.
+ * 
+ * @return stream parsing result (must be destroyed by epParseStreamResultDtor)
+ */
+EpParseStreamResult epParseStream( const char *path, unsigned int threadCount );
+
+/**
+ * @brief stream parsing result destructor
+ * 
+ * @param[in] result result to destroy (nullable). All successfully parsed expressions are destroyed too.
+ */
+void epParseStreamResultDtor( EpParseStreamResult *result );
+
+/// @brief binary image format magic
+#define EP_IMAGE_MAGIC "EPNI"
+
+/// @brief binary image format version
+#define EP_IMAGE_VERSION ((uint32_t)1)
+
+/**
+ * Binary image layout (all integers are in native byte order, byte order is checked on load):
+ * 
+ * EpImageHeader                          header
+ * double        [header.constantCount]   constant pool
+ * EpImageNode   [header.nodeCount]       nodes in postorder (root is the last one)
+ * uint32_t      [header.variableCount+1] variable name offsets in name storage
+ * char          [header.nameStorageSize] null-terminated variable names
+ */
+
+/// @brief binary image header representation structure
+typedef struct __EpImageHeader {
+    char     magic[4];        ///< EP_IMAGE_MAGIC
+    uint32_t version;         ///< EP_IMAGE_VERSION
+    uint32_t byteOrderMark;   ///< 0x01020304 in writer byte order
+    uint32_t nodeCount;       ///< count of nodes
+    uint32_t constantCount;   ///< count of constants in pool
+    uint32_t variableCount;   ///< count of interned variables
+    uint32_t nameStorageSize; ///< variable name storage size (in bytes)
+    uint32_t reserved;        ///< reserved (zero)
+} EpImageHeader;
+
+/// @brief binary image node representation structure
+typedef struct __EpImageNode {
+    uint8_t  type;     ///< node type (EpNodeType)
+    uint8_t  op;       ///< operator (EpBinaryOperator or EpUnaryOperator)
+    uint16_t reserved; ///< reserved (zero)
+    uint32_t lhs;      ///< left hand side / operand node index, constant index or variable index
+    uint32_t rhs;      ///< right hand side node index
+} EpImageNode;
+
+/// @brief binary image (read-only view) representation structure
+typedef struct __EpImage {
+    const EpImageNode * nodes;           ///< nodes in postorder
+    uint32_t            nodeCount;       ///< count of nodes
+    const double      * constants;       ///< constant pool
+    uint32_t            constantCount;   ///< count of constants
+    const uint32_t    * variableOffsets; ///< variable name offsets
+    const char        * variableNames;   ///< variable name storage
+    uint32_t            variableCount;   ///< count of variables
+
+    void              * mapping;         ///< file mapping (NULL if image is built on user memory)
+    size_t              mappingSize;     ///< file mapping size
+} EpImage;
+
+/// @brief binary image loading status
+typedef enum __EpImageStatus {
+    EP_IMAGE_OK,               ///< image loaded
+    EP_IMAGE_OPEN_FAILED,      ///< file opening or mapping failed
+    EP_IMAGE_INVALID_HEADER,   ///< invalid magic, version or byte order
+    EP_IMAGE_INVALID_CONTENTS, ///< image contents are inconsistent (out of range index, invalid tag, nodes that don't form a tree, etc.)
+    EP_IMAGE_INTERNAL_ERROR,   ///< internal error (allocation failed during validation)
+} EpImageStatus;
+
+/**
+ * @brief node to binary image writing function
+ * 
+ * @param[in] out  output file (opened in binary mode)
+ * @param[in] node node to write (non-null)
+ * 
+ * @return true if written, false if allocation or writing failed
+ */
+bool epImageWrite( FILE *out, const EpNode *node );
+
+/**
+ * @brief binary image from memory loading function
+ * 
+ * @param[in]  data image data (at least 8-byte aligned, must outlive image)
+ * @param[in]  size image data size
+ * @param[out] dst  image destination (non-null)
+ * 
+ * @note no data is copied, image refers to data directly. Nodes are validated to form a single tree:
+ * every node except the root (the last one) is referenced by exactly one parent.
+ * 
+ * @return loading status
+ */
+EpImageStatus epImageFromMemory( const void *data, size_t size, EpImage *dst );
+
+/**
+ * @brief binary image file opening function
+ * 
+ * @param[in]  path file path (non-null)
+ * @param[out] dst  image destination (non-null, must be closed by epImageClose in case if EP_IMAGE_OK returned)
+ * 
+ * @note file is mapped to memory, no per-node allocations are performed (validation allocates one byte per node)
+ * 
+ * @return loading status
+ */
+EpImageStatus epImageOpen( const char *path, EpImage *dst );
+
+/**
+ * @brief binary image closing function
+ * 
+ * @param[in] image image to close (nullable)
+ */
+void epImageClose( EpImage *image );
+
+/**
+ * @brief binary image variable name getting function
+ * 
+ * @param[in] image image (non-null)
+ * @param[in] index variable index (less than image->variableCount)
+ * 
+ * @return variable name
+ */
+const char * epImageGetVariableName( const EpImage *image, uint32_t index );
+
+/**
+ * @brief binary image to node conversion function
+ * 
+ * @param[in] image image to convert (non-null)
+ * 
+ * @return created node (null if image is empty or allocation failed)
+ */
+EpNode * epImageToNode( const EpImage *image );
+
+/**
+ * @brief binary image value computation function
+ * 
+ * @param[in] image         image to compute (non-null, non-empty)
+ * @param[in] variables     variables used in computation array (non-null if variableCount != 0)
+ * @param[in] variableCount count of variables used in computation
+ * 
+ * @note image is evaluated in place by single postorder sweep
+ */
+EpNodeComputeResult epImageCompute(
+    const EpImage    * image,
+    const EpVariable * variables,
+    size_t             variableCount
+);
+
+/// @brief growable byte buffer representation structure (zero-initialized buffer is empty)
+typedef struct __EpBuffer {
+    char   * data;     ///< buffer data (null-terminated if not NULL)
+    size_t   size;     ///< data size (terminating null is not counted)
+    size_t   capacity; ///< allocated data capacity
+} EpBuffer;
+
+/**
+ * @brief buffer destructor
+ * 
+ * @param[in,out] buffer buffer to destroy (nullable), it becomes empty
+ */
+void epBufferDtor( EpBuffer *buffer );
+
 /// @brief dumping representation structure
 typedef enum __EpDumpFormat {
-    EP_DUMP_INFIX_EXPRESSION,  ///< more 'general' expression format
-    EP_DUMP_TEX,               ///< TeX expression
+    EP_DUMP_INFIX_EXPRESSION,     ///< more 'general' expression format
+    EP_DUMP_TEX,                  ///< TeX expression
+    EP_DUMP_INFIX_EXPRESSION_LET, ///< infix expression with repeated subexpressions bound once by 'let t1 = ...;' prefixes (parseable back)
+    EP_DUMP_TEX_WHERE,            ///< TeX expression with repeated subexpressions written once in '\text{where}' clause
 } EpDumpFormat;
 
 /**
@@ -385,9 +1211,45 @@ typedef enum __EpDumpFormat {
  * @param[in] out    output file
  * @param[in] node   node to dump
  * @param[in] format dumping format
+ * 
+ * @note dump is written by chunks, output is truncated if traversal stack allocation failed (on very deep trees only).
+ * Sharing-aware formats fall back to plain ones if sharing detection allocation failed.
  */
 void epNodeDump( FILE *out, const EpNode *node, EpDumpFormat format );
 
+/**
+ * @brief node to buffer dumping function
+ * 
+ * @param[in,out] buffer buffer to append dump to (non-null)
+ * @param[in]     node   node to dump (non-null)
+ * @param[in]     format dumping format
+ * 
+ * @return true if succeeded, false if allocation failed (buffer contains partial dump then)
+ */
+bool epNodeDumpToBuffer( EpBuffer *buffer, const EpNode *node, EpDumpFormat format );
+
+/**
+ * @brief node to string dumping function
+ * 
+ * @param[in] node   node to dump (non-null)
+ * @param[in] format dumping format
+ * 
+ * @return null-terminated dump (must be freed by caller, NULL if allocation failed)
+ */
+char * epNodeDumpToString( const EpNode *node, EpDumpFormat format );
+
+/**
+ * @brief infix dump round-trip check function
+ * 
+ * @param[in] out file to write check summary and first mismatch to (nullable)
+ * 
+ * @return true if every checked tree is parsed back from its infix dumps to identical tree with bit-identical values, false otherwise
+ * 
+ * @note checked trees are deterministic pseudo-random ones (with integer powers and non-finite constants) and their
+ * optimized versions. Non-finite constants are dumped as divisions by zero, so they are parsed back as such divisions.
+ */
+bool epDumpRoundTripCheck( FILE *out );
+
 /**
  * @brief TeX graph from node generation function
  * 
@@ -404,6 +1266,120 @@ void epNodeGenNodeFunctionInfo( FILE *out, const EpNode *node );
  */
 void epDbgNodeDumpDot( FILE *out, const EpNode *node );
 
+/// @brief instrumented phase (public entry point group)
+typedef enum __EpStatsPhase {
+    EP_STATS_PHASE_PARSE,      ///< epParseExpression
+    EP_STATS_PHASE_OPTIMIZE,   ///< epNodeOptimize
+    EP_STATS_PHASE_DERIVATIVE, ///< epNodeDerivative
+    EP_STATS_PHASE_TAYLOR,     ///< epNodeTaylor
+    EP_STATS_PHASE_SUBSTITUTE, ///< epNodeSubstitute
+    EP_STATS_PHASE_COMPUTE,    ///< epNodeCompute
+    EP_STATS_PHASE_DUMP,       ///< epNodeDump
+    EP_STATS_PHASE_INFO,       ///< epNodeGenNodeFunctionInfo
+
+    EP_STATS_PHASE_COUNT,      ///< count of phases (not a phase)
+} EpStatsPhase;
+
+/// @brief optimizer rewrite rule group
+typedef enum __EpStatsRule {
+    EP_STATS_RULE_CONSTANT_FOLD,     ///< operator on constants is replaced by constant
+    EP_STATS_RULE_NEUTRAL_ELEMENT,   ///< neutral operand is removed ('x + 0', 'x * 1', 'x ^ 1', ...)
+    EP_STATS_RULE_ABSORBING_ELEMENT, ///< operator is replaced by constant ('x * 0', '0 / x', 'x ^ 0', ...)
+    EP_STATS_RULE_SAME_OPERANDS,     ///< operator on same operands is simplified ('x * x', 'x / x', 'x + x', 'x - x')
+    EP_STATS_RULE_SIGN,              ///< negations are cancelled or moved out of operator
+    EP_STATS_RULE_POWER,             ///< power is rewritten ('x ^ 0.5' to 'sqrt x', 'x ^ n' to integer power, ...)
+
+    EP_STATS_RULE_COUNT,             ///< count of rule groups (not a rule)
+} EpStatsRule;
+
+/// @brief phase timer representation structure
+typedef struct __EpStatsPhaseTimer {
+    uint64_t calls;       ///< count of calls (nested calls of the same phase are not counted)
+    uint64_t nanoseconds; ///< total call time (inclusive, nested phases of other kinds are counted in both)
+} EpStatsPhaseTimer;
+
+/// @brief instrumentation counters snapshot representation structure
+typedef struct __EpStats {
+    bool              enabled;                        ///< false if library is built without instrumentation (all counters are zero then)
+    uint64_t          nodeAllocations;                ///< count of allocated nodes
+    uint64_t          nodeFrees;                      ///< count of freed nodes
+    uint64_t          copyCalls;                      ///< count of epNodeCopy calls
+    uint64_t          copiedNodes;                    ///< count of nodes copied by epNodeCopy
+    uint64_t          isSameCalls;                    ///< count of epNodeIsSame calls
+    uint64_t          isSameNodes;                    ///< count of node pairs compared by epNodeIsSame
+    uint64_t          isSameMaxDepth;                 ///< maximal depth single epNodeIsSame call descended to (root pair depth is 1)
+    uint64_t          ruleHits[EP_STATS_RULE_COUNT];  ///< optimizer rule group hit counts
+    EpStatsPhaseTimer phases[EP_STATS_PHASE_COUNT];   ///< phase timers
+} EpStats;
+
+/**
+ * @brief instrumentation counters snapshot getting function
+ * 
+ * @return counters accumulated by all threads (including finished ones) since start or last epStatsReset call
+ * 
+ * @note counters of running threads are read without stopping them, so snapshot taken during parallel work is approximate
+ */
+EpStats epStatsSnapshot( void );
+
+/**
+ * @brief instrumentation counters resetting function
+ */
+void epStatsReset( void );
+
+/**
+ * @brief phase name getting function
+ * 
+ * @param[in] phase phase
+ * 
+ * @return phase name
+ */
+const char * epStatsPhaseStr( EpStatsPhase phase );
+
+/**
+ * @brief optimizer rule group name getting function
+ * 
+ * @param[in] rule rule group
+ * 
+ * @return rule group name
+ */
+const char * epStatsRuleStr( EpStatsRule rule );
+
+/**
+ * @brief instrumentation counters snapshot in human-readable format dumping function
+ * 
+ * @param[in] out   output file (non-null)
+ * @param[in] stats snapshot to dump (non-null)
+ */
+void epStatsDump( FILE *out, const EpStats *stats );
+
+/// @brief default count of trace events kept per thread
+#define EP_TRACE_DEFAULT_EVENT_CAPACITY ((size_t)65536)
+
+/**
+ * @brief trace event recording starting function
+ * 
+ * @param[in] eventCapacity count of events kept per thread (EP_TRACE_DEFAULT_EVENT_CAPACITY if 0)
+ * 
+ * @note events are written to per-thread ring buffers, so if thread records more than eventCapacity events,
+ * its oldest events are overwritten.
+ * 
+ * @return true if started, false if recording is already started
+ */
+bool epTraceStart( size_t eventCapacity );
+
+/**
+ * @brief trace event recording stopping and Chrome trace event format (JSON) dumping function
+ * 
+ * @param[in] out output file (nullable, events are discarded if NULL)
+ * 
+ * @note must not be called while other threads run traced functions.
+ * Spans are parse, optimize, derivative (and each derivative order of Taylor series), Taylor series
+ * (and each its order), function info and each its section, node counts are span arguments.
+ * 
+ * @return true if recording was started and trace is written, false if not
+ */
+bool epTraceStop( FILE *out );
+
 #ifdef __cplusplus
 }
 #endif
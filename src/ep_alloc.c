@@ -0,0 +1,141 @@
+/**
+ * @brief node allocator implementation file
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+
+#include "ep_internal.h"
+
+/// @brief global allocator (atomic, NULL if calloc and free are used)
+static const EpAllocator *epNodeAllocatorGlobal = NULL;
+
+/// @brief calling thread allocator (NULL if global one is used)
+static __thread const EpAllocator *epNodeAllocatorThread = NULL;
+
+void epNodeAllocatorSetGlobal( const EpAllocator *allocator ) {
+    assert(allocator == NULL || (allocator->alloc != NULL && allocator->free != NULL));
+
+    __atomic_store_n(&epNodeAllocatorGlobal, allocator, __ATOMIC_RELEASE);
+} // epNodeAllocatorSetGlobal
+
+const EpAllocator * epNodeAllocatorSetThread( const EpAllocator *allocator ) {
+    assert(allocator == NULL || (allocator->alloc != NULL && allocator->free != NULL));
+
+    const EpAllocator *previous = epNodeAllocatorThread;
+
+    epNodeAllocatorThread = allocator;
+    return previous;
+} // epNodeAllocatorSetThread
+
+const EpAllocator * epNodeAllocatorGet( void ) {
+    return epNodeAllocatorThread != NULL
+        ? epNodeAllocatorThread
+        : __atomic_load_n(&epNodeAllocatorGlobal, __ATOMIC_ACQUIRE);
+} // epNodeAllocatorGet
+
+/// @brief tracking allocator representation structure
+struct __EpTrackingAllocator {
+    EpAllocator allocator;       ///< allocator interface (context is tracking allocator itself)
+    size_t      limit;           ///< live byte limit (0 if unlimited)
+    size_t      liveBytes;       ///< currently allocated bytes (atomic)
+    size_t      peakBytes;       ///< maximal allocated bytes (atomic)
+    uint64_t    allocationCount; ///< count of succeeded allocations (atomic)
+    uint64_t    freeCount;       ///< count of frees (atomic)
+    uint64_t    failedCount;     ///< count of failed allocations (atomic)
+}; // struct __EpTrackingAllocator
+
+/**
+ * @brief tracking allocator allocation function
+ * 
+ * @param[in] context tracking allocator
+ * @param[in] size    allocation size
+ * 
+ * @return zero-initialized memory (NULL if limit is exceeded or allocation failed)
+ */
+static void * epTrackingAllocatorAlloc( void *context, size_t size ) {
+    EpTrackingAllocator *self = (EpTrackingAllocator *)context;
+    size_t liveBytes = __atomic_load_n(&self->liveBytes, __ATOMIC_RELAXED);
+
+    // bytes are reserved before allocation, so concurrent allocations can't exceed limit together
+    do {
+        if (self->limit != 0 && (liveBytes > self->limit || size > self->limit - liveBytes)) {
+            __atomic_fetch_add(&self->failedCount, 1, __ATOMIC_RELAXED);
+            return NULL;
+        }
+    } while (!__atomic_compare_exchange_n(&self->liveBytes, &liveBytes, liveBytes + size, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+
+    void *ptr = calloc(1, size);
+
+    if (ptr == NULL) {
+        __atomic_fetch_sub(&self->liveBytes, size, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&self->failedCount, 1, __ATOMIC_RELAXED);
+        return NULL;
+    }
+
+    __atomic_fetch_add(&self->allocationCount, 1, __ATOMIC_RELAXED);
+
+    const size_t newLiveBytes = liveBytes + size;
+    size_t peakBytes = __atomic_load_n(&self->peakBytes, __ATOMIC_RELAXED);
+
+    while (newLiveBytes > peakBytes && !__atomic_compare_exchange_n(&self->peakBytes, &peakBytes, newLiveBytes, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        ;
+
+    return ptr;
+} // epTrackingAllocatorAlloc
+
+/**
+ * @brief tracking allocator freeing function
+ * 
+ * @param[in] context tracking allocator
+ * @param[in] ptr     memory to free (non-null)
+ * @param[in] size    allocation size
+ */
+static void epTrackingAllocatorFree( void *context, void *ptr, size_t size ) {
+    EpTrackingAllocator *self = (EpTrackingAllocator *)context;
+
+    free(ptr);
+    __atomic_fetch_sub(&self->liveBytes, size, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&self->freeCount, 1, __ATOMIC_RELAXED);
+} // epTrackingAllocatorFree
+
+EpTrackingAllocator * epTrackingAllocatorCtor( size_t limit ) {
+    EpTrackingAllocator *self = (EpTrackingAllocator *)calloc(1, sizeof(EpTrackingAllocator));
+
+    if (self == NULL)
+        return NULL;
+
+    self->allocator = (EpAllocator) {
+        .alloc = epTrackingAllocatorAlloc,
+        .free = epTrackingAllocatorFree,
+        .context = self,
+    };
+    self->limit = limit;
+
+    return self;
+} // epTrackingAllocatorCtor
+
+void epTrackingAllocatorDtor( EpTrackingAllocator *tracking ) {
+    free(tracking);
+} // epTrackingAllocatorDtor
+
+const EpAllocator * epTrackingAllocatorGetAllocator( EpTrackingAllocator *tracking ) {
+    assert(tracking != NULL);
+
+    return &tracking->allocator;
+} // epTrackingAllocatorGetAllocator
+
+EpTrackingAllocatorStats epTrackingAllocatorGetStats( const EpTrackingAllocator *tracking ) {
+    assert(tracking != NULL);
+
+    return (EpTrackingAllocatorStats) {
+        .limit           = tracking->limit,
+        .liveBytes       = __atomic_load_n(&tracking->liveBytes, __ATOMIC_RELAXED),
+        .peakBytes       = __atomic_load_n(&tracking->peakBytes, __ATOMIC_RELAXED),
+        .allocationCount = __atomic_load_n(&tracking->allocationCount, __ATOMIC_RELAXED),
+        .freeCount       = __atomic_load_n(&tracking->freeCount, __ATOMIC_RELAXED),
+        .failedCount     = __atomic_load_n(&tracking->failedCount, __ATOMIC_RELAXED),
+    };
+} // epTrackingAllocatorGetStats
+
+// ep_alloc.c
@@ -0,0 +1,648 @@
+/**
+ * @brief approximate math functions implementation file
+ */
+
+#include <assert.h>
+#include <float.h>
+#include <math.h>
+#include <string.h>
+
+#include "ep_internal.h"
+
+/// @brief kernel inlining specifier (kernels must be inlined with constant tier, so polynomial loops are unrolled)
+#ifdef __GNUC__
+    #define EP_APPROX_INLINE __attribute__((__always_inline__)) inline
+#else
+    #define EP_APPROX_INLINE inline
+#endif
+
+/// @brief polynomial representation structure
+typedef struct __EpApproxPoly {
+    const double * coefs; ///< coefficients, starting from constant term
+    size_t         count; ///< count of coefficients
+} EpApproxPoly;
+
+/// @brief accuracy tier kernel set representation structure
+typedef struct __EpApproxTier {
+    EpApproxPoly exp;  ///< e^r for r in [-ln(2) / 2, ln(2) / 2]
+    EpApproxPoly sin;  ///< sin(r) / r by r^2 for r in [-pi / 4, pi / 4]
+    EpApproxPoly cos;  ///< cos(r) by r^2 for r in [-pi / 4, pi / 4]
+    EpApproxPoly atan; ///< atan(u) / u by u^2 for u in [-tan(pi / 12), tan(pi / 12)]
+    EpApproxPoly ln;   ///< ln(m) / f, f = (m - 1) / (m + 1) by f^2 for m in [sqrt(2) / 2, sqrt(2)]
+} EpApproxTier;
+
+/*
+ * Coefficients are Taylor series of kernels on reduced argument ranges, economized by Chebyshev polynomials
+ * (that is close to minimax) down to the lowest degree that keeps error below quarter of tier bound.
+ */
+
+static const double EP_APPROX_EXP_7[]  = { 0.99999999995966948, 1.0000000376062754, 0.50000001074465006, 0.1666641619455449, 0.041666219395037778, 0.0083750393241248441, 0.0013948468875733904 };
+static const double EP_APPROX_SIN_7[]  = { 0.99999999688293362, -0.16666650496434179, 0.0083320226236570927, -0.00019501295042400748 };
+static const double EP_APPROX_COS_7[]  = { 0.9999999999519309, -0.49999999610366702, 0.041666616134690145, -0.0013886595146955466, 2.4376618803000935e-05 };
+static const double EP_APPROX_ATAN_7[] = { 0.99999997969994514, -0.33332421323565226, 0.1993563275703682, -0.12812242568113771 };
+static const double EP_APPROX_LN_7[]   = { 1.999999998625686, 0.66666815582587646, 0.39974842090199003, 0.299240631681231 };
+
+static const double EP_APPROX_EXP_12[]  = { 1.0000000000000135, 1.0000000000000067, 0.49999999999439854, 0.16666666666554639, 0.041666667039744795, 0.0083333333855642715, 0.0013888801919405493, 0.00019841170447574533, 2.4884337283316488e-05, 2.7640069205715078e-06 };
+static const double EP_APPROX_SIN_12[]  = { 0.99999999999999567, -0.16666666666616245, 0.008333333323796854, -0.00019841263245021158, 2.7555256918551245e-06, -2.4754927617199503e-08 };
+static const double EP_APPROX_COS_12[]  = { 0.99999999999994449, -0.4999999999935153, 0.041666666543966994, -0.0013888880396415088, 2.4798929273602498e-05, -2.7173466629960863e-07 };
+static const double EP_APPROX_ATAN_12[] = { 0.9999999999999365, -0.33333333324628917, 0.19999998047760231, -0.14285549665963745, 0.11104470886174561, -0.089521615516689343, 0.062220256353229253 };
+static const double EP_APPROX_LN_12[]   = { 1.9999999999999469, 0.66666666679635667, 0.39999994876671036, 0.28572167564982165, 0.2217419610661244, 0.19608799986015379 };
+
+/// @brief polynomial from coefficient array initializer
+#define EP_APPROX_POLY(array) { .coefs = (array), .count = sizeof(array) / sizeof((array)[0]) }
+
+/// @brief 1e-7 tier kernels
+static const EpApproxTier EP_APPROX_TIER_7 = {
+    .exp  = EP_APPROX_POLY(EP_APPROX_EXP_7),
+    .sin  = EP_APPROX_POLY(EP_APPROX_SIN_7),
+    .cos  = EP_APPROX_POLY(EP_APPROX_COS_7),
+    .atan = EP_APPROX_POLY(EP_APPROX_ATAN_7),
+    .ln   = EP_APPROX_POLY(EP_APPROX_LN_7),
+};
+
+/// @brief 1e-12 tier kernels
+static const EpApproxTier EP_APPROX_TIER_12 = {
+    .exp  = EP_APPROX_POLY(EP_APPROX_EXP_12),
+    .sin  = EP_APPROX_POLY(EP_APPROX_SIN_12),
+    .cos  = EP_APPROX_POLY(EP_APPROX_COS_12),
+    .atan = EP_APPROX_POLY(EP_APPROX_ATAN_12),
+    .ln   = EP_APPROX_POLY(EP_APPROX_LN_12),
+};
+
+/// @brief 1.5 * 2^52, adding it rounds double of magnitude below 2^51 to integer stored in low mantissa bits
+#define EP_APPROX_ROUND_MAGIC 6755399441055744.0
+
+/// @brief bits of EP_APPROX_ROUND_MAGIC
+#define EP_APPROX_ROUND_MAGIC_BITS ((uint64_t)0x4338000000000000)
+
+/// @brief pi / 2 split to parts (first two parts have trailing zero bits, so their products by quadrant are exact)
+#define EP_APPROX_PIO2_1 1.57079632673412561417e+00
+#define EP_APPROX_PIO2_2 6.07710050630396597660e-11
+#define EP_APPROX_PIO2_3 2.02226624871116645580e-21
+
+/// @brief maximal trigonometric function argument absolute value reduction keeps accuracy for
+#define EP_APPROX_TRIG_MAX 1e6
+
+/// @brief ln(2) split to parts (first part has trailing zero bits)
+#define EP_APPROX_LN2_HI 6.93147180369123816490e-01
+#define EP_APPROX_LN2_LO 1.90821492927058770002e-10
+
+/**
+ * @brief accuracy tier kernels getting function
+ * 
+ * @param[in] accuracy accuracy (approximate)
+ * 
+ * @return tier kernels
+ */
+static inline const EpApproxTier * epApproxGetTier( EpMathAccuracy accuracy ) {
+    assert(accuracy != EP_MATH_ACCURACY_EXACT);
+
+    return accuracy == EP_MATH_ACCURACY_APPROX7
+        ? &EP_APPROX_TIER_7
+        : &EP_APPROX_TIER_12;
+} // epApproxGetTier
+
+/**
+ * @brief double bits getting function
+ * 
+ * @param[in] value value
+ * 
+ * @return value bits
+ */
+static EP_APPROX_INLINE uint64_t epApproxBits( double value ) {
+    uint64_t bits;
+
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+} // epApproxBits
+
+/**
+ * @brief double from bits getting function
+ * 
+ * @param[in] bits value bits
+ * 
+ * @return value
+ */
+static EP_APPROX_INLINE double epApproxFromBits( uint64_t bits ) {
+    double value;
+
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+} // epApproxFromBits
+
+/**
+ * @brief polynomial evaluation function
+ * 
+ * @param[in] poly polynomial
+ * @param[in] x    argument
+ * 
+ * @return polynomial value
+ */
+static EP_APPROX_INLINE double epApproxPolyEval( const EpApproxPoly *poly, double x ) {
+    double result = poly->coefs[poly->count - 1];
+
+    for (size_t i = poly->count - 1; i != 0; i--)
+        result = result * x + poly->coefs[i - 1];
+    return result;
+} // epApproxPolyEval
+
+/**
+ * @brief exponent approximation function
+ * 
+ * @param[in] tier tier kernels
+ * @param[in] x    argument
+ * 
+ * @return e^x
+ */
+static EP_APPROX_INLINE double epApproxExp( const EpApproxTier *tier, double x ) {
+    // out of [-746, 710] result is zero or infinity anyway, so argument is clamped to keep exponent in range
+    // (comparisons instead of fmin/fmax, because last ones are library calls without fast-math flags)
+    const double clamped = x < -746.0 ? -746.0 : x > 710.0 ? 710.0 : x;
+    const double shifted = clamped * M_LOG2E + EP_APPROX_ROUND_MAGIC;
+    const double n = shifted - EP_APPROX_ROUND_MAGIC;
+    const int64_t exponent = (int64_t)(epApproxBits(shifted) - EP_APPROX_ROUND_MAGIC_BITS);
+    const double r = clamped - n * EP_APPROX_LN2_HI - n * EP_APPROX_LN2_LO;
+
+    // 2^n is applied by two halves, so subnormal results and 2^1024 are handled without branches
+    const int64_t exponentHalf = exponent >> 1;
+    const double scale1 = epApproxFromBits((uint64_t)(exponentHalf + 1023) << 52);
+    const double scale2 = epApproxFromBits((uint64_t)(exponent - exponentHalf + 1023) << 52);
+    const double result = epApproxPolyEval(&tier->exp, r) * scale1 * scale2;
+
+    return x != x ? x : result;
+} // epApproxExp
+
+/**
+ * @brief natural logarithm approximation function
+ * 
+ * @param[in] tier tier kernels
+ * @param[in] x    argument
+ * 
+ * @return ln(x)
+ */
+static EP_APPROX_INLINE double epApproxLn( const EpApproxTier *tier, double x ) {
+    // subnormals are normalized by scaling
+    const bool subnormal = x < DBL_MIN;
+    const double normal = subnormal ? x * 18014398509481984.0 : x; // 2^54
+    const uint64_t bits = epApproxBits(normal);
+
+    // x = m * 2^e, m in [sqrt(2) / 2, sqrt(2)]
+    double m = epApproxFromBits((bits & (((uint64_t)1 << 52) - 1)) | ((uint64_t)1023 << 52));
+    // exponent field is put to mantissa of 2^52, so it is converted to double without integer conversion
+    double e = epApproxFromBits((bits >> 52) | EP_APPROX_ROUND_MAGIC_BITS) - EP_APPROX_ROUND_MAGIC - (subnormal ? 1023.0 + 54.0 : 1023.0);
+    const bool reduce = m > M_SQRT2;
+
+    m = reduce ? m * 0.5 : m;
+    e = reduce ? e + 1.0 : e;
+
+    // ln(m) = 2 * atanh(f)
+    const double f = (m - 1.0) / (m + 1.0);
+    const double result = e * EP_APPROX_LN2_HI + (f * epApproxPolyEval(&tier->ln, f * f) + e * EP_APPROX_LN2_LO);
+
+    return false
+        || x < 0.0 || x != x ? NAN
+        : x == 0.0           ? -INFINITY
+        : x == INFINITY      ? INFINITY
+        : result;
+} // epApproxLn
+
+/// @brief sine and cosine pair representation structure
+typedef struct __EpApproxSinCosPair {
+    double sin; ///< sine
+    double cos; ///< cosine
+} EpApproxSinCosPair;
+
+/**
+ * @brief sine and cosine approximation function
+ * 
+ * @param[in] tier tier kernels
+ * @param[in] x    argument (accuracy degrades for |x| above EP_APPROX_TRIG_MAX)
+ * 
+ * @return sine and cosine of x (pair is returned by value, so it doesn't stay in memory in vectorized loops)
+ */
+static EP_APPROX_INLINE EpApproxSinCosPair epApproxSinCos( const EpApproxTier *tier, double x ) {
+    const double shifted = x * M_2_PI + EP_APPROX_ROUND_MAGIC;
+    const double n = shifted - EP_APPROX_ROUND_MAGIC;
+    const uint64_t quadrant = epApproxBits(shifted) & 3;
+    const double r = x - n * EP_APPROX_PIO2_1 - n * EP_APPROX_PIO2_2 - n * EP_APPROX_PIO2_3;
+    const double r2 = r * r;
+
+    const double sinR = r * epApproxPolyEval(&tier->sin, r2);
+    const double cosR = epApproxPolyEval(&tier->cos, r2);
+
+    // sin(x) = sin(r), cos(r), -sin(r), -cos(r) and cos(x) = cos(r), -sin(r), -cos(r), sin(r) for quadrants 0..3
+    // values are swapped and negated by bit masks, because there are no 64-bit integer comparisons in SSE2
+    const uint64_t swapMask = (uint64_t)0 - (quadrant & 1);
+    const uint64_t sinSign = (quadrant & 2) << 62;
+    const uint64_t cosSign = ((quadrant + 1) & 2) << 62;
+    const uint64_t sinBits = epApproxBits(sinR);
+    const uint64_t cosBits = epApproxBits(cosR);
+
+    return (EpApproxSinCosPair) {
+        .sin = epApproxFromBits(((cosBits & swapMask) | (sinBits & ~swapMask)) ^ sinSign),
+        .cos = epApproxFromBits(((sinBits & swapMask) | (cosBits & ~swapMask)) ^ cosSign),
+    };
+} // epApproxSinCos
+
+/**
+ * @brief single trigonometric function approximation function
+ * 
+ * @param[in] tier tier kernels
+ * @param[in] op   trigonometric operator (sine, cosine, tangent or cotangent)
+ * @param[in] x    argument (accuracy degrades for |x| above EP_APPROX_TRIG_MAX)
+ * 
+ * @return op(x)
+ */
+static EP_APPROX_INLINE double epApproxTrig( const EpApproxTier *tier, EpUnaryOperator op, double x ) {
+    const EpApproxSinCosPair pair = epApproxSinCos(tier, x);
+
+    switch (op) {
+    case EP_UNARY_OPERATOR_SIN: return pair.sin;
+    case EP_UNARY_OPERATOR_COS: return pair.cos;
+    case EP_UNARY_OPERATOR_TAN: return pair.sin / pair.cos;
+    case EP_UNARY_OPERATOR_COT: return pair.cos / pair.sin;
+    default                   : return NAN;
+    }
+} // epApproxTrig
+
+/**
+ * @brief arctangent approximation function
+ * 
+ * @param[in] tier tier kernels
+ * @param[in] x    argument
+ * 
+ * @return atan(x)
+ */
+static EP_APPROX_INLINE double epApproxAtan( const EpApproxTier *tier, double x ) {
+    const double a = fabs(x);
+
+    // atan(a) = pi / 2 - atan(1 / a)
+    const bool invert = a > 1.0;
+    const double t = invert ? 1.0 / a : a;
+
+    // atan(t) = pi / 6 + atan((t * sqrt(3) - 1) / (t + sqrt(3)))
+    const bool shift = t > 0.26794919243112270; // tan(pi / 12)
+    const double u = shift ? (t * 1.73205080756887729 - 1.0) / (t + 1.73205080756887729) : t;
+
+    double result = u * epApproxPolyEval(&tier->atan, u * u);
+
+    result = shift ? M_PI / 6.0 + result : result;
+    result = invert ? M_PI_2 - result : result;
+    return copysign(result, x);
+} // epApproxAtan
+
+/**
+ * @brief arcsine approximation function
+ * 
+ * @param[in] tier tier kernels
+ * @param[in] x    argument
+ * 
+ * @return asin(x)
+ */
+static EP_APPROX_INLINE double epApproxAsin( const EpApproxTier *tier, double x ) {
+    // expressed by arctangent without cancellation near |x| = 1
+    return epApproxAtan(tier, x / sqrt((1.0 - x) * (1.0 + x)));
+} // epApproxAsin
+
+/**
+ * @brief arccosine approximation function
+ * 
+ * @param[in] tier tier kernels
+ * @param[in] x    argument
+ * 
+ * @return acos(x)
+ */
+static EP_APPROX_INLINE double epApproxAcos( const EpApproxTier *tier, double x ) {
+    return 2.0 * epApproxAtan(tier, sqrt((1.0 - x) / (1.0 + x)));
+} // epApproxAcos
+
+/**
+ * @brief arccotangent approximation function
+ * 
+ * @param[in] tier tier kernels
+ * @param[in] x    argument
+ * 
+ * @return acot(x) in (0, pi)
+ */
+static EP_APPROX_INLINE double epApproxAcot( const EpApproxTier *tier, double x ) {
+    // same as atan(-x) + pi / 2, but without cancellation for large |x|
+    const double result = epApproxAtan(tier, 1.0 / x);
+
+    return result < 0.0 ? result + M_PI : result;
+} // epApproxAcot
+
+/**
+ * @brief unary operator approximation function
+ * 
+ * @param[in] tier    tier kernels
+ * @param[in] op      operator
+ * @param[in] operand operand
+ * 
+ * @return approximate result of applying op on operand
+ */
+static inline double epApproxUnary( const EpApproxTier *tier, EpUnaryOperator op, double operand ) {
+    if (fabs(operand) > EP_APPROX_TRIG_MAX && (false
+        || op == EP_UNARY_OPERATOR_SIN
+        || op == EP_UNARY_OPERATOR_COS
+        || op == EP_UNARY_OPERATOR_TAN
+        || op == EP_UNARY_OPERATOR_COT
+    ))
+        return epUnaryOperatorApply(op, operand);
+
+    switch (op) {
+    case EP_UNARY_OPERATOR_NEG : return -operand;
+    case EP_UNARY_OPERATOR_LN  : return epApproxLn(tier, operand);
+
+    case EP_UNARY_OPERATOR_SIN :
+    case EP_UNARY_OPERATOR_COS :
+    case EP_UNARY_OPERATOR_TAN :
+    case EP_UNARY_OPERATOR_COT : return epApproxTrig(tier, op, operand);
+
+    case EP_UNARY_OPERATOR_ASIN: return epApproxAsin(tier, operand);
+    case EP_UNARY_OPERATOR_ACOS: return epApproxAcos(tier, operand);
+    case EP_UNARY_OPERATOR_ATAN: return epApproxAtan(tier, operand);
+    case EP_UNARY_OPERATOR_ACOT: return epApproxAcot(tier, operand);
+
+    case EP_UNARY_OPERATOR_EXP : return epApproxExp(tier, operand);
+    case EP_UNARY_OPERATOR_SQRT: return sqrt(operand); // hardware square root is already exact and fast
+    }
+
+    return NAN;
+} // epApproxUnary
+
+/**
+ * @brief raising to a power approximation function
+ * 
+ * @param[in] tier tier kernels
+ * @param[in] lhs  base
+ * @param[in] rhs  exponent
+ * 
+ * @return lhs^rhs
+ */
+static inline double epApproxPow( const EpApproxTier *tier, double lhs, double rhs ) {
+    // non-positive bases require exponent parity analysis, so they are left to libm
+    if (!(lhs > 0.0))
+        return pow(lhs, rhs);
+    return epApproxExp(tier, rhs * epApproxLn(tier, lhs));
+} // epApproxPow
+
+double epUnaryOperatorApplyApprox( EpUnaryOperator op, double operand, EpMathAccuracy accuracy ) {
+    if (accuracy == EP_MATH_ACCURACY_EXACT)
+        return epUnaryOperatorApply(op, operand);
+    return epApproxUnary(epApproxGetTier(accuracy), op, operand);
+} // epUnaryOperatorApplyApprox
+
+double epBinaryOperatorApplyApprox( EpBinaryOperator op, double lhs, double rhs, EpMathAccuracy accuracy ) {
+    if (accuracy == EP_MATH_ACCURACY_EXACT || op != EP_BINARY_OPERATOR_POW)
+        return epBinaryOperatorApply(op, lhs, rhs);
+    return epApproxPow(epApproxGetTier(accuracy), lhs, rhs);
+} // epBinaryOperatorApplyApprox
+
+/**
+ * @brief unary operator approximation on array function
+ * 
+ * @param[in]  tier  tier kernels (expected to be compile-time constant after inlining)
+ * @param[in]  op    operator
+ * @param[in]  src   operands
+ * @param[out] dst   results destination
+ * @param[in]  count count of elements
+ */
+static EP_APPROX_INLINE void epApproxUnaryLoop( const EpApproxTier *tier, EpUnaryOperator op, const double *src, double *dst, size_t count ) {
+    // operator is dispatched out of loops, so kernels are inlined into plain element-wise loops
+    switch (op) {
+    case EP_UNARY_OPERATOR_LN  : for (size_t i = 0; i < count; i++) dst[i] = epApproxLn(tier, src[i]); break;
+    case EP_UNARY_OPERATOR_EXP : for (size_t i = 0; i < count; i++) dst[i] = epApproxExp(tier, src[i]); break;
+    case EP_UNARY_OPERATOR_ATAN: for (size_t i = 0; i < count; i++) dst[i] = epApproxAtan(tier, src[i]); break;
+    case EP_UNARY_OPERATOR_SIN : for (size_t i = 0; i < count; i++) dst[i] = epApproxTrig(tier, EP_UNARY_OPERATOR_SIN, src[i]); break;
+    case EP_UNARY_OPERATOR_COS : for (size_t i = 0; i < count; i++) dst[i] = epApproxTrig(tier, EP_UNARY_OPERATOR_COS, src[i]); break;
+    case EP_UNARY_OPERATOR_TAN : for (size_t i = 0; i < count; i++) dst[i] = epApproxTrig(tier, EP_UNARY_OPERATOR_TAN, src[i]); break;
+    case EP_UNARY_OPERATOR_COT : for (size_t i = 0; i < count; i++) dst[i] = epApproxTrig(tier, EP_UNARY_OPERATOR_COT, src[i]); break;
+    case EP_UNARY_OPERATOR_ASIN: for (size_t i = 0; i < count; i++) dst[i] = epApproxAsin(tier, src[i]); break;
+    case EP_UNARY_OPERATOR_ACOS: for (size_t i = 0; i < count; i++) dst[i] = epApproxAcos(tier, src[i]); break;
+    case EP_UNARY_OPERATOR_ACOT: for (size_t i = 0; i < count; i++) dst[i] = epApproxAcot(tier, src[i]); break;
+    default:
+        for (size_t i = 0; i < count; i++)
+            dst[i] = epApproxUnary(tier, op, src[i]);
+        break;
+    }
+} // epApproxUnaryLoop
+
+void epApproxUnaryApplyArray( EpUnaryOperator op, EpMathAccuracy accuracy, const double *src, double *dst, size_t count ) {
+    switch (accuracy) {
+    case EP_MATH_ACCURACY_EXACT:
+        for (size_t i = 0; i < count; i++)
+            dst[i] = epUnaryOperatorApply(op, src[i]);
+        return;
+
+    // tiers are passed as constants, so polynomial loops are unrolled in each instance
+    case EP_MATH_ACCURACY_APPROX12 : epApproxUnaryLoop(&EP_APPROX_TIER_12, op, src, dst, count); break;
+    case EP_MATH_ACCURACY_APPROX7  : epApproxUnaryLoop(&EP_APPROX_TIER_7 , op, src, dst, count); break;
+    }
+
+    // rare arguments reduction isn't accurate for are recomputed separately to keep main loops branch-free
+    if (op == EP_UNARY_OPERATOR_SIN || op == EP_UNARY_OPERATOR_COS || op == EP_UNARY_OPERATOR_TAN || op == EP_UNARY_OPERATOR_COT)
+        for (size_t i = 0; i < count; i++)
+            if (fabs(src[i]) > EP_APPROX_TRIG_MAX)
+                dst[i] = epUnaryOperatorApply(op, src[i]);
+} // epApproxUnaryApplyArray
+
+/**
+ * @brief sine and cosine approximation on array function
+ * 
+ * @param[in]  tier   tier kernels (expected to be compile-time constant after inlining)
+ * @param[in]  src    arguments
+ * @param[out] sinDst sines destination
+ * @param[out] cosDst cosines destination
+ * @param[in]  count  count of elements
+ */
+static EP_APPROX_INLINE void epApproxSinCosLoop( const EpApproxTier *tier, const double *src, double *sinDst, double *cosDst, size_t count ) {
+    for (size_t i = 0; i < count; i++) {
+        const EpApproxSinCosPair pair = epApproxSinCos(tier, src[i]);
+
+        sinDst[i] = pair.sin;
+        cosDst[i] = pair.cos;
+    }
+} // epApproxSinCosLoop
+
+void epApproxSinCosArray( EpMathAccuracy accuracy, const double *src, double *sinDst, double *cosDst, size_t count ) {
+    switch (accuracy) {
+    case EP_MATH_ACCURACY_EXACT:
+        for (size_t i = 0; i < count; i++) {
+            sinDst[i] = sin(src[i]);
+            cosDst[i] = cos(src[i]);
+        }
+        return;
+
+    case EP_MATH_ACCURACY_APPROX12 : epApproxSinCosLoop(&EP_APPROX_TIER_12, src, sinDst, cosDst, count); break;
+    case EP_MATH_ACCURACY_APPROX7  : epApproxSinCosLoop(&EP_APPROX_TIER_7 , src, sinDst, cosDst, count); break;
+    }
+
+    for (size_t i = 0; i < count; i++)
+        if (fabs(src[i]) > EP_APPROX_TRIG_MAX) {
+            sinDst[i] = sin(src[i]);
+            cosDst[i] = cos(src[i]);
+        }
+} // epApproxSinCosArray
+
+/**
+ * @brief raising to a power approximation on array function
+ * 
+ * @param[in]  tier  tier kernels (expected to be compile-time constant after inlining)
+ * @param[in]  lhs   bases
+ * @param[in]  rhs   exponents
+ * @param[out] dst   results destination
+ * @param[in]  count count of elements
+ */
+static EP_APPROX_INLINE void epApproxPowLoop( const EpApproxTier *tier, const double *lhs, const double *rhs, double *dst, size_t count ) {
+    for (size_t i = 0; i < count; i++)
+        dst[i] = epApproxExp(tier, rhs[i] * epApproxLn(tier, lhs[i]));
+} // epApproxPowLoop
+
+void epApproxPowArray( EpMathAccuracy accuracy, const double *lhs, const double *rhs, double *dst, size_t count ) {
+    switch (accuracy) {
+    case EP_MATH_ACCURACY_EXACT:
+        for (size_t i = 0; i < count; i++)
+            dst[i] = pow(lhs[i], rhs[i]);
+        return;
+
+    case EP_MATH_ACCURACY_APPROX12 : epApproxPowLoop(&EP_APPROX_TIER_12, lhs, rhs, dst, count); break;
+    case EP_MATH_ACCURACY_APPROX7  : epApproxPowLoop(&EP_APPROX_TIER_7 , lhs, rhs, dst, count); break;
+    }
+
+    // non-positive bases require exponent parity analysis, so they are left to libm
+    for (size_t i = 0; i < count; i++)
+        if (!(lhs[i] > 0.0))
+            dst[i] = pow(lhs[i], rhs[i]);
+} // epApproxPowArray
+
+double epMathAccuracyBound( EpMathAccuracy accuracy ) {
+    switch (accuracy) {
+    case EP_MATH_ACCURACY_EXACT    : return 0.0;
+    case EP_MATH_ACCURACY_APPROX12 : return 1e-12;
+    case EP_MATH_ACCURACY_APPROX7  : return 1e-7;
+    }
+
+    return 0.0;
+} // epMathAccuracyBound
+
+/**
+ * @brief relative error calculation function
+ * 
+ * @param[in] value     approximate value
+ * @param[in] reference reference value
+ * 
+ * @return relative error (absolute if reference is zero, 0 if both are same non-finite values)
+ */
+static double epApproxRelativeError( double value, double reference ) {
+    if (value == reference || (value != value && reference != reference))
+        return 0.0;
+    if (reference == 0.0)
+        return fabs(value);
+    return fabs(value - reference) / fabs(reference);
+} // epApproxRelativeError
+
+/**
+ * @brief check reference value calculation function
+ * 
+ * @param[in] op      operator
+ * @param[in] operand operand
+ * 
+ * @return libm based operator value
+ */
+static double epApproxCheckReference( EpUnaryOperator op, double operand ) {
+    // atan(-x) + pi / 2 loses digits to cancellation for large |x|, so it can't be used as reference
+    if (op == EP_UNARY_OPERATOR_ACOT)
+        return operand > 0.0 ? atan(1.0 / operand) : atan(1.0 / operand) + M_PI;
+    return epUnaryOperatorApply(op, operand);
+} // epApproxCheckReference
+
+/// @brief function check domain representation structure
+typedef struct __EpApproxCheckDomain {
+    EpUnaryOperator op;          ///< operator
+    double          min;         ///< domain minimum
+    double          max;         ///< domain maximum
+    bool            logarithmic; ///< true if points are distributed logarithmically (min > 0)
+} EpApproxCheckDomain;
+
+/// @brief count of points every function is checked at
+#define EP_APPROX_CHECK_POINT_COUNT ((size_t)100000)
+
+bool epMathApproxCheck( EpMathAccuracy accuracy, FILE *out ) {
+    static const EpApproxCheckDomain domains[] = {
+        { EP_UNARY_OPERATOR_LN  , 1e-300, 1e300, true  },
+        { EP_UNARY_OPERATOR_SIN , -1e3  , 1e3  , false },
+        { EP_UNARY_OPERATOR_COS , -1e3  , 1e3  , false },
+        { EP_UNARY_OPERATOR_TAN , -1e3  , 1e3  , false },
+        { EP_UNARY_OPERATOR_COT , -1e3  , 1e3  , false },
+        { EP_UNARY_OPERATOR_ASIN, -1.0  , 1.0  , false },
+        { EP_UNARY_OPERATOR_ACOS, -1.0  , 1.0  , false },
+        { EP_UNARY_OPERATOR_ATAN, -1e4  , 1e4  , false },
+        { EP_UNARY_OPERATOR_ACOT, -1e4  , 1e4  , false },
+        { EP_UNARY_OPERATOR_EXP , -700.0, 700.0, false },
+        { EP_UNARY_OPERATOR_SQRT, 0.0   , 1e10 , false },
+    };
+    const double bound = epMathAccuracyBound(accuracy);
+    bool passed = true;
+
+    // deterministic quasi-random points, so every run checks same set
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+
+    for (size_t d = 0; d < sizeof(domains) / sizeof(domains[0]); d++) {
+        const EpApproxCheckDomain *domain = &domains[d];
+        double maxError = 0.0;
+        double maxErrorPoint = 0.0;
+
+        for (size_t i = 0; i < EP_APPROX_CHECK_POINT_COUNT; i++) {
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+
+            const double t = (double)(state >> 11) / 9007199254740992.0; // [0, 1)
+            const double x = domain->logarithmic
+                ? exp(log(domain->min) + t * (log(domain->max) - log(domain->min)))
+                : domain->min + t * (domain->max - domain->min);
+            const double error = epApproxRelativeError(
+                epUnaryOperatorApplyApprox(domain->op, x, accuracy),
+                epApproxCheckReference(domain->op, x)
+            );
+
+            if (error > maxError) {
+                maxError = error;
+                maxErrorPoint = x;
+            }
+        }
+
+        if (out != NULL)
+            fprintf(out, "%-4s: max relative error %.3e at %.17g\n", epUnaryOperatorStr(domain->op), maxError, maxErrorPoint);
+        passed = passed && maxError <= bound;
+    }
+
+    // pow error grows with exponent, because ln(x) error is multiplied by it
+    {
+        double maxError = 0.0;
+
+        for (size_t i = 0; i < EP_APPROX_CHECK_POINT_COUNT; i++) {
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+            const double t = (double)(state >> 11) / 9007199254740992.0;
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+            const double s = (double)(state >> 11) / 9007199254740992.0;
+
+            const double base = exp(-7.0 + 14.0 * t);
+            const double exponent = -10.0 + 20.0 * s;
+            const double error = epApproxRelativeError(
+                epBinaryOperatorApplyApprox(EP_BINARY_OPERATOR_POW, base, exponent, accuracy),
+                pow(base, exponent)
+            ) / (1.0 + fabs(exponent));
+
+            maxError = fmax(maxError, error);
+        }
+
+        if (out != NULL)
+            fprintf(out, "pow : max relative error / (1 + |exponent|) %.3e\n", maxError);
+        passed = passed && maxError <= bound;
+    }
+
+    if (out != NULL)
+        fprintf(out, "%s (bound %.0e)\n", passed ? "passed" : "FAILED", bound);
+    return passed;
+} // epMathApproxCheck
+
+// ep_approx.c
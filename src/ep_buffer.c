@@ -0,0 +1,57 @@
+/**
+ * @brief growable byte buffer implementation file
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ep_internal.h"
+
+/// @brief initial buffer capacity
+#define EP_BUFFER_INITIAL_CAPACITY ((size_t)256)
+
+bool epBufferReserve( EpBuffer *buffer, size_t required ) {
+    assert(buffer != NULL);
+
+    // one byte is always left for terminating null
+    if (buffer->size + required < buffer->capacity)
+        return true;
+
+    size_t newCapacity = buffer->capacity == 0 ? EP_BUFFER_INITIAL_CAPACITY : buffer->capacity * 2;
+    while (newCapacity <= buffer->size + required)
+        newCapacity *= 2;
+
+    char *newData = (char *)realloc(buffer->data, newCapacity);
+
+    if (newData == NULL)
+        return false;
+
+    buffer->data = newData;
+    buffer->capacity = newCapacity;
+    return true;
+} // epBufferReserve
+
+bool epBufferAppend( EpBuffer *buffer, const char *data, size_t size ) {
+    assert(buffer != NULL);
+    assert(data != NULL || size == 0);
+
+    if (!epBufferReserve(buffer, size))
+        return false;
+
+    if (size != 0)
+        memcpy(buffer->data + buffer->size, data, size);
+    buffer->size += size;
+    buffer->data[buffer->size] = '\0';
+    return true;
+} // epBufferAppend
+
+void epBufferDtor( EpBuffer *buffer ) {
+    if (buffer == NULL)
+        return;
+
+    free(buffer->data);
+    *buffer = (EpBuffer) { .data = NULL, .size = 0, .capacity = 0 };
+} // epBufferDtor
+
+// ep_buffer.c
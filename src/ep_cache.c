@@ -0,0 +1,292 @@
+/**
+ * @brief transformation result (memoization) cache implementation file
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+
+#include "ep_internal.h"
+
+/// @brief invalid entry index (list and chain terminator)
+#define EP_TRANSFORM_CACHE_NONE ((uint32_t)UINT32_MAX)
+
+/// @brief cached transformation kind
+typedef enum __EpTransformCacheOperation {
+    EP_TRANSFORM_CACHE_OPTIMIZE,   ///< epNodeOptimize
+    EP_TRANSFORM_CACHE_DERIVATIVE, ///< epNodeDerivative
+} EpTransformCacheOperation;
+
+/// @brief cache entry representation structure
+typedef struct __EpTransformCacheEntry {
+    EpNode                    * key;        ///< transformed node copy
+    EpNode                    * value;      ///< transformation result
+    EpTransformCacheOperation   operation;  ///< transformation
+    EpSymbol                    variable;   ///< transformation variable (EP_SYMBOL_INVALID if not used)
+    uint32_t                    hash;       ///< key hash (node identity hash mixed with operation and variable)
+
+    uint32_t                    chainNext;  ///< next entry in bucket chain
+    uint32_t                    lruPrev;    ///< more recently used entry
+    uint32_t                    lruNext;    ///< less recently used entry
+} EpTransformCacheEntry;
+
+/// @brief transformation result cache representation structure
+struct __EpTransformCache {
+    EpTransformCacheEntry * entries;     ///< entry array
+    uint32_t              * buckets;     ///< bucket chain heads
+    size_t                  bucketMask;  ///< count of buckets - 1 (count of buckets is power of 2)
+
+    uint32_t                lruHead;     ///< most recently used entry
+    uint32_t                lruTail;     ///< least recently used entry
+
+    EpTransformCacheStats   stats;       ///< statistics (entryCount and capacity too)
+}; // struct __EpTransformCache
+
+EpTransformCache * epTransformCacheCtor( size_t capacity ) {
+    assert(capacity != 0);
+
+    if (capacity >= EP_TRANSFORM_CACHE_NONE)
+        return NULL;
+
+    size_t bucketCount = 1;
+    while (bucketCount < capacity * 2)
+        bucketCount *= 2;
+
+    EpTransformCache *cache = (EpTransformCache *)calloc(1, sizeof(EpTransformCache));
+
+    if (cache == NULL)
+        return NULL;
+
+    cache->entries = (EpTransformCacheEntry *)calloc(capacity, sizeof(EpTransformCacheEntry));
+    cache->buckets = (uint32_t *)malloc(bucketCount * sizeof(uint32_t));
+
+    if (cache->entries == NULL || cache->buckets == NULL) {
+        epTransformCacheDtor(cache);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < bucketCount; i++)
+        cache->buckets[i] = EP_TRANSFORM_CACHE_NONE;
+
+    cache->bucketMask = bucketCount - 1;
+    cache->lruHead = EP_TRANSFORM_CACHE_NONE;
+    cache->lruTail = EP_TRANSFORM_CACHE_NONE;
+    cache->stats.capacity = capacity;
+
+    return cache;
+} // epTransformCacheCtor
+
+void epTransformCacheDtor( EpTransformCache *cache ) {
+    if (cache == NULL)
+        return;
+
+    if (cache->entries != NULL)
+        for (size_t i = 0; i < cache->stats.entryCount; i++) {
+            epNodeDtor(cache->entries[i].key);
+            epNodeDtor(cache->entries[i].value);
+        }
+
+    free(cache->entries);
+    free(cache->buckets);
+    free(cache);
+} // epTransformCacheDtor
+
+EpTransformCacheStats epTransformCacheGetStats( const EpTransformCache *cache ) {
+    assert(cache != NULL);
+
+    return cache->stats;
+} // epTransformCacheGetStats
+
+/**
+ * @brief entry from LRU list unlinking function
+ * 
+ * @param[in,out] cache cache (non-null)
+ * @param[in]     index entry index
+ */
+static void epTransformCacheLruUnlink( EpTransformCache *cache, uint32_t index ) {
+    EpTransformCacheEntry *entry = &cache->entries[index];
+
+    if (entry->lruPrev != EP_TRANSFORM_CACHE_NONE)
+        cache->entries[entry->lruPrev].lruNext = entry->lruNext;
+    else
+        cache->lruHead = entry->lruNext;
+
+    if (entry->lruNext != EP_TRANSFORM_CACHE_NONE)
+        cache->entries[entry->lruNext].lruPrev = entry->lruPrev;
+    else
+        cache->lruTail = entry->lruPrev;
+} // epTransformCacheLruUnlink
+
+/**
+ * @brief entry to LRU list head linking function
+ * 
+ * @param[in,out] cache cache (non-null)
+ * @param[in]     index entry index (entry must be unlinked)
+ */
+static void epTransformCacheLruPushFront( EpTransformCache *cache, uint32_t index ) {
+    EpTransformCacheEntry *entry = &cache->entries[index];
+
+    entry->lruPrev = EP_TRANSFORM_CACHE_NONE;
+    entry->lruNext = cache->lruHead;
+
+    if (cache->lruHead != EP_TRANSFORM_CACHE_NONE)
+        cache->entries[cache->lruHead].lruPrev = index;
+    else
+        cache->lruTail = index;
+    cache->lruHead = index;
+} // epTransformCacheLruPushFront
+
+/**
+ * @brief entry lookup function
+ * 
+ * @param[in,out] cache     cache (non-null)
+ * @param[in]     node      transformed node (non-null)
+ * @param[in]     operation transformation
+ * @param[in]     variable  transformation variable
+ * @param[in]     hash      entry hash
+ * 
+ * @return found entry index (EP_TRANSFORM_CACHE_NONE if there is no such entry)
+ */
+static uint32_t epTransformCacheFind(
+    const EpTransformCache    * cache,
+    const EpNode              * node,
+    EpTransformCacheOperation   operation,
+    EpSymbol                    variable,
+    uint32_t                    hash
+) {
+    for (uint32_t index = cache->buckets[hash & cache->bucketMask]; index != EP_TRANSFORM_CACHE_NONE; index = cache->entries[index].chainNext) {
+        const EpTransformCacheEntry *entry = &cache->entries[index];
+
+        if (true
+            && entry->hash == hash
+            && entry->operation == operation
+            && entry->variable == variable
+            && epNodeIsIdentical(entry->key, node)
+        )
+            return index;
+    }
+
+    return EP_TRANSFORM_CACHE_NONE;
+} // epTransformCacheFind
+
+/**
+ * @brief least recently used entry eviction function
+ * 
+ * @param[in,out] cache cache (non-null, non-empty)
+ * 
+ * @return index of freed entry
+ */
+static uint32_t epTransformCacheEvict( EpTransformCache *cache ) {
+    const uint32_t index = cache->lruTail;
+    EpTransformCacheEntry *entry = &cache->entries[index];
+    uint32_t *link = &cache->buckets[entry->hash & cache->bucketMask];
+
+    while (*link != index)
+        link = &cache->entries[*link].chainNext;
+    *link = entry->chainNext;
+
+    epTransformCacheLruUnlink(cache, index);
+
+    epNodeDtor(entry->key);
+    epNodeDtor(entry->value);
+    entry->key = NULL;
+    entry->value = NULL;
+
+    cache->stats.evictionCount++;
+    return index;
+} // epTransformCacheEvict
+
+/**
+ * @brief cached transformation function
+ * 
+ * @param[in,out] cache     cache (non-null)
+ * @param[in]     node      node to transform (non-null)
+ * @param[in]     operation transformation
+ * @param[in]     var       transformation variable name (null if not used)
+ * 
+ * @return transformation result copy (null if allocation failed)
+ */
+static EpNode * epTransformCacheApply(
+    EpTransformCache          * cache,
+    const EpNode              * node,
+    EpTransformCacheOperation   operation,
+    const char                * var
+) {
+    // every name that is not interned resolves to EP_SYMBOL_INVALID and shares results
+    const EpSymbol variable = var != NULL
+        ? epSymbolFind(var)
+        : EP_SYMBOL_INVALID;
+    uint32_t nodeHash;
+
+    // results are reused only for bit-identical nodes, so cached transformation is exactly uncached one
+    if (!epNodeIdentityHash(node, &nodeHash))
+        return operation == EP_TRANSFORM_CACHE_OPTIMIZE
+            ? epNodeOptimize(node)
+            : epNodeDerivative(node, var);
+
+    const uint32_t hash = nodeHash ^ ((uint32_t)operation * 0x9E3779B9u) ^ (variable * 0x85EBCA6Bu);
+    uint32_t index = epTransformCacheFind(cache, node, operation, variable, hash);
+
+    if (index != EP_TRANSFORM_CACHE_NONE) {
+        cache->stats.hitCount++;
+
+        epTransformCacheLruUnlink(cache, index);
+        epTransformCacheLruPushFront(cache, index);
+        return epNodeCopy(cache->entries[index].value);
+    }
+
+    cache->stats.missCount++;
+
+    EpNode *result = operation == EP_TRANSFORM_CACHE_OPTIMIZE
+        ? epNodeOptimize(node)
+        : epNodeDerivative(node, var);
+
+    if (result == NULL)
+        return NULL;
+
+    EpNode *key = epNodeCopy(node);
+    EpNode *value = epNodeCopy(result);
+
+    // result is still valid even if it can't be cached
+    if (key == NULL || value == NULL) {
+        epNodeDtor(key);
+        epNodeDtor(value);
+        return result;
+    }
+
+    if (cache->stats.entryCount < cache->stats.capacity)
+        index = (uint32_t)cache->stats.entryCount++;
+    else
+        index = epTransformCacheEvict(cache);
+
+    EpTransformCacheEntry *entry = &cache->entries[index];
+    uint32_t *bucket = &cache->buckets[hash & cache->bucketMask];
+
+    entry->key = key;
+    entry->value = value;
+    entry->operation = operation;
+    entry->variable = variable;
+    entry->hash = hash;
+    entry->chainNext = *bucket;
+    *bucket = index;
+
+    epTransformCacheLruPushFront(cache, index);
+    return result;
+} // epTransformCacheApply
+
+EpNode * epNodeOptimizeCached( EpTransformCache *cache, const EpNode *node ) {
+    if (cache == NULL || node == NULL)
+        return epNodeOptimize(node);
+
+    return epTransformCacheApply(cache, node, EP_TRANSFORM_CACHE_OPTIMIZE, NULL);
+} // epNodeOptimizeCached
+
+EpNode * epNodeDerivativeCached( EpTransformCache *cache, const EpNode *node, const char *var ) {
+    assert(var != NULL);
+
+    if (cache == NULL || node == NULL)
+        return epNodeDerivative(node, var);
+
+    return epTransformCacheApply(cache, node, EP_TRANSFORM_CACHE_DERIVATIVE, var);
+} // epNodeDerivativeCached
+
+// ep_cache.c
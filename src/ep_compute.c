@@ -4,69 +4,140 @@
 
 #include <assert.h>
 #include <math.h>
-#include <string.h>
+#include <stdlib.h>
 
-#include "ep.h"
+#include "ep_internal.h"
 
-EpNodeComputeResult epNodeCompute(
+/**
+ * @brief node value by resolved variable symbols computation function
+ * 
+ * @param[in] node          node to compute value of (non-null)
+ * @param[in] symbols       variable symbols (non-null if variableCount != 0)
+ * @param[in] variables     variables (non-null if variableCount != 0)
+ * @param[in] variableCount count of variables
+ * 
+ * @return computation result
+ * 
+ * @note node is computed with explicit stack of operator nodes that wait for operands, so depth is limited only by heap size
+ */
+static EpNodeComputeResult epNodeComputeSymbols(
     const EpNode     * node,
+    const EpSymbol   * symbols,
     const EpVariable * variables,
     size_t             variableCount
 ) {
-    assert(node != NULL);
-    assert(variableCount == 0 || variableCount != 0 && variables != NULL);
-
-    switch (node->type) {
-    case EP_NODE_VARIABLE: {
-        // try to find corresponding variable in table
-        for (size_t i = 0; i < variableCount; i++)
-            if (strcmp(node->variable, variables[i].name) == 0)
-                return (EpNodeComputeResult) {
-                    .status = EP_NODE_COMPUTE_OK,
-                    .ok = variables[i].value,
+    // operator nodes whose operands are being computed
+    const EpNode *localFrames[EP_LOCAL_STACK_SIZE];
+    const EpNode **frames = localFrames;
+    size_t frameCount = 0;
+    size_t frameCapacity = EP_LOCAL_STACK_SIZE;
+
+    // computed left hand sides of binary operators whose right hand side is being computed
+    double localValues[EP_LOCAL_STACK_SIZE];
+    double *values = localValues;
+    size_t valueCount = 0;
+    size_t valueCapacity = EP_LOCAL_STACK_SIZE;
+
+    EpNodeComputeResult result = { .status = EP_NODE_COMPUTE_OK, .ok = 0.0 };
+    double value = 0.0;
+
+    for (;;) {
+        // descend by left spine
+        while (node->type == EP_NODE_BINARY_OPERATOR || node->type == EP_NODE_UNARY_OPERATOR) {
+            if (frameCount + 1 > frameCapacity && !epStackReserve((void **)&frames, &frameCapacity, frameCount + 1, sizeof(const EpNode *), localFrames)) {
+                result = (EpNodeComputeResult) { .status = EP_NODE_COMPUTE_INTERNAL_ERROR, .unknownVariable = NULL };
+                goto __epNodeComputeSymbols__end;
+            }
+
+            frames[frameCount++] = node;
+            node = node->type == EP_NODE_BINARY_OPERATOR
+                ? node->binaryOperator.lhs
+                : node->unaryOperator.operand;
+        }
+
+        if (node->type == EP_NODE_CONSTANT) {
+            value = node->constant;
+        } else {
+            // try to find corresponding variable in table
+            size_t i = 0;
+
+            while (i < variableCount && node->variable != symbols[i])
+                i++;
+
+            if (i == variableCount) {
+                result = (EpNodeComputeResult) {
+                    .status = EP_NODE_COMPUTE_UNKNOWN_VARIABLE,
+                    .unknownVariable = epSymbolName(node->variable)
                 };
-        
-        return (EpNodeComputeResult) {
-            .status = EP_NODE_COMPUTE_UNKNOWN_VARIABLE,
-            .unknownVariable = node->variable
-        };
-    }
+                goto __epNodeComputeSymbols__end;
+            }
 
-    case EP_NODE_CONSTANT:
-        return (EpNodeComputeResult) {
-            .status = EP_NODE_COMPUTE_OK,
-            .ok = node->constant,
-        };
-
-    case EP_NODE_BINARY_OPERATOR: {
-        EpNodeComputeResult lResult = epNodeCompute(node->binaryOperator.lhs, variables, variableCount);
-        if (lResult.status != EP_NODE_COMPUTE_OK)
-            return lResult;
-
-        EpNodeComputeResult rResult = epNodeCompute(node->binaryOperator.rhs, variables, variableCount);
-        if (rResult.status != EP_NODE_COMPUTE_OK)
-            return rResult;
-
-        return (EpNodeComputeResult) {
-            .status = EP_NODE_COMPUTE_OK,
-            .ok = epBinaryOperatorApply(
-                node->binaryOperator.op,
-                lResult.ok,
-                rResult.ok
-            ),
-        };
-    }
-    case EP_NODE_UNARY_OPERATOR: {
-        EpNodeComputeResult operandResult = epNodeCompute(node->unaryOperator.operand, variables, variableCount);
-        if (operandResult.status != EP_NODE_COMPUTE_OK)
-            return operandResult;
-
-        return (EpNodeComputeResult) {
-            .status = EP_NODE_COMPUTE_OK,
-            .ok = epUnaryOperatorApply(node->unaryOperator.op, operandResult.ok),
-        };
-    }
+            value = variables[i].value;
+        }
+
+        // ascend while operands of top operator are computed
+        for (;;) {
+            if (frameCount == 0) {
+                result.ok = value;
+                goto __epNodeComputeSymbols__end;
+            }
+
+            const EpNode *top = frames[frameCount - 1];
+
+            if (top->type == EP_NODE_UNARY_OPERATOR) {
+                value = epUnaryOperatorApply(top->unaryOperator.op, value);
+                node = top;
+                frameCount--;
+                continue;
+            }
+
+            // node is last computed subtree, so value is right hand side and left hand side is on value stack
+            if (node == top->binaryOperator.rhs) {
+                value = epBinaryOperatorApply(top->binaryOperator.op, values[--valueCount], value);
+                node = top;
+                frameCount--;
+                continue;
+            }
+
+            if (valueCount + 1 > valueCapacity && !epStackReserve((void **)&values, &valueCapacity, valueCount + 1, sizeof(double), localValues)) {
+                result = (EpNodeComputeResult) { .status = EP_NODE_COMPUTE_INTERNAL_ERROR, .unknownVariable = NULL };
+                goto __epNodeComputeSymbols__end;
+            }
+
+            values[valueCount++] = value;
+            node = top->binaryOperator.rhs;
+            break;
+        }
     }
+
+__epNodeComputeSymbols__end:
+    if (frames != localFrames)
+        free(frames);
+    if (values != localValues)
+        free(values);
+    return result;
+} // epNodeComputeSymbols
+
+EpNodeComputeResult epNodeCompute(
+    const EpNode     * node,
+    const EpVariable * variables,
+    size_t             variableCount
+) {
+    assert(node != NULL);
+    assert(variableCount == 0 || (variableCount != 0 && variables != NULL));
+
+    EpSymbol localSymbols[EP_LOCAL_SYMBOL_COUNT];
+    EpSymbol *symbols = epSymbolsResolve(variables, variableCount, sizeof(EpVariable), localSymbols);
+
+    if (symbols == NULL)
+        return (EpNodeComputeResult) { .status = EP_NODE_COMPUTE_INTERNAL_ERROR, .unknownVariable = NULL };
+
+    EP_STATS_PHASE_BEGIN(EP_STATS_PHASE_COMPUTE);
+    EpNodeComputeResult result = epNodeComputeSymbols(node, symbols, variables, variableCount);
+    EP_STATS_PHASE_END(EP_STATS_PHASE_COMPUTE);
+
+    epSymbolsRelease(symbols, localSymbols);
+    return result;
 } // epNodeCompute
 
 // ep_compute.c
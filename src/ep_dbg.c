@@ -17,12 +17,16 @@ static void epDbgNodeDumpDotImpl( FILE *out, const EpNode *node ) {
 
     switch (node->type) {
     case EP_NODE_VARIABLE:
-        fprintf(out, "|<var>variable name: \\\"%s\\\"", node->variable);
+        fprintf(out, "|<var>variable name: \\\"%s\\\"", epSymbolName(node->variable));
         break;
 
-    case EP_NODE_CONSTANT:
-        fprintf(out, "|<const>constant: %lf", node->constant);
+    case EP_NODE_CONSTANT: {
+        char constant[EP_DOUBLE_FORMAT_SIZE];
+
+        epDoubleFormat(node->constant, constant);
+        fprintf(out, "|<const>constant: %s", constant);
         break;
+    }
 
     case EP_NODE_BINARY_OPERATOR:
         fprintf(out, "|<op>binary operator: \\\"%s\\\"", epBinaryOperatorStr(node->binaryOperator.op));
@@ -2,27 +2,25 @@
  * @brief derivative calculator implementation file
  */
 
-#include <string.h>
 #include <assert.h>
 
 #define _EP_NODE_SHORT_OPERATORS
-#include "ep.h"
+#include "ep_internal.h"
 
 /**
  * @brief is this node constant for differentiation checking function
  * 
  * @param[in] node node to check
- * @param[in] var  variable
+ * @param[in] var  variable symbol
  * 
  * @return true if node is constant, false if not
  */
-static bool epNodeDerivativeIsConstant( const EpNode *node, const char *var ) {
+static bool epNodeDerivativeIsConstant( const EpNode *node, EpSymbol var ) {
     assert(node != NULL);
-    assert(var != NULL);
 
     switch (node->type) {
     case EP_NODE_VARIABLE:
-        return strcmp(node->variable, var) != 0;
+        return node->variable != var;
 
     case EP_NODE_CONSTANT:
         return true;
@@ -38,16 +36,22 @@ static bool epNodeDerivativeIsConstant( const EpNode *node, const char *var ) {
     }
 } // epNodeDerivativeIsConstant
 
-EpNode * epNodeDerivative( const EpNode *node, const char *var ) {
-    assert(var != NULL);
-
+/**
+ * @brief derivative by symbol calculation function
+ * 
+ * @param[in] node node to differentiate (nullable)
+ * @param[in] var  symbol of variable to differentiate by
+ * 
+ * @return derivative (null if allocation failed)
+ */
+static EpNode * epNodeDerivativeSymbol( const EpNode *node, EpSymbol var ) {
     if (node == NULL)
         return NULL;
 
     switch (node->type) {
     case EP_NODE_VARIABLE:
         return epNodeConstant(
-            strcmp(node->variable, var) == 0
+            node->variable == var
                 ? 1.0
                 : 0.0
         );
@@ -62,40 +66,55 @@ EpNode * epNodeDerivative( const EpNode *node, const char *var ) {
         switch (node->binaryOperator.op) {
         case EP_BINARY_OPERATOR_ADD:
             return EP_ADD(
-                epNodeDerivative(lhs, var),
-                epNodeDerivative(rhs, var)
+                epNodeDerivativeSymbol(lhs, var),
+                epNodeDerivativeSymbol(rhs, var)
             );
 
         case EP_BINARY_OPERATOR_SUB:
             return EP_SUB(
-                epNodeDerivative(lhs, var),
-                epNodeDerivative(rhs, var)
+                epNodeDerivativeSymbol(lhs, var),
+                epNodeDerivativeSymbol(rhs, var)
             );
 
         case EP_BINARY_OPERATOR_MUL: {
             if (epNodeDerivativeIsConstant(lhs, var))
-                return EP_MUL(epNodeCopy(lhs), epNodeDerivative(rhs, var));
+                return EP_MUL(epNodeCopy(lhs), epNodeDerivativeSymbol(rhs, var));
             else if (epNodeDerivativeIsConstant(rhs, var))
-                return EP_MUL(epNodeCopy(rhs), epNodeDerivative(lhs, var));
+                return EP_MUL(epNodeCopy(rhs), epNodeDerivativeSymbol(lhs, var));
             else
                 return EP_ADD(
-                    EP_MUL(epNodeCopy(lhs), epNodeDerivative(rhs, var)),
-                    EP_MUL(epNodeCopy(rhs), epNodeDerivative(lhs, var))
+                    EP_MUL(epNodeCopy(lhs), epNodeDerivativeSymbol(rhs, var)),
+                    EP_MUL(epNodeCopy(rhs), epNodeDerivativeSymbol(lhs, var))
                 );
         }
 
         case EP_BINARY_OPERATOR_DIV:
             if (epNodeDerivativeIsConstant(rhs, var))
-                return EP_DIV(epNodeDerivative(lhs, var), epNodeCopy(rhs));
+                return EP_DIV(epNodeDerivativeSymbol(lhs, var), epNodeCopy(rhs));
             else
                 return EP_DIV(
                     EP_SUB(
-                        EP_MUL(epNodeDerivative(lhs, var), epNodeCopy(rhs)),
-                        EP_MUL(epNodeDerivative(rhs, var), epNodeCopy(lhs))
+                        EP_MUL(epNodeDerivativeSymbol(lhs, var), epNodeCopy(rhs)),
+                        EP_MUL(epNodeDerivativeSymbol(rhs, var), epNodeCopy(lhs))
                     ),
                     EP_MUL(epNodeCopy(rhs), epNodeCopy(rhs))
                 );
 
+        case EP_BINARY_OPERATOR_POWI:
+            if (rhs->type == EP_NODE_CONSTANT)
+                return EP_MUL(
+                    EP_MUL(
+                        epNodeCopy(rhs),
+                        epNodeDerivativeSymbol(lhs, var)
+                    ),
+                    EP_POWI(
+                        epNodeCopy(lhs),
+                        EP_CONST(rhs->constant - 1.0)
+                    )
+                );
+            // exponent is not a constant node, so it is differentiated as generic power
+            // fall through
+
         case EP_BINARY_OPERATOR_POW: {
             bool lConst = epNodeDerivativeIsConstant(lhs, var);
             bool rConst = epNodeDerivativeIsConstant(rhs, var);
@@ -104,9 +123,9 @@ EpNode * epNodeDerivative( const EpNode *node, const char *var ) {
                 return EP_MUL(
                     EP_POW(epNodeCopy(lhs), epNodeCopy(rhs)),
                     EP_ADD(
-                        EP_MUL(epNodeDerivative(rhs, var), EP_LN(epNodeCopy(lhs))),
+                        EP_MUL(epNodeDerivativeSymbol(rhs, var), EP_LN(epNodeCopy(lhs))),
                         EP_MUL(
-                            EP_DIV(epNodeDerivative(lhs, var), epNodeCopy(lhs)),
+                            EP_DIV(epNodeDerivativeSymbol(lhs, var), epNodeCopy(lhs)),
                             epNodeCopy(rhs)
                         )
                     )
@@ -115,7 +134,7 @@ EpNode * epNodeDerivative( const EpNode *node, const char *var ) {
             if (lConst && !rConst)
                 return EP_MUL(
                     EP_MUL(
-                        epNodeDerivative(rhs, var),
+                        epNodeDerivativeSymbol(rhs, var),
                         EP_LN(epNodeCopy(lhs))
                     ),
                     EP_POW(
@@ -128,7 +147,7 @@ EpNode * epNodeDerivative( const EpNode *node, const char *var ) {
                 return EP_MUL(
                     EP_MUL(
                         epNodeCopy(rhs),
-                        epNodeDerivative(lhs, var)
+                        epNodeDerivativeSymbol(lhs, var)
                     ),
                     EP_POW(
                         epNodeCopy(lhs),
@@ -137,7 +156,7 @@ EpNode * epNodeDerivative( const EpNode *node, const char *var ) {
                 );
 
             if (lConst && rConst)
-                return EP_POW(epNodeCopy(lhs), epNodeCopy(rhs));
+                return EP_CONST(0.0);
 
             assert(false &&
                 "All combinations of (bool, bool) pairs was checked in code above. "
@@ -151,7 +170,7 @@ EpNode * epNodeDerivative( const EpNode *node, const char *var ) {
 
     case EP_NODE_UNARY_OPERATOR: {
         const EpNode *operand = node->unaryOperator.operand;
-        EpNode *derivative = epNodeDerivative(operand, var);
+        EpNode *derivative = epNodeDerivativeSymbol(operand, var);
 
         switch (node->unaryOperator.op) {
         case EP_UNARY_OPERATOR_NEG:
@@ -167,27 +186,21 @@ EpNode * epNodeDerivative( const EpNode *node, const char *var ) {
             return EP_MUL(derivative, EP_NEG(EP_SIN(epNodeCopy(operand))));
 
         case EP_UNARY_OPERATOR_TAN:
-            return EP_DIV(derivative, EP_POW(EP_COS(epNodeCopy(operand)), EP_CONST(2.0)));
+            return EP_DIV(derivative, EP_POWI(EP_COS(epNodeCopy(operand)), EP_CONST(2.0)));
 
         case EP_UNARY_OPERATOR_COT:
-            return EP_DIV(EP_NEG(derivative), EP_POW(EP_SIN(epNodeCopy(operand)), EP_CONST(2.0)));
+            return EP_DIV(EP_NEG(derivative), EP_POWI(EP_SIN(epNodeCopy(operand)), EP_CONST(2.0)));
 
         case EP_UNARY_OPERATOR_ASIN:
             return EP_DIV(
                 derivative,
-                EP_POW(
-                    EP_SUB(EP_CONST(1.0), EP_POW(epNodeCopy(operand), EP_CONST(2.0))),
-                    EP_CONST(0.5)
-                )
+                EP_SQRT(EP_SUB(EP_CONST(1.0), EP_POWI(epNodeCopy(operand), EP_CONST(2.0))))
             );
 
         case EP_UNARY_OPERATOR_ACOS:
             return EP_DIV(
                 EP_NEG(derivative),
-                EP_POW(
-                    EP_SUB(EP_CONST(1.0), EP_POW(epNodeCopy(operand), EP_CONST(2.0))),
-                    EP_CONST(0.5)
-                )
+                EP_SQRT(EP_SUB(EP_CONST(1.0), EP_POWI(epNodeCopy(operand), EP_CONST(2.0))))
             );
 
         case EP_UNARY_OPERATOR_ATAN:
@@ -195,7 +208,7 @@ EpNode * epNodeDerivative( const EpNode *node, const char *var ) {
                 derivative,
                 EP_ADD(
                     EP_CONST(1.0),
-                    EP_POW(epNodeCopy(operand), EP_CONST(2.0))
+                    EP_POWI(epNodeCopy(operand), EP_CONST(2.0))
                 )
             );
 
@@ -204,14 +217,34 @@ EpNode * epNodeDerivative( const EpNode *node, const char *var ) {
                 EP_NEG(derivative),
                 EP_ADD(
                     EP_CONST(1.0),
-                    EP_POW(epNodeCopy(operand), EP_CONST(2.0))
+                    EP_POWI(epNodeCopy(operand), EP_CONST(2.0))
                 )
             );
+
+        case EP_UNARY_OPERATOR_EXP:
+            return EP_MUL(derivative, EP_EXP(epNodeCopy(operand)));
+
+        case EP_UNARY_OPERATOR_SQRT:
+            return EP_DIV(derivative, EP_MUL(EP_CONST(2.0), EP_SQRT(epNodeCopy(operand))));
         }
     }
     }
 
     // panic here?
+} // epNodeDerivativeSymbol
+
+EpNode * epNodeDerivative( const EpNode *node, const char *var ) {
+    assert(var != NULL);
+
+    EP_STATS_PHASE_BEGIN(EP_STATS_PHASE_DERIVATIVE);
+    epTraceBegin("derivative", NULL, 0, node);
+
+    // EP_SYMBOL_INVALID matches no variable node, so every subtree is constant
+    EpNode *result = epNodeDerivativeSymbol(node, epSymbolFind(var));
+
+    epTraceEnd("derivative", result);
+    EP_STATS_PHASE_END(EP_STATS_PHASE_DERIVATIVE);
+    return result;
 } // epNodeDerivative
 
 // ep_derivative.c
@@ -3,42 +3,278 @@
  */
 
 #include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
 
-#include "ep.h"
+#include "ep_internal.h"
+
+/// @brief size of chunk dump to file is written by
+#define EP_DUMP_CHUNK_SIZE ((size_t)16384)
+
+/// @brief maximal count of parts single node is split to
+#define EP_DUMP_MAX_PARTS ((size_t)8)
+
+/// @brief empty shared subtree class table slot
+#define EP_DUMP_SHARE_EMPTY ((uint32_t)UINT32_MAX)
+
+/// @brief maximal length of temporary name prefix
+#define EP_DUMP_SHARE_MAX_PREFIX ((size_t)16)
+
+/// @brief distinct subtree (shared subtree class) representation structure
+typedef struct __EpDumpShareClass {
+    EpNodeType type;     ///< subtree root type
+    uint32_t   op;       ///< subtree root operator (0 for leaves)
+    uint64_t   value;    ///< constant bits, variable symbol or (left hand side) operand class index
+    uint32_t   rhs;      ///< right hand side class index (binary operators only)
+    uint32_t   hash;     ///< class key hash
+    uint32_t   useCount; ///< count of distinct parent classes (and dumped root) that reference class
+    uint32_t   name;     ///< temporary index (0 if class is written inline)
+} EpDumpShareClass;
+
+/// @brief sharing-aware dump context representation structure
+typedef struct __EpDumpShare {
+    EpDumpShareClass * classes;       ///< distinct subtrees in post-order (operands go before operators)
+    size_t             classCount;    ///< count of classes
+    size_t             classCapacity; ///< class array capacity
+
+    uint32_t         * slots;         ///< class hash table (open addressing, class indices)
+    size_t             slotCount;     ///< count of slots (power of 2)
+
+    EpNode           * nodes;         ///< canonical nodes (operands point to canonical nodes of operand classes)
+    uint32_t           nameCount;     ///< count of named classes
+
+    char               prefix[EP_DUMP_SHARE_MAX_PREFIX]; ///< temporary name prefix (doesn't clash with variables)
+    size_t             prefixLength;                     ///< prefix length
+} EpDumpShare;
+
+/// @brief dump writer representation structure
+typedef struct __EpDumpWriter {
+    EpBuffer          * buffer; ///< buffer dump is written to
+    FILE              * out;    ///< file buffer is flushed to when full (NULL if dump is kept in buffer)
+    bool                failed; ///< buffer allocation failed
+    const EpDumpShare * share;  ///< sharing context (NULL if node is dumped as tree)
+} EpDumpWriter;
+
+/// @brief dump stack item (node or text part of already expanded node) representation structure
+typedef struct __EpDumpItem {
+    const EpNode * node; ///< node to dump (NULL if item is text)
+    const char   * text; ///< text to write (valid if node is NULL)
+} EpDumpItem;
+
+/// @brief text dump item
+#define EP_DUMP_TEXT(str) ((EpDumpItem) { .node = NULL, .text = (str) })
+
+/// @brief node dump item
+#define EP_DUMP_NODE(n) ((EpDumpItem) { .node = (n), .text = NULL })
+
+/**
+ * @brief text writing function
+ * 
+ * @param[in,out] writer writer (non-null)
+ * @param[in]     text   text to write
+ * @param[in]     length text length
+ */
+static void epDumpWrite( EpDumpWriter *writer, const char *text, size_t length ) {
+    EpBuffer *buffer = writer->buffer;
+
+    if (buffer->size + length >= buffer->capacity) {
+        if (writer->out != NULL) {
+            fwrite(buffer->data, 1, buffer->size, writer->out);
+            buffer->size = 0;
+
+            // text that doesn't fit into chunk is written directly
+            if (length >= buffer->capacity) {
+                fwrite(text, 1, length, writer->out);
+                return;
+            }
+        } else if (writer->failed || !epBufferReserve(buffer, length)) {
+            writer->failed = true;
+            return;
+        }
+    }
+
+    memcpy(buffer->data + buffer->size, text, length);
+    buffer->size += length;
+} // epDumpWrite
+
+/**
+ * @brief null-terminated string writing function
+ * 
+ * @param[in,out] writer writer (non-null)
+ * @param[in]     str    string to write (non-null)
+ */
+static void epDumpWriteString( EpDumpWriter *writer, const char *str ) {
+    epDumpWrite(writer, str, strlen(str));
+} // epDumpWriteString
+
+/**
+ * @brief unsigned integer in decimal writing function
+ * 
+ * @param[in,out] writer writer (non-null)
+ * @param[in]     value  value to write
+ */
+static void epDumpWriteUnsigned( EpDumpWriter *writer, uint32_t value ) {
+    char text[16];
+    size_t position = sizeof(text);
+
+    do {
+        text[--position] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+
+    epDumpWrite(writer, text + position, sizeof(text) - position);
+} // epDumpWriteUnsigned
+
+/**
+ * @brief constant in infix format writing function
+ * 
+ * @param[in,out] writer writer (non-null)
+ * @param[in]     value  value to write
+ * 
+ * @note shortest round-trip form is used, so constants are parsed back exactly.
+ * Non-finite values are written as divisions by zero, as 'inf' and 'nan' would be parsed back as variables.
+ */
+static void epDumpWriteDouble( EpDumpWriter *writer, double value ) {
+    if (!isfinite(value)) {
+        epDumpWriteString(writer, isnan(value) ? "(0 / 0)" : signbit(value) ? "(-1 / 0)" : "(1 / 0)");
+        return;
+    }
+
+    char text[EP_DOUBLE_FORMAT_SIZE];
+
+    epDumpWrite(writer, text, epDoubleFormat(value, text));
+} // epDumpWriteDouble
+
+/**
+ * @brief constant in TeX format writing function
+ * 
+ * @param[in,out] writer writer (non-null)
+ * @param[in]     value  value to write
+ * 
+ * @note exponential form is written as mantissa multiplied by power of ten
+ */
+static void epDumpWriteTexDouble( EpDumpWriter *writer, double value ) {
+    char text[EP_DOUBLE_FORMAT_SIZE];
+    const size_t length = epDoubleFormat(value, text);
+    const char *exponent = (const char *)memchr(text, 'e', length);
+
+    if (exponent == NULL) {
+        epDumpWrite(writer, text, length);
+        return;
+    }
+
+    // mantissa 1 is omitted
+    if ((exponent - text == 1 && text[0] == '1') || (exponent - text == 2 && text[0] == '-' && text[1] == '1')) {
+        epDumpWrite(writer, text, (size_t)(exponent - text) - 1);
+    } else {
+        epDumpWrite(writer, text, (size_t)(exponent - text));
+        epDumpWrite(writer, "\\cdot", 5);
+    }
+
+    epDumpWrite(writer, "10^{", 4);
+    epDumpWrite(writer, exponent + 1, length - (size_t)(exponent + 1 - text));
+    epDumpWrite(writer, "}", 1);
+} // epDumpWriteTexDouble
+
+/**
+ * @brief node temporary index getting function
+ * 
+ * @param[in] writer writer (non-null)
+ * @param[in] node   node (non-null)
+ * 
+ * @return temporary index (0 if node is written inline)
+ */
+static uint32_t epDumpNodeName( const EpDumpWriter *writer, const EpNode *node ) {
+    const EpDumpShare *share = writer->share;
+
+    return share != NULL
+        ? share->classes[node - share->nodes].name
+        : 0;
+} // epDumpNodeName
+
+/**
+ * @brief temporary name writing function
+ * 
+ * @param[in,out] writer writer (non-null, sharing context is set)
+ * @param[in]     name   temporary index
+ * @param[in]     isTex  true if name is written in TeX format
+ */
+static void epDumpWriteName( EpDumpWriter *writer, uint32_t name, bool isTex ) {
+    epDumpWrite(writer, writer->share->prefix, writer->share->prefixLength);
+    if (isTex)
+        epDumpWrite(writer, "_{", 2);
+    epDumpWriteUnsigned(writer, name);
+    if (isTex)
+        epDumpWrite(writer, "}", 1);
+} // epDumpWriteName
+
+/**
+ * @brief is node written with leading minus checking function
+ * 
+ * @param[in] node node to check (non-null, not temporary)
+ * 
+ * @return true if node is negation or negative constant, false if not
+ * 
+ * @note named prefix operators always surround their operands, so minus can't occur in their chain unsurrounded
+ */
+static bool epDumpIsNegation( const EpNode *node ) {
+    return false
+        || (node->type == EP_NODE_UNARY_OPERATOR && node->unaryOperator.op == EP_UNARY_OPERATOR_NEG)
+        || (node->type == EP_NODE_CONSTANT && signbit(node->constant))
+    ;
+} // epDumpIsNegation
 
 /**
  * @brief do this part requires bracket surround or not
  * 
  * @param[in] currentPriority current priority
  * @param[in] node            node to surround (or not)
+ * @param[in] isRhs           true if node is right hand side
+ * 
+ * @note binary operators are parsed left-associative, so right hand side of the same priority is surrounded too.
+ * Minus binds looser than power, so negation operands of power are surrounded. Integer power is written as call,
+ * so it is never surrounded.
  * 
  * @return true if surrounding required, false if not
  */
-static bool epDumpBinaryRequiresSurround( int currentPriorirty, const EpNode *node ) {
-    return true
-        && node->type == EP_NODE_BINARY_OPERATOR
-        && currentPriorirty > epBinaryOperatorGetPriority(node->binaryOperator.op)
-    ;
+static bool epDumpBinaryRequiresSurround( int currentPriorirty, const EpNode *node, bool isRhs ) {
+    if (currentPriorirty >= epBinaryOperatorGetPriority(EP_BINARY_OPERATOR_POW) && epDumpIsNegation(node))
+        return true;
+
+    if (node->type != EP_NODE_BINARY_OPERATOR || node->binaryOperator.op == EP_BINARY_OPERATOR_POWI)
+        return false;
+
+    const int priority = epBinaryOperatorGetPriority(node->binaryOperator.op);
+
+    return isRhs
+        ? currentPriorirty >= priority
+        : currentPriorirty > priority;
 } // epDumpBinaryRequiresSurround
 
 /**
  * @brief checking if unary operator requires surround
  * 
- * @param[in] node node to check
+ * @param[in] writer writer (non-null)
+ * @param[in] node   node to check
  * 
  * @return true if requires, false if not
  */
-static bool epDumpUnaryOperandRequiresSurround( const EpNode *node ) {
+static bool epDumpUnaryOperandRequiresSurround( const EpDumpWriter *writer, const EpNode *node ) {
     assert(node->type == EP_NODE_UNARY_OPERATOR);
 
+    // temporary is written as variable
+    if (node->unaryOperator.op == EP_UNARY_OPERATOR_NEG && epDumpNodeName(writer, node->unaryOperator.operand) != 0)
+        return false;
+
+    // binary operand (except for integer power call) is always surrounded, so 'sin (x ^ 2)' and '-(x ^ 2)' are written
+    // with explicit brackets. Minus before unsigned number is parsed as negative constant, so negation of such constant is surrounded too.
     bool notRequires = true
         && node->unaryOperator.op == EP_UNARY_OPERATOR_NEG
         && (false
-            || node->unaryOperator.operand->type == EP_NODE_BINARY_OPERATOR
-                && epBinaryOperatorGetPriority(node->unaryOperator.operand->binaryOperator.op)
-                    > epBinaryOperatorGetPriority(EP_BINARY_OPERATOR_ADD)
             || node->unaryOperator.operand->type == EP_NODE_UNARY_OPERATOR
-            || node->unaryOperator.operand->type == EP_NODE_CONSTANT
+            || (node->unaryOperator.operand->type == EP_NODE_BINARY_OPERATOR && node->unaryOperator.operand->binaryOperator.op == EP_BINARY_OPERATOR_POWI)
+            || (node->unaryOperator.operand->type == EP_NODE_CONSTANT && signbit(node->unaryOperator.operand->constant))
             || node->unaryOperator.operand->type == EP_NODE_VARIABLE
         )
     ;
@@ -47,129 +283,929 @@ static bool epDumpUnaryOperandRequiresSurround( const EpNode *node ) {
 } // epDumpUnaryOperandRequiresSurround
 
 /**
- * @brief node in infix format dumping function
+ * @brief node in infix format expansion function
+ * 
+ * @param[in,out] writer writer (non-null)
+ * @param[in]     node   node to expand (non-null)
+ * @param[out]    parts  node parts destination (at least EP_DUMP_MAX_PARTS elements)
+ * 
+ * @note leading text is written immediately, remaining parts must be dumped in order
  * 
- * @param[in] out  file to dump to
- * @param[in] node node to dump
+ * @return count of parts
  */
-static void epDumpInfixExpression( FILE *out, const EpNode *node ) {
+static size_t epDumpInfixExpression( EpDumpWriter *writer, const EpNode *node, EpDumpItem *parts ) {
+    size_t partCount = 0;
+
     switch (node->type) {
     case EP_NODE_VARIABLE:
-        fprintf(out, "%s", node->variable);
+        epDumpWriteString(writer, epSymbolName(node->variable));
         break;
 
     case EP_NODE_CONSTANT:
-        fprintf(out, "%lf", node->constant);
+        epDumpWriteDouble(writer, node->constant);
         break;
 
     case EP_NODE_BINARY_OPERATOR: {
-        int priority = epBinaryOperatorGetPriority(node->binaryOperator.op);
-        bool surroundLhs = epDumpBinaryRequiresSurround(priority, node->binaryOperator.lhs);
-        bool surroundRhs = epDumpBinaryRequiresSurround(priority, node->binaryOperator.rhs);
+        // integer power is written as call, so it is read back as integer power, not as generic one
+        if (node->binaryOperator.op == EP_BINARY_OPERATOR_POWI) {
+            epDumpWriteString(writer, "powi(");
+            parts[partCount++] = EP_DUMP_NODE(node->binaryOperator.lhs);
+            parts[partCount++] = EP_DUMP_TEXT(", ");
+            parts[partCount++] = EP_DUMP_NODE(node->binaryOperator.rhs);
+            parts[partCount++] = EP_DUMP_TEXT(")");
+            break;
+        }
 
-        if (surroundLhs) fprintf(out, "(");
-        epDumpInfixExpression(out, node->binaryOperator.lhs);
-        if (surroundLhs) fprintf(out, ")");
+        int priority = epBinaryOperatorGetPriority(node->binaryOperator.op);
+        bool surroundLhs = epDumpNodeName(writer, node->binaryOperator.lhs) == 0 && epDumpBinaryRequiresSurround(priority, node->binaryOperator.lhs, false);
+        bool surroundRhs = epDumpNodeName(writer, node->binaryOperator.rhs) == 0 && epDumpBinaryRequiresSurround(priority, node->binaryOperator.rhs, true);
+        const char *op = " ^ ";
 
-        fprintf(out, " ");
         switch (node->binaryOperator.op) {
-        case EP_BINARY_OPERATOR_ADD: fprintf(out, "+"); break;
-        case EP_BINARY_OPERATOR_SUB: fprintf(out, "-"); break;
-        case EP_BINARY_OPERATOR_MUL: fprintf(out, "*"); break;
-        case EP_BINARY_OPERATOR_DIV: fprintf(out, "/"); break;
-        case EP_BINARY_OPERATOR_POW: fprintf(out, "^"); break;
+        case EP_BINARY_OPERATOR_ADD : op = " + "; break;
+        case EP_BINARY_OPERATOR_SUB : op = " - "; break;
+        case EP_BINARY_OPERATOR_MUL : op = " * "; break;
+        case EP_BINARY_OPERATOR_DIV : op = " / "; break;
+        case EP_BINARY_OPERATOR_POW : op = " ^ "; break;
+        case EP_BINARY_OPERATOR_POWI: break;
         }
-        fprintf(out, " ");
 
-        if (surroundRhs) fprintf(out, "(");
-        epDumpInfixExpression(out, node->binaryOperator.rhs);
-        if (surroundRhs) fprintf(out, ")");
+        if (surroundLhs) epDumpWrite(writer, "(", 1);
+        parts[partCount++] = EP_DUMP_NODE(node->binaryOperator.lhs);
+        if (surroundLhs) parts[partCount++] = EP_DUMP_TEXT(")");
 
+        parts[partCount++] = EP_DUMP_TEXT(op);
 
+        if (surroundRhs) parts[partCount++] = EP_DUMP_TEXT("(");
+        parts[partCount++] = EP_DUMP_NODE(node->binaryOperator.rhs);
+        if (surroundRhs) parts[partCount++] = EP_DUMP_TEXT(")");
         break;
     }
 
-
     case EP_NODE_UNARY_OPERATOR: {
-        bool surround = epDumpUnaryOperandRequiresSurround(node);
+        bool surround = epDumpUnaryOperandRequiresSurround(writer, node);
 
-        fprintf(out, "%s", epUnaryOperatorStr(node->unaryOperator.op));
-        if (surround) fprintf(out, "(");
-        epDumpInfixExpression(out, node->unaryOperator.operand);
-        if (surround) fprintf(out, ")");
+        epDumpWriteString(writer, epUnaryOperatorStr(node->unaryOperator.op));
+        if (surround) epDumpWrite(writer, "(", 1);
+        parts[partCount++] = EP_DUMP_NODE(node->unaryOperator.operand);
+        if (surround) parts[partCount++] = EP_DUMP_TEXT(")");
         break;
     }
     }
+
+    return partCount;
 } // epDumpInfixExpression
 
 /**
- * @brief dumping to file in TeX format function
+ * @brief node in TeX format expansion function
+ * 
+ * @param[in,out] writer writer (non-null)
+ * @param[in]     node   node to expand (non-null)
+ * @param[out]    parts  node parts destination (at least EP_DUMP_MAX_PARTS elements)
+ * 
+ * @note leading text is written immediately, remaining parts must be dumped in order
  * 
- * @param[in] out  file to dump to
- * @param[in] node tree to dump
+ * @return count of parts
  */
-static void epDumpTex( FILE *out, const EpNode *node ) {
-    fprintf(out, "{");
+static size_t epDumpTex( EpDumpWriter *writer, const EpNode *node, EpDumpItem *parts ) {
+    size_t partCount = 0;
+
+    epDumpWrite(writer, "{", 1);
 
     switch (node->type) {
     case EP_NODE_VARIABLE:
-        fprintf(out, "%s", node->variable);
+        epDumpWriteString(writer, epSymbolName(node->variable));
+        epDumpWrite(writer, "}", 1);
         break;
 
     case EP_NODE_CONSTANT:
-        if (epDoubleIsSame((double)(long long int)node->constant, node->constant))
-            fprintf(out, "%lld", (long long int)node->constant);
-        else
-            fprintf(out, "%lf", node->constant);
+        epDumpWriteTexDouble(writer, node->constant);
+        epDumpWrite(writer, "}", 1);
         break;
 
     case EP_NODE_BINARY_OPERATOR: {
+        // integer power is written as call, so it is distinguishable from generic one
+        if (node->binaryOperator.op == EP_BINARY_OPERATOR_POWI) {
+            epDumpWriteString(writer, "\\mathrm{powi}(");
+            parts[partCount++] = EP_DUMP_NODE(node->binaryOperator.lhs);
+            parts[partCount++] = EP_DUMP_TEXT(", ");
+            parts[partCount++] = EP_DUMP_NODE(node->binaryOperator.rhs);
+            parts[partCount++] = EP_DUMP_TEXT(")}");
+            break;
+        }
 
         int priority = epBinaryOperatorGetPriority(node->binaryOperator.op);
-        bool surroundLhs = epDumpBinaryRequiresSurround(priority, node->binaryOperator.lhs);
-        bool surroundRhs = epDumpBinaryRequiresSurround(priority, node->binaryOperator.rhs);
-
-        if (surroundLhs) fprintf(out, "(");
-        epDumpTex(out, node->binaryOperator.lhs);
-        if (surroundLhs) fprintf(out, ")");
+        bool surroundLhs = epDumpNodeName(writer, node->binaryOperator.lhs) == 0 && epDumpBinaryRequiresSurround(priority, node->binaryOperator.lhs, false);
+        bool surroundRhs = epDumpNodeName(writer, node->binaryOperator.rhs) == 0 && epDumpBinaryRequiresSurround(priority, node->binaryOperator.rhs, true);
+        const char *op = "^";
 
         switch (node->binaryOperator.op) {
-        case EP_BINARY_OPERATOR_ADD: fprintf(out,      "+"); break;
-        case EP_BINARY_OPERATOR_SUB: fprintf(out,      "-"); break;
-        case EP_BINARY_OPERATOR_MUL: fprintf(out, "\\cdot"); break;
-        case EP_BINARY_OPERATOR_DIV: fprintf(out, "\\over"); break;
-        case EP_BINARY_OPERATOR_POW: fprintf(out,      "^"); break;
+        case EP_BINARY_OPERATOR_ADD : op =      "+"; break;
+        case EP_BINARY_OPERATOR_SUB : op =      "-"; break;
+        case EP_BINARY_OPERATOR_MUL : op = "\\cdot"; break;
+        case EP_BINARY_OPERATOR_DIV : op = "\\over"; break;
+        case EP_BINARY_OPERATOR_POW : op =      "^"; break;
+        case EP_BINARY_OPERATOR_POWI: break;
         }
 
-        if (surroundRhs) fprintf(out, "(");
-        epDumpTex(out, node->binaryOperator.rhs);
-        if (surroundRhs) fprintf(out, ")");
+        if (surroundLhs) epDumpWrite(writer, "(", 1);
+        parts[partCount++] = EP_DUMP_NODE(node->binaryOperator.lhs);
+        if (surroundLhs) parts[partCount++] = EP_DUMP_TEXT(")");
+
+        parts[partCount++] = EP_DUMP_TEXT(op);
 
+        if (surroundRhs) parts[partCount++] = EP_DUMP_TEXT("(");
+        parts[partCount++] = EP_DUMP_NODE(node->binaryOperator.rhs);
+        if (surroundRhs) parts[partCount++] = EP_DUMP_TEXT(")");
+
+        parts[partCount++] = EP_DUMP_TEXT("}");
         break;
     }
 
     case EP_NODE_UNARY_OPERATOR: {
-        bool surround = epDumpUnaryOperandRequiresSurround(node);
+        // operand is already surrounded by braces, so it is exponent or radicand itself
+        if (node->unaryOperator.op == EP_UNARY_OPERATOR_EXP || node->unaryOperator.op == EP_UNARY_OPERATOR_SQRT) {
+            epDumpWriteString(writer, node->unaryOperator.op == EP_UNARY_OPERATOR_EXP ? "e^" : "\\sqrt");
+            parts[partCount++] = EP_DUMP_NODE(node->unaryOperator.operand);
+            parts[partCount++] = EP_DUMP_TEXT("}");
+            break;
+        }
+
+        bool surround = epDumpUnaryOperandRequiresSurround(writer, node);
 
-        fprintf(out, "%s", epUnaryOperatorStr(node->unaryOperator.op));
-        if (surround) fprintf(out, "(");
-        epDumpTex(out, node->unaryOperator.operand);
-        if (surround) fprintf(out, ")");
+        epDumpWriteString(writer, epUnaryOperatorStr(node->unaryOperator.op));
+        if (surround) epDumpWrite(writer, "(", 1);
+        parts[partCount++] = EP_DUMP_NODE(node->unaryOperator.operand);
+        if (surround) parts[partCount++] = EP_DUMP_TEXT(")");
+        parts[partCount++] = EP_DUMP_TEXT("}");
         break;
     }
-
     }
 
-    fprintf(out, "}");
+    return partCount;
 } // epDumpTex
 
-void epNodeDump( FILE *out, const EpNode *node, EpDumpFormat format ) {
-    assert(node != NULL);
+/**
+ * @brief shared subtree class key hash computation function
+ * 
+ * @param[in] cls class to compute hash of (non-null, key fields are set)
+ * 
+ * @return hash
+ */
+static uint32_t epDumpShareHash( const EpDumpShareClass *cls ) {
+    uint32_t hash = (uint32_t)cls->type * 0x9E3779B1u ^ cls->op;
+
+    hash = (hash ^ (uint32_t)cls->value) * 0x85EBCA6Bu;
+    hash = (hash ^ (uint32_t)(cls->value >> 32)) * 0xC2B2AE35u;
+    hash = (hash ^ cls->rhs) * 0x85EBCA6Bu;
+
+    return hash ^ hash >> 16;
+} // epDumpShareHash
+
+/**
+ * @brief shared subtree class keys comparison function
+ * 
+ * @param[in] lhs left hand side (non-null)
+ * @param[in] rhs right hand side (non-null)
+ * 
+ * @return true if classes describe the same subtree, false otherwise
+ */
+static bool epDumpShareIsSame( const EpDumpShareClass *lhs, const EpDumpShareClass *rhs ) {
+    return true
+        && lhs->hash == rhs->hash
+        && lhs->type == rhs->type
+        && lhs->op == rhs->op
+        && lhs->value == rhs->value
+        && lhs->rhs == rhs->rhs
+    ;
+} // epDumpShareIsSame
+
+/**
+ * @brief shared subtree class table growth function
+ * 
+ * @param[in,out] share sharing context (non-null)
+ * 
+ * @return true if succeeded, false if allocation failed
+ */
+static bool epDumpShareGrowSlots( EpDumpShare *share ) {
+    const size_t slotCount = share->slotCount == 0 ? 128 : share->slotCount * 2;
+    uint32_t *slots = (uint32_t *)malloc(sizeof(uint32_t) * slotCount);
+
+    if (slots == NULL)
+        return false;
+
+    memset(slots, 0xFF, sizeof(uint32_t) * slotCount);
+    for (size_t i = 0; i < share->classCount; i++) {
+        size_t index = share->classes[i].hash & (slotCount - 1);
+
+        while (slots[index] != EP_DUMP_SHARE_EMPTY)
+            index = (index + 1) & (slotCount - 1);
+        slots[index] = (uint32_t)i;
+    }
+
+    free(share->slots);
+    share->slots = slots;
+    share->slotCount = slotCount;
+    return true;
+} // epDumpShareGrowSlots
+
+/**
+ * @brief shared subtree class interning function
+ * 
+ * @param[in,out] share sharing context (non-null)
+ * @param[in]     key   class key (type, op, value and rhs fields are used)
+ * 
+ * @note new class references its operand classes, so their use counts are incremented
+ * 
+ * @return class index (EP_DUMP_SHARE_EMPTY if allocation failed)
+ */
+static uint32_t epDumpShareIntern( EpDumpShare *share, EpDumpShareClass key ) {
+    key.hash = epDumpShareHash(&key);
+    key.useCount = 0;
+    key.name = 0;
+
+    // load factor is kept below 1/2
+    if ((share->classCount + 1) * 2 > share->slotCount && !epDumpShareGrowSlots(share))
+        return EP_DUMP_SHARE_EMPTY;
+
+    size_t index = key.hash & (share->slotCount - 1);
+
+    for (; share->slots[index] != EP_DUMP_SHARE_EMPTY; index = (index + 1) & (share->slotCount - 1))
+        if (epDumpShareIsSame(&share->classes[share->slots[index]], &key))
+            return share->slots[index];
+
+    if (share->classCount == share->classCapacity) {
+        const size_t classCapacity = share->classCapacity == 0 ? 64 : share->classCapacity * 2;
+        EpDumpShareClass *classes = (EpDumpShareClass *)realloc(share->classes, sizeof(EpDumpShareClass) * classCapacity);
+
+        if (classes == NULL)
+            return EP_DUMP_SHARE_EMPTY;
+        share->classes = classes;
+        share->classCapacity = classCapacity;
+    }
+
+    switch (key.type) {
+    case EP_NODE_BINARY_OPERATOR:
+        share->classes[key.rhs].useCount++;
+        share->classes[key.value].useCount++;
+        break;
+
+    case EP_NODE_UNARY_OPERATOR:
+        share->classes[key.value].useCount++;
+        break;
+
+    default:
+        break;
+    }
+
+    share->classes[share->classCount] = key;
+    share->slots[index] = (uint32_t)share->classCount;
+    return (uint32_t)share->classCount++;
+} // epDumpShareIntern
+
+/**
+ * @brief sharing context destructor
+ * 
+ * @param[in,out] share sharing context to destroy (non-null)
+ */
+static void epDumpShareDtor( EpDumpShare *share ) {
+    free(share->classes);
+    free(share->slots);
+    free(share->nodes);
+} // epDumpShareDtor
+
+/**
+ * @brief temporary name prefix selection function
+ * 
+ * @param[in,out] share sharing context (non-null, classes are built)
+ * 
+ * @note prefix is extended until no variable is named as prefix followed by digits
+ */
+static void epDumpShareSelectPrefix( EpDumpShare *share ) {
+    bool clashes = true;
+
+    share->prefixLength = 0;
+    while (clashes && share->prefixLength + 1 < EP_DUMP_SHARE_MAX_PREFIX) {
+        share->prefix[share->prefixLength++] = 't';
+        clashes = false;
+
+        for (size_t i = 0; i < share->classCount && !clashes; i++) {
+            if (share->classes[i].type != EP_NODE_VARIABLE)
+                continue;
+
+            const char *name = epSymbolName((EpSymbol)share->classes[i].value);
+
+            if (strncmp(name, share->prefix, share->prefixLength) != 0 || name[share->prefixLength] == '\0')
+                continue;
 
+            clashes = true;
+            for (const char *digit = name + share->prefixLength; *digit != '\0' && clashes; digit++)
+                clashes = *digit >= '0' && *digit <= '9';
+        }
+    }
+    share->prefix[share->prefixLength] = '\0';
+} // epDumpShareSelectPrefix
+
+/// @brief shared subtree detection traversal frame
+typedef struct __EpDumpShareFrame {
+    const EpNode * node;     ///< node
+    bool           expanded; ///< true if operands are already pushed
+} EpDumpShareFrame;
+
+/**
+ * @brief sharing context constructor
+ * 
+ * @param[out] share sharing context (non-null)
+ * @param[in]  node  node to detect repeated subtrees in (non-null)
+ * 
+ * @note subtrees are the same if their structure is the same and constants are bitwise equal.
+ * Operator subtree referenced at least twice gets temporary name, temporaries are numbered so that
+ * each temporary is defined after temporaries it depends on.
+ * 
+ * @return true if succeeded, false if allocation failed (context is destroyed then)
+ */
+static bool epDumpShareCtor( EpDumpShare *share, const EpNode *node ) {
+    EpDumpShareFrame localFrames[EP_LOCAL_STACK_SIZE];
+    EpDumpShareFrame *frames = localFrames;
+    size_t frameCount = 0;
+    size_t frameCapacity = EP_LOCAL_STACK_SIZE;
+    uint32_t localValues[EP_LOCAL_STACK_SIZE];
+    uint32_t *values = localValues;
+    size_t valueCount = 0;
+    size_t valueCapacity = EP_LOCAL_STACK_SIZE;
+    bool succeeded = true;
+
+    memset(share, 0, sizeof(EpDumpShare));
+    frames[frameCount++] = (EpDumpShareFrame) { .node = node, .expanded = false };
+
+    while (frameCount != 0) {
+        const EpDumpShareFrame frame = frames[--frameCount];
+        const EpNode *current = frame.node;
+        EpDumpShareClass key = { .type = current->type, .op = 0, .value = 0, .rhs = 0, .hash = 0, .useCount = 0, .name = 0 };
+
+        if (!frame.expanded && (current->type == EP_NODE_BINARY_OPERATOR || current->type == EP_NODE_UNARY_OPERATOR)) {
+            if (!epStackReserve((void **)&frames, &frameCapacity, frameCount + 3, sizeof(EpDumpShareFrame), localFrames)) {
+                succeeded = false;
+                break;
+            }
+
+            // left hand side is popped (and classified) first
+            frames[frameCount++] = (EpDumpShareFrame) { .node = current, .expanded = true };
+            if (current->type == EP_NODE_BINARY_OPERATOR) {
+                frames[frameCount++] = (EpDumpShareFrame) { .node = current->binaryOperator.rhs, .expanded = false };
+                frames[frameCount++] = (EpDumpShareFrame) { .node = current->binaryOperator.lhs, .expanded = false };
+            } else {
+                frames[frameCount++] = (EpDumpShareFrame) { .node = current->unaryOperator.operand, .expanded = false };
+            }
+            continue;
+        }
+
+        switch (current->type) {
+        case EP_NODE_VARIABLE:
+            key.value = current->variable;
+            break;
+
+        case EP_NODE_CONSTANT:
+            memcpy(&key.value, &current->constant, sizeof(double));
+            break;
+
+        case EP_NODE_BINARY_OPERATOR:
+            key.op = (uint32_t)current->binaryOperator.op;
+            key.rhs = values[--valueCount];
+            key.value = values[--valueCount];
+            break;
+
+        case EP_NODE_UNARY_OPERATOR:
+            key.op = (uint32_t)current->unaryOperator.op;
+            key.value = values[--valueCount];
+            break;
+        }
+
+        if (!epStackReserve((void **)&values, &valueCapacity, valueCount + 1, sizeof(uint32_t), localValues)) {
+            succeeded = false;
+            break;
+        }
+
+        const uint32_t cls = epDumpShareIntern(share, key);
+
+        if (cls == EP_DUMP_SHARE_EMPTY) {
+            succeeded = false;
+            break;
+        }
+        values[valueCount++] = cls;
+    }
+
+    if (frames != localFrames)
+        free(frames);
+    if (values != localValues)
+        free(values);
+
+    if (succeeded)
+        share->nodes = (EpNode *)malloc(sizeof(EpNode) * share->classCount);
+
+    if (!succeeded || share->nodes == NULL) {
+        epDumpShareDtor(share);
+        return false;
+    }
+
+    // root is classified last and can't repeat inside itself, so it is the last class
+    share->classes[share->classCount - 1].useCount++;
+
+    for (size_t i = 0; i < share->classCount; i++) {
+        EpDumpShareClass *cls = &share->classes[i];
+        EpNode *canonical = &share->nodes[i];
+
+        canonical->type = cls->type;
+        canonical->hash = cls->hash;
+
+        switch (cls->type) {
+        case EP_NODE_VARIABLE:
+            canonical->variable = (EpSymbol)cls->value;
+            break;
+
+        case EP_NODE_CONSTANT:
+            memcpy(&canonical->constant, &cls->value, sizeof(double));
+            break;
+
+        case EP_NODE_BINARY_OPERATOR:
+            canonical->binaryOperator.op = (EpBinaryOperator)cls->op;
+            canonical->binaryOperator.lhs = &share->nodes[cls->value];
+            canonical->binaryOperator.rhs = &share->nodes[cls->rhs];
+            cls->name = cls->useCount > 1 ? ++share->nameCount : 0;
+            break;
+
+        case EP_NODE_UNARY_OPERATOR:
+            canonical->unaryOperator.op = (EpUnaryOperator)cls->op;
+            canonical->unaryOperator.operand = &share->nodes[cls->value];
+            cls->name = cls->useCount > 1 ? ++share->nameCount : 0;
+            break;
+        }
+    }
+
+    epDumpShareSelectPrefix(share);
+    return true;
+} // epDumpShareCtor
+
+/**
+ * @brief node tree dumping function
+ * 
+ * @param[in,out] writer         writer (non-null)
+ * @param[in]     node           node to dump (non-null)
+ * @param[in]     isTex          true if node is dumped in TeX format, false if in infix one
+ * @param[in]     definitionRoot node that is written even if it is temporary (nullable)
+ * 
+ * @note node is dumped with explicit stack of pending parts, so depth is limited only by heap size.
+ * If writer has sharing context, temporaries (except definitionRoot) are written by names.
+ * 
+ * @return true if succeeded, false if allocation failed
+ */
+static bool epDumpTree( EpDumpWriter *writer, const EpNode *node, bool isTex, const EpNode *definitionRoot ) {
+    EpDumpItem localStack[EP_LOCAL_STACK_SIZE];
+    EpDumpItem *stack = localStack;
+    size_t stackSize = 0;
+    size_t stackCapacity = EP_LOCAL_STACK_SIZE;
+    bool succeeded = true;
+
+    stack[stackSize++] = EP_DUMP_NODE(node);
+
+    while (stackSize != 0) {
+        const EpDumpItem item = stack[--stackSize];
+
+        if (item.node == NULL) {
+            epDumpWriteString(writer, item.text);
+            continue;
+        }
+
+        const uint32_t name = item.node != definitionRoot ? epDumpNodeName(writer, item.node) : 0;
+
+        if (name != 0) {
+            if (isTex) epDumpWrite(writer, "{", 1);
+            epDumpWriteName(writer, name, isTex);
+            if (isTex) epDumpWrite(writer, "}", 1);
+            continue;
+        }
+
+        EpDumpItem parts[EP_DUMP_MAX_PARTS];
+        const size_t partCount = isTex
+            ? epDumpTex(writer, item.node, parts)
+            : epDumpInfixExpression(writer, item.node, parts);
+
+        if (!epStackReserve((void **)&stack, &stackCapacity, stackSize + partCount, sizeof(EpDumpItem), localStack)) {
+            succeeded = false;
+            break;
+        }
+
+        // parts are pushed in reverse order, so first part is popped first
+        for (size_t i = partCount; i != 0; i--)
+            stack[stackSize++] = parts[i - 1];
+    }
+
+    if (stack != localStack)
+        free(stack);
+    return succeeded && !writer->failed;
+} // epDumpTree
+
+/**
+ * @brief node with repeated subtrees written once dumping function
+ * 
+ * @param[in,out] writer writer (non-null, without sharing context)
+ * @param[in]     node   node to dump (non-null)
+ * @param[in]     isTex  true if node is dumped in TeX format, false if in infix one
+ * 
+ * @note infix format is 'let t1 = ...; let t2 = ...; expression' (single line, parseable back),
+ * TeX format is 'expression \quad\text{where}\quad t_{1}=..., t_{2}=...'.
+ * Every distinct subtree is written once, so dump size is proportional to node DAG size.
+ * 
+ * @return true if succeeded, false if allocation failed
+ */
+static bool epDumpShared( EpDumpWriter *writer, const EpNode *node, bool isTex ) {
+    EpDumpShare share;
+
+    if (!epDumpShareCtor(&share, node))
+        return epDumpTree(writer, node, isTex, NULL);
+
+    const EpNode *root = &share.nodes[share.classCount - 1];
+    bool succeeded = true;
+
+    writer->share = &share;
+
+    if (!isTex) {
+        for (size_t i = 0; i < share.classCount && succeeded; i++) {
+            if (share.classes[i].name == 0)
+                continue;
+
+            epDumpWrite(writer, "let ", 4);
+            epDumpWriteName(writer, share.classes[i].name, false);
+            epDumpWrite(writer, " = ", 3);
+            succeeded = epDumpTree(writer, &share.nodes[i], false, &share.nodes[i]);
+            epDumpWrite(writer, "; ", 2);
+        }
+
+        succeeded = succeeded && epDumpTree(writer, root, false, NULL);
+    } else {
+        succeeded = epDumpTree(writer, root, true, NULL);
+
+        if (share.nameCount != 0)
+            epDumpWriteString(writer, "\\quad\\text{where}\\quad ");
+
+        for (size_t i = 0; i < share.classCount && succeeded; i++) {
+            if (share.classes[i].name == 0)
+                continue;
+
+            if (share.classes[i].name != 1)
+                epDumpWrite(writer, ",\\;", 3);
+            epDumpWriteName(writer, share.classes[i].name, true);
+            epDumpWrite(writer, "=", 1);
+            succeeded = epDumpTree(writer, &share.nodes[i], true, &share.nodes[i]);
+        }
+    }
+
+    writer->share = NULL;
+    epDumpShareDtor(&share);
+    return succeeded && !writer->failed;
+} // epDumpShared
+
+/**
+ * @brief node dumping implementation function
+ * 
+ * @param[in,out] writer writer (non-null)
+ * @param[in]     node   node to dump (non-null)
+ * @param[in]     format dumping format
+ * 
+ * @return true if succeeded, false if allocation failed
+ */
+static bool epDumpNode( EpDumpWriter *writer, const EpNode *node, EpDumpFormat format ) {
     switch (format) {
-    case EP_DUMP_INFIX_EXPRESSION : epDumpInfixExpression (out, node); break;
-    case EP_DUMP_TEX              : epDumpTex             (out, node); break;
+    case EP_DUMP_INFIX_EXPRESSION     : return epDumpTree(writer, node, false, NULL);
+    case EP_DUMP_TEX                  : return epDumpTree(writer, node, true, NULL);
+    case EP_DUMP_INFIX_EXPRESSION_LET : return epDumpShared(writer, node, false);
+    case EP_DUMP_TEX_WHERE            : return epDumpShared(writer, node, true);
     }
+
+    return epDumpTree(writer, node, false, NULL);
+} // epDumpNode
+
+void epNodeDump( FILE *out, const EpNode *node, EpDumpFormat format ) {
+    assert(out != NULL);
+    assert(node != NULL);
+
+    char chunk[EP_DUMP_CHUNK_SIZE];
+    EpBuffer buffer = { .data = chunk, .size = 0, .capacity = sizeof(chunk) };
+    EpDumpWriter writer = { .buffer = &buffer, .out = out, .failed = false, .share = NULL };
+
+    EP_STATS_PHASE_BEGIN(EP_STATS_PHASE_DUMP);
+    epDumpNode(&writer, node, format);
+    fwrite(buffer.data, 1, buffer.size, out);
+    EP_STATS_PHASE_END(EP_STATS_PHASE_DUMP);
 } // epNodeDump
 
+bool epNodeDumpToBuffer( EpBuffer *buffer, const EpNode *node, EpDumpFormat format ) {
+    assert(buffer != NULL);
+    assert(node != NULL);
+
+    if (!epBufferReserve(buffer, 0))
+        return false;
+
+    EpDumpWriter writer = { .buffer = buffer, .out = NULL, .failed = false, .share = NULL };
+
+    EP_STATS_PHASE_BEGIN(EP_STATS_PHASE_DUMP);
+    const bool succeeded = epDumpNode(&writer, node, format);
+    EP_STATS_PHASE_END(EP_STATS_PHASE_DUMP);
+
+    buffer->data[buffer->size] = '\0';
+    return succeeded;
+} // epNodeDumpToBuffer
+
+char * epNodeDumpToString( const EpNode *node, EpDumpFormat format ) {
+    assert(node != NULL);
+
+    EpBuffer buffer = { .data = NULL, .size = 0, .capacity = 0 };
+
+    if (!epNodeDumpToBuffer(&buffer, node, format)) {
+        epBufferDtor(&buffer);
+        return NULL;
+    }
+
+    return buffer.data;
+} // epNodeDumpToString
+
+/// @brief count of trees dump round-trip is checked on
+#define EP_DUMP_ROUND_TRIP_CHECK_TREE_COUNT ((size_t)20000)
+
+/// @brief maximal depth of round-trip check tree
+#define EP_DUMP_ROUND_TRIP_CHECK_DEPTH 7
+
+/// @brief count of points values of round-trip check trees are compared at
+#define EP_DUMP_ROUND_TRIP_CHECK_POINT_COUNT ((size_t)3)
+
+/// @brief count of variables round-trip check trees contain
+#define EP_DUMP_ROUND_TRIP_CHECK_VARIABLE_COUNT ((size_t)3)
+
+/// @brief names of variables round-trip check trees contain
+static const char *const epDumpRoundTripCheckNames[EP_DUMP_ROUND_TRIP_CHECK_VARIABLE_COUNT] = { "x", "y", "z" };
+
+/**
+ * @brief round-trip check pseudo-random number generation function
+ * 
+ * @param[in,out] state generator state (non-null)
+ * 
+ * @return pseudo-random 53-bit number
+ */
+static uint64_t epDumpRoundTripCheckRandom( uint64_t *state ) {
+    *state = *state * 6364136223846793005ull + 1442695040888963407ull;
+    return *state >> 11;
+} // epDumpRoundTripCheckRandom
+
+/**
+ * @brief round-trip check constant generation function
+ * 
+ * @param[in,out] state generator state (non-null)
+ * 
+ * @return constant (small integer, fraction, any finite double or rarely infinity or nan, sign is random)
+ */
+static double epDumpRoundTripCheckConstant( uint64_t *state ) {
+    double value = 0.0;
+
+    switch (epDumpRoundTripCheckRandom(state) % 16) {
+    case 0:
+        value = epDumpRoundTripCheckRandom(state) % 2 == 0
+            ? INFINITY
+            : NAN;
+        break;
+
+    case 1: case 2: case 3: case 4: case 5:
+        value = (double)(epDumpRoundTripCheckRandom(state) % 10);
+        break;
+
+    case 6: case 7: case 8: case 9: case 10:
+        value = (double)epDumpRoundTripCheckRandom(state) / 9007199254740992.0; // [0, 1)
+        break;
+
+    default:
+        do {
+            const uint64_t bits = epDumpRoundTripCheckRandom(state) << 11 ^ epDumpRoundTripCheckRandom(state);
+
+            memcpy(&value, &bits, sizeof(double));
+        } while (!isfinite(value));
+        break;
+    }
+
+    return epDumpRoundTripCheckRandom(state) % 2 == 0
+        ? value
+        : -value;
+} // epDumpRoundTripCheckConstant
+
+/**
+ * @brief round-trip check tree generation function
+ * 
+ * @param[in,out] state generator state (non-null)
+ * @param[in]     depth maximal tree depth
+ * 
+ * @return tree (NULL if allocation failed)
+ * 
+ * @note some binary operators get same operands, so sharing-aware dump binds them.
+ * Integer powers get small non-negative integer exponents, as optimizer produces.
+ */
+static EpNode * epDumpRoundTripCheckTree( uint64_t *state, int depth ) {
+    const uint64_t kind = depth == 0
+        ? epDumpRoundTripCheckRandom(state) % 2
+        : epDumpRoundTripCheckRandom(state) % 5;
+
+    switch (kind) {
+    case 0:
+        return epNodeVariable(epDumpRoundTripCheckNames[epDumpRoundTripCheckRandom(state) % EP_DUMP_ROUND_TRIP_CHECK_VARIABLE_COUNT]);
+
+    case 1:
+        return epNodeConstant(epDumpRoundTripCheckConstant(state));
+
+    case 2: {
+        const EpUnaryOperator op = (EpUnaryOperator)(epDumpRoundTripCheckRandom(state) % (EP_UNARY_OPERATOR_SQRT + 1));
+
+        return epNodeUnaryOperator(op, epDumpRoundTripCheckTree(state, depth - 1));
+    }
+
+    default: {
+        const EpBinaryOperator op = (EpBinaryOperator)(epDumpRoundTripCheckRandom(state) % (EP_BINARY_OPERATOR_POWI + 1));
+        EpNode *lhs = epDumpRoundTripCheckTree(state, depth - 1);
+        EpNode *rhs = NULL;
+
+        if (op == EP_BINARY_OPERATOR_POWI)
+            rhs = epNodeConstant((double)(epDumpRoundTripCheckRandom(state) % 9));
+        else if (epDumpRoundTripCheckRandom(state) % 8 == 0 && lhs != NULL)
+            rhs = epNodeCopy(lhs);
+        else
+            rhs = epDumpRoundTripCheckTree(state, depth - 1);
+
+        return epNodeBinaryOperator(op, lhs, rhs);
+    }
+    }
+} // epDumpRoundTripCheckTree
+
+/**
+ * @brief tree parsed back from dump expectation function
+ * 
+ * @param[in] node dumped tree (non-null)
+ * 
+ * @return node copy with non-finite constants replaced by divisions they are dumped as (NULL if allocation failed)
+ */
+static EpNode * epDumpRoundTripCheckExpected( const EpNode *node ) {
+    switch (node->type) {
+    case EP_NODE_VARIABLE:
+        return epNodeVariableSymbol(node->variable);
+
+    case EP_NODE_CONSTANT:
+        if (isfinite(node->constant))
+            return epNodeConstant(node->constant);
+
+        return epNodeBinaryOperator(
+            EP_BINARY_OPERATOR_DIV,
+            epNodeConstant(isnan(node->constant) ? 0.0 : signbit(node->constant) ? -1.0 : 1.0),
+            epNodeConstant(0.0)
+        );
+
+    case EP_NODE_BINARY_OPERATOR:
+        return epNodeBinaryOperator(
+            node->binaryOperator.op,
+            epDumpRoundTripCheckExpected(node->binaryOperator.lhs),
+            epDumpRoundTripCheckExpected(node->binaryOperator.rhs)
+        );
+
+    case EP_NODE_UNARY_OPERATOR:
+        return epNodeUnaryOperator(node->unaryOperator.op, epDumpRoundTripCheckExpected(node->unaryOperator.operand));
+    }
+
+    assert(false && "Unknown node type");
+    return NULL;
+} // epDumpRoundTripCheckExpected
+
+/**
+ * @brief tree and its parsed back dump comparison function
+ * 
+ * @param[in] node      original tree (non-null)
+ * @param[in] expected  tree dump must be parsed to (non-null)
+ * @param[in] dump      original tree dump (non-null)
+ * @param[in] points    variable values (EP_DUMP_ROUND_TRIP_CHECK_POINT_COUNT points)
+ * 
+ * @return true if dump is parsed to tree identical to expected one with bit-identical (or both nan) values, false otherwise
+ */
+static bool epDumpRoundTripCheckDump(
+    const EpNode     * node,
+    const EpNode     * expected,
+    const char       * dump,
+    const EpVariable   points[][EP_DUMP_ROUND_TRIP_CHECK_VARIABLE_COUNT]
+) {
+    const EpParseExpressionResult parsed = epParseExpression(dump);
+
+    if (parsed.status != EP_PARSE_EXPRESSION_OK)
+        return false;
+
+    bool same = epNodeIsIdentical(parsed.ok.result, expected);
+
+    for (size_t i = 0; same && i < EP_DUMP_ROUND_TRIP_CHECK_POINT_COUNT; i++) {
+        const EpNodeComputeResult expectedValue = epNodeCompute(node, points[i], EP_DUMP_ROUND_TRIP_CHECK_VARIABLE_COUNT);
+        const EpNodeComputeResult actualValue = epNodeCompute(parsed.ok.result, points[i], EP_DUMP_ROUND_TRIP_CHECK_VARIABLE_COUNT);
+
+        // nan payload depends on operation nan is produced by
+        same = true
+            && expectedValue.status == actualValue.status
+            && (false
+                || expectedValue.status != EP_NODE_COMPUTE_OK
+                || memcmp(&expectedValue.ok, &actualValue.ok, sizeof(double)) == 0
+                || (isnan(expectedValue.ok) && isnan(actualValue.ok))
+            )
+        ;
+    }
+
+    epNodeDtor(parsed.ok.result);
+    return same;
+} // epDumpRoundTripCheckDump
+
+/**
+ * @brief single tree round-trip checking function
+ * 
+ * @param[in]     node          tree to check (non-null)
+ * @param[in]     points        variable values (EP_DUMP_ROUND_TRIP_CHECK_POINT_COUNT points)
+ * @param[in]     out           file to write first mismatch to (nullable)
+ * @param[in,out] mismatchCount mismatch counter (non-null)
+ * 
+ * @return true if checked, false if allocation failed
+ */
+static bool epDumpRoundTripCheckNode(
+    const EpNode     * node,
+    const EpVariable   points[][EP_DUMP_ROUND_TRIP_CHECK_VARIABLE_COUNT],
+    FILE             * out,
+    size_t           * mismatchCount
+) {
+    static const EpDumpFormat formats[] = { EP_DUMP_INFIX_EXPRESSION, EP_DUMP_INFIX_EXPRESSION_LET };
+    EpNode *expected = epDumpRoundTripCheckExpected(node);
+
+    if (expected == NULL)
+        return false;
+
+    for (size_t f = 0; f < sizeof(formats) / sizeof(formats[0]); f++) {
+        char *dump = epNodeDumpToString(node, formats[f]);
+
+        if (dump == NULL) {
+            epNodeDtor(expected);
+            return false;
+        }
+
+        if (!epDumpRoundTripCheckDump(node, expected, dump, points)) {
+            if (out != NULL && *mismatchCount == 0)
+                fprintf(out, "first mismatch: %s\n", dump);
+            (*mismatchCount)++;
+        }
+
+        free(dump);
+    }
+
+    epNodeDtor(expected);
+    return true;
+} // epDumpRoundTripCheckNode
+
+bool epDumpRoundTripCheck( FILE *out ) {
+    size_t mismatchCount = 0;
+    bool failed = false;
+
+    // deterministic pseudo-random trees, so every run checks same set
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+
+    for (size_t i = 0; i < EP_DUMP_ROUND_TRIP_CHECK_TREE_COUNT && !failed; i++) {
+        EpVariable points[EP_DUMP_ROUND_TRIP_CHECK_POINT_COUNT][EP_DUMP_ROUND_TRIP_CHECK_VARIABLE_COUNT];
+
+        for (size_t p = 0; p < EP_DUMP_ROUND_TRIP_CHECK_POINT_COUNT; p++)
+            for (size_t v = 0; v < EP_DUMP_ROUND_TRIP_CHECK_VARIABLE_COUNT; v++)
+                points[p][v] = (EpVariable) {
+                    .name = epDumpRoundTripCheckNames[v],
+                    .value = -4.0 + 8.0 * (double)epDumpRoundTripCheckRandom(&state) / 9007199254740992.0,
+                };
+
+        EpNode *node = epDumpRoundTripCheckTree(&state, 1 + (int)(i % EP_DUMP_ROUND_TRIP_CHECK_DEPTH));
+        EpNode *optimized = node != NULL
+            ? epNodeOptimize(node)
+            : NULL;
+
+        // optimized trees are checked too, as they contain integer powers, square roots and folded non-finite constants
+        failed = false
+            || optimized == NULL
+            || !epDumpRoundTripCheckNode(node, points, out, &mismatchCount)
+            || !epDumpRoundTripCheckNode(optimized, points, out, &mismatchCount)
+        ;
+
+        epNodeDtor(optimized);
+        epNodeDtor(node);
+    }
+
+    const bool passed = !failed && mismatchCount == 0;
+
+    if (out != NULL)
+        fprintf(out, "%zu trees (and their optimized versions), %zu mismatches%s\n%s\n",
+            EP_DUMP_ROUND_TRIP_CHECK_TREE_COUNT,
+            mismatchCount,
+            failed ? " (allocation failed)" : "",
+            passed ? "passed" : "FAILED"
+        );
+    return passed;
+} // epDumpRoundTripCheck
+
 // ep_dump.c
@@ -0,0 +1,153 @@
+/**
+ * @brief tree to postorder node array (and back) conversion implementation file
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+
+#include "ep_internal.h"
+
+/// @brief postorder traversal stack frame representation structure
+typedef struct __EpFlatFrame {
+    const EpNode * node;     ///< node
+    bool           expanded; ///< true if node children are already pushed
+} EpFlatFrame;
+
+bool epNodeFlatten( const EpNode *node, EpFlatNodeVisitor visitor, void *context ) {
+    assert(node != NULL);
+    assert(visitor != NULL);
+
+    EpFlatFrame *frames = NULL;
+    size_t frameCount = 0;
+    size_t frameCapacity = 0;
+    uint32_t *indices = NULL; // indices of already flattened subtrees
+    size_t indexCount = 0;
+    size_t indexCapacity = 0;
+    uint32_t nodeCount = 0;
+    bool succeeded = false;
+
+    if (!epArrayReserve((void **)&frames, &frameCapacity, 1, sizeof(EpFlatFrame)))
+        goto __epNodeFlatten__end;
+    frames[frameCount++] = (EpFlatFrame) { .node = node, .expanded = false };
+
+    while (frameCount != 0) {
+        EpFlatFrame frame = frames[--frameCount];
+
+        // push children
+        if (!frame.expanded && (frame.node->type == EP_NODE_BINARY_OPERATOR || frame.node->type == EP_NODE_UNARY_OPERATOR)) {
+            if (!epArrayReserve((void **)&frames, &frameCapacity, frameCount + 3, sizeof(EpFlatFrame)))
+                goto __epNodeFlatten__end;
+
+            frames[frameCount++] = (EpFlatFrame) { .node = frame.node, .expanded = true };
+
+            if (frame.node->type == EP_NODE_BINARY_OPERATOR) {
+                frames[frameCount++] = (EpFlatFrame) { .node = frame.node->binaryOperator.rhs, .expanded = false };
+                frames[frameCount++] = (EpFlatFrame) { .node = frame.node->binaryOperator.lhs, .expanded = false };
+            } else {
+                frames[frameCount++] = (EpFlatFrame) { .node = frame.node->unaryOperator.operand, .expanded = false };
+            }
+            continue;
+        }
+
+        EpFlatNode flatNode = { .type = frame.node->type, .constant = 0.0 };
+
+        switch (frame.node->type) {
+        case EP_NODE_VARIABLE:
+            flatNode.variable = frame.node->variable;
+            break;
+
+        case EP_NODE_CONSTANT:
+            flatNode.constant = frame.node->constant;
+            break;
+
+        case EP_NODE_BINARY_OPERATOR:
+            flatNode.binaryOperator.op = frame.node->binaryOperator.op;
+            flatNode.binaryOperator.rhs = indices[--indexCount];
+            flatNode.binaryOperator.lhs = indices[--indexCount];
+            break;
+
+        case EP_NODE_UNARY_OPERATOR:
+            flatNode.unaryOperator.op = frame.node->unaryOperator.op;
+            flatNode.unaryOperator.operand = indices[--indexCount];
+            break;
+        }
+
+        if (false
+            || nodeCount == UINT32_MAX
+            || !epArrayReserve((void **)&indices, &indexCapacity, indexCount + 1, sizeof(uint32_t))
+            || !visitor(context, &flatNode)
+        )
+            goto __epNodeFlatten__end;
+
+        indices[indexCount++] = nodeCount++;
+    }
+
+    succeeded = true;
+
+__epNodeFlatten__end:
+    free(frames);
+    free(indices);
+    return succeeded;
+} // epNodeFlatten
+
+EpNode * epNodeUnflatten( EpFlatNodeGetter getter, const void *context, uint32_t nodeCount ) {
+    assert(getter != NULL);
+    assert(nodeCount != 0);
+
+    // nodes under construction, every node is owned by its parent after parent construction
+    EpNode **nodes = (EpNode **)calloc(nodeCount, sizeof(EpNode *));
+
+    if (nodes == NULL)
+        return NULL;
+
+    for (uint32_t i = 0; i < nodeCount; i++) {
+        EpFlatNode flatNode;
+        EpNode *node = NULL;
+
+        if (getter(context, i, &flatNode)) {
+            switch (flatNode.type) {
+            case EP_NODE_VARIABLE:
+                node = epNodeVariableSymbol(flatNode.variable);
+                break;
+
+            case EP_NODE_CONSTANT:
+                node = epNodeConstant(flatNode.constant);
+                break;
+
+            case EP_NODE_BINARY_OPERATOR:
+                assert(flatNode.binaryOperator.lhs < i && flatNode.binaryOperator.rhs < i);
+
+                node = epNodeBinaryOperator(
+                    flatNode.binaryOperator.op,
+                    nodes[flatNode.binaryOperator.lhs],
+                    nodes[flatNode.binaryOperator.rhs]
+                );
+                nodes[flatNode.binaryOperator.lhs] = NULL;
+                nodes[flatNode.binaryOperator.rhs] = NULL;
+                break;
+
+            case EP_NODE_UNARY_OPERATOR:
+                assert(flatNode.unaryOperator.operand < i);
+
+                node = epNodeUnaryOperator(flatNode.unaryOperator.op, nodes[flatNode.unaryOperator.operand]);
+                nodes[flatNode.unaryOperator.operand] = NULL;
+                break;
+            }
+        }
+
+        if (node == NULL) {
+            for (uint32_t j = 0; j < i; j++)
+                epNodeDtor(nodes[j]);
+            free(nodes);
+            return NULL;
+        }
+
+        nodes[i] = node;
+    }
+
+    EpNode *root = nodes[nodeCount - 1];
+    free(nodes);
+    return root;
+} // epNodeUnflatten
+
+// ep_flat.c
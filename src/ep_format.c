@@ -0,0 +1,342 @@
+/**
+ * @brief shortest round-trip double formatting (Grisu2) implementation file
+ */
+
+#include <assert.h>
+#include <math.h>
+#include <string.h>
+
+#include "ep.h"
+
+/// @brief 'do-it-yourself' floating point number (f * 2^e) representation structure
+typedef struct __EpDiyFp {
+    uint64_t f; ///< significand
+    int      e; ///< binary exponent
+} EpDiyFp;
+
+/// @brief double significand hidden bit
+#define EP_DIY_FP_HIDDEN_BIT ((uint64_t)1 << 52)
+
+/// @brief cached powers of ten (10^-348, 10^-340, ..., 10^340) with 64 bit normalized significands
+static const EpDiyFp epFormatCachedPowers[] = {
+    { 0xFA8FD5A0081C0288ull, -1220 }, { 0xBAAEE17FA23EBF76ull, -1193 }, { 0x8B16FB203055AC76ull, -1166 },
+    { 0xCF42894A5DCE35EAull, -1140 }, { 0x9A6BB0AA55653B2Dull, -1113 }, { 0xE61ACF033D1A45DFull, -1087 },
+    { 0xAB70FE17C79AC6CAull, -1060 }, { 0xFF77B1FCBEBCDC4Full, -1034 }, { 0xBE5691EF416BD60Cull, -1007 },
+    { 0x8DD01FAD907FFC3Cull,  -980 }, { 0xD3515C2831559A83ull,  -954 }, { 0x9D71AC8FADA6C9B5ull,  -927 },
+    { 0xEA9C227723EE8BCBull,  -901 }, { 0xAECC49914078536Dull,  -874 }, { 0x823C12795DB6CE57ull,  -847 },
+    { 0xC21094364DFB5637ull,  -821 }, { 0x9096EA6F3848984Full,  -794 }, { 0xD77485CB25823AC7ull,  -768 },
+    { 0xA086CFCD97BF97F4ull,  -741 }, { 0xEF340A98172AACE5ull,  -715 }, { 0xB23867FB2A35B28Eull,  -688 },
+    { 0x84C8D4DFD2C63F3Bull,  -661 }, { 0xC5DD44271AD3CDBAull,  -635 }, { 0x936B9FCEBB25C996ull,  -608 },
+    { 0xDBAC6C247D62A584ull,  -582 }, { 0xA3AB66580D5FDAF6ull,  -555 }, { 0xF3E2F893DEC3F126ull,  -529 },
+    { 0xB5B5ADA8AAFF80B8ull,  -502 }, { 0x87625F056C7C4A8Bull,  -475 }, { 0xC9BCFF6034C13053ull,  -449 },
+    { 0x964E858C91BA2655ull,  -422 }, { 0xDFF9772470297EBDull,  -396 }, { 0xA6DFBD9FB8E5B88Full,  -369 },
+    { 0xF8A95FCF88747D94ull,  -343 }, { 0xB94470938FA89BCFull,  -316 }, { 0x8A08F0F8BF0F156Bull,  -289 },
+    { 0xCDB02555653131B6ull,  -263 }, { 0x993FE2C6D07B7FACull,  -236 }, { 0xE45C10C42A2B3B06ull,  -210 },
+    { 0xAA242499697392D3ull,  -183 }, { 0xFD87B5F28300CA0Eull,  -157 }, { 0xBCE5086492111AEBull,  -130 },
+    { 0x8CBCCC096F5088CCull,  -103 }, { 0xD1B71758E219652Cull,   -77 }, { 0x9C40000000000000ull,   -50 },
+    { 0xE8D4A51000000000ull,   -24 }, { 0xAD78EBC5AC620000ull,     3 }, { 0x813F3978F8940984ull,    30 },
+    { 0xC097CE7BC90715B3ull,    56 }, { 0x8F7E32CE7BEA5C70ull,    83 }, { 0xD5D238A4ABE98068ull,   109 },
+    { 0x9F4F2726179A2245ull,   136 }, { 0xED63A231D4C4FB27ull,   162 }, { 0xB0DE65388CC8ADA8ull,   189 },
+    { 0x83C7088E1AAB65DBull,   216 }, { 0xC45D1DF942711D9Aull,   242 }, { 0x924D692CA61BE758ull,   269 },
+    { 0xDA01EE641A708DEAull,   295 }, { 0xA26DA3999AEF774Aull,   322 }, { 0xF209787BB47D6B85ull,   348 },
+    { 0xB454E4A179DD1877ull,   375 }, { 0x865B86925B9BC5C2ull,   402 }, { 0xC83553C5C8965D3Dull,   428 },
+    { 0x952AB45CFA97A0B3ull,   455 }, { 0xDE469FBD99A05FE3ull,   481 }, { 0xA59BC234DB398C25ull,   508 },
+    { 0xF6C69A72A3989F5Cull,   534 }, { 0xB7DCBF5354E9BECEull,   561 }, { 0x88FCF317F22241E2ull,   588 },
+    { 0xCC20CE9BD35C78A5ull,   614 }, { 0x98165AF37B2153DFull,   641 }, { 0xE2A0B5DC971F303Aull,   667 },
+    { 0xA8D9D1535CE3B396ull,   694 }, { 0xFB9B7CD9A4A7443Cull,   720 }, { 0xBB764C4CA7A44410ull,   747 },
+    { 0x8BAB8EEFB6409C1Aull,   774 }, { 0xD01FEF10A657842Cull,   800 }, { 0x9B10A4E5E9913129ull,   827 },
+    { 0xE7109BFBA19C0C9Dull,   853 }, { 0xAC2820D9623BF429ull,   880 }, { 0x80444B5E7AA7CF85ull,   907 },
+    { 0xBF21E44003ACDD2Dull,   933 }, { 0x8E679C2F5E44FF8Full,   960 }, { 0xD433179D9C8CB841ull,   986 },
+    { 0x9E19DB92B4E31BA9ull,  1013 }, { 0xEB96BF6EBADF77D9ull,  1039 }, { 0xAF87023B9BF0EE6Bull,  1066 },
+};
+
+/// @brief powers of ten that fit in uint32_t
+static const uint32_t epFormatPow10[] = {
+    1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u, 100000000u, 1000000000u,
+};
+
+/**
+ * @brief finite positive double to DiyFp conversion function
+ * 
+ * @param[in] value value (finite, positive)
+ * 
+ * @return value as DiyFp (not normalized)
+ */
+static EpDiyFp epDiyFpFromDouble( double value ) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    const int biasedExponent = (int)((bits >> 52) & 0x7FF);
+    const uint64_t significand = bits & (EP_DIY_FP_HIDDEN_BIT - 1);
+
+    return biasedExponent != 0
+        ? (EpDiyFp) { .f = significand + EP_DIY_FP_HIDDEN_BIT, .e = biasedExponent - 1075 }
+        : (EpDiyFp) { .f = significand, .e = 1 - 1075 };
+} // epDiyFpFromDouble
+
+/**
+ * @brief DiyFp multiplication function
+ * 
+ * @param[in] lhs left hand side
+ * @param[in] rhs right hand side
+ * 
+ * @return upper 64 bits of product (rounded)
+ */
+static EpDiyFp epDiyFpMul( EpDiyFp lhs, EpDiyFp rhs ) {
+    const uint64_t mask = 0xFFFFFFFFu;
+    const uint64_t a = lhs.f >> 32, b = lhs.f & mask;
+    const uint64_t c = rhs.f >> 32, d = rhs.f & mask;
+    const uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+
+    // middle 32 bit columns with rounding bit
+    const uint64_t middle = (bd >> 32) + (ad & mask) + (bc & mask) + ((uint64_t)1 << 31);
+
+    return (EpDiyFp) {
+        .f = ac + (ad >> 32) + (bc >> 32) + (middle >> 32),
+        .e = lhs.e + rhs.e + 64,
+    };
+} // epDiyFpMul
+
+/**
+ * @brief DiyFp normalization (significand highest bit setting) function
+ * 
+ * @param[in] value value to normalize (non-zero significand)
+ * 
+ * @return normalized value
+ */
+static EpDiyFp epDiyFpNormalize( EpDiyFp value ) {
+    while ((value.f & ((uint64_t)1 << 63)) == 0) {
+        value.f <<= 1;
+        value.e--;
+    }
+    return value;
+} // epDiyFpNormalize
+
+/**
+ * @brief cached power of ten getting function
+ * 
+ * @param[in]  e binary exponent of value to scale
+ * @param[out] k decimal exponent destination (power of ten is 10^-k)
+ * 
+ * @return power of ten that scales value with exponent e to [2^-60, 2^-32] exponent range
+ */
+static EpDiyFp epFormatGetCachedPower( int e, int *k ) {
+    const double dk = (-61 - e) * 0.30102999566398114 + 347;
+    int ik = (int)dk;
+
+    if (dk - ik > 0.0)
+        ik++;
+
+    const size_t index = (size_t)((ik >> 3) + 1);
+
+    *k = -(-348 + (int)(index << 3));
+    return epFormatCachedPowers[index];
+} // epFormatGetCachedPower
+
+/**
+ * @brief last generated digit rounding (towards value) function
+ * 
+ * @param[in,out] digits    generated digits
+ * @param[in]     length    count of digits
+ * @param[in]     delta     rounding interval width
+ * @param[in]     rest      distance from digits to upper boundary
+ * @param[in]     tenKappa  last digit unit
+ * @param[in]     distance  distance from value to upper boundary
+ */
+static void epFormatRound( char *digits, size_t length, uint64_t delta, uint64_t rest, uint64_t tenKappa, uint64_t distance ) {
+    while (true
+        && rest < distance
+        && delta - rest >= tenKappa
+        && (rest + tenKappa < distance || distance - rest > rest + tenKappa - distance)
+    ) {
+        digits[length - 1]--;
+        rest += tenKappa;
+    }
+} // epFormatRound
+
+/**
+ * @brief shortest digits of finite positive double generation function (Grisu2)
+ * 
+ * @param[in]  value    value to generate digits of (finite, positive)
+ * @param[out] digits   digits destination (at least 18 characters, not null-terminated)
+ * @param[out] exponent decimal exponent destination (value is digits * 10^exponent)
+ * 
+ * @note digits are always parsed back to the same value, and they are shortest for almost all values
+ * (rarely one digit longer, as Grisu2 doesn't check its imprecise results)
+ * 
+ * @return count of digits
+ */
+static size_t epFormatDigits( double value, char *digits, int *exponent ) {
+    const EpDiyFp v = epDiyFpFromDouble(value);
+
+    // value rounding interval boundaries, upper one is normalized so that two extra bits fit below significand
+    EpDiyFp upper = { .f = (v.f << 1) + 1, .e = v.e - 1 };
+
+    while ((upper.f & (EP_DIY_FP_HIDDEN_BIT << 1)) == 0) {
+        upper.f <<= 1;
+        upper.e--;
+    }
+    upper.f <<= 64 - 52 - 2;
+    upper.e -= 64 - 52 - 2;
+
+    // lower boundary is closer if value is power of two (interval is asymmetric)
+    EpDiyFp lower = v.f == EP_DIY_FP_HIDDEN_BIT
+        ? (EpDiyFp) { .f = (v.f << 2) - 1, .e = v.e - 2 }
+        : (EpDiyFp) { .f = (v.f << 1) - 1, .e = v.e - 1 };
+
+    lower.f <<= lower.e - upper.e;
+    lower.e = upper.e;
+
+    int k = 0;
+    const EpDiyFp power = epFormatGetCachedPower(upper.e, &k);
+    const EpDiyFp w = epDiyFpMul(epDiyFpNormalize(v), power);
+    EpDiyFp wPlus = epDiyFpMul(upper, power);
+    EpDiyFp wMinus = epDiyFpMul(lower, power);
+
+    // boundaries are shrinked by multiplication error, so any digits between them are parsed back to value
+    wMinus.f++;
+    wPlus.f--;
+
+    // generate digits of wPlus until they are inside of [wMinus, wPlus]
+    const EpDiyFp one = { .f = (uint64_t)1 << -wPlus.e, .e = wPlus.e };
+    const uint64_t distance = wPlus.f - w.f;
+    uint64_t delta = wPlus.f - wMinus.f;
+    uint32_t integral = (uint32_t)(wPlus.f >> -one.e);
+    uint64_t fraction = wPlus.f & (one.f - 1);
+    size_t length = 0;
+    int kappa = 1;
+
+    while (kappa < 10 && integral >= epFormatPow10[kappa])
+        kappa++;
+
+    while (kappa > 0) {
+        const uint32_t digit = integral / epFormatPow10[kappa - 1];
+
+        integral %= epFormatPow10[kappa - 1];
+        if (digit != 0 || length != 0)
+            digits[length++] = (char)('0' + digit);
+        kappa--;
+
+        const uint64_t rest = ((uint64_t)integral << -one.e) + fraction;
+
+        if (rest <= delta) {
+            *exponent = k + kappa;
+            epFormatRound(digits, length, delta, rest, (uint64_t)epFormatPow10[kappa] << -one.e, distance);
+            return length;
+        }
+    }
+
+    for (;;) {
+        fraction *= 10;
+        delta *= 10;
+
+        const char digit = (char)(fraction >> -one.e);
+
+        if (digit != 0 || length != 0)
+            digits[length++] = (char)('0' + digit);
+        fraction &= one.f - 1;
+        kappa--;
+
+        if (fraction < delta) {
+            *exponent = k + kappa;
+            epFormatRound(digits, length, delta, fraction, one.f, -kappa < 10 ? distance * epFormatPow10[-kappa] : 0);
+            return length;
+        }
+    }
+} // epFormatDigits
+
+/**
+ * @brief unsigned integer writing function
+ * 
+ * @param[out] dst   destination
+ * @param[in]  value value to write
+ * 
+ * @return count of written characters
+ */
+static size_t epFormatWriteUnsigned( char *dst, unsigned int value ) {
+    char text[16];
+    size_t length = 0;
+
+    do {
+        text[length++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+
+    for (size_t i = 0; i < length; i++)
+        dst[i] = text[length - 1 - i];
+    return length;
+} // epFormatWriteUnsigned
+
+size_t epDoubleFormat( double value, char *dst ) {
+    assert(dst != NULL);
+
+    size_t length = 0;
+
+    if (isnan(value)) {
+        memcpy(dst, "nan", 4);
+        return 3;
+    }
+
+    if (signbit(value))
+        dst[length++] = '-';
+
+    if (isinf(value)) {
+        memcpy(dst + length, "inf", 4);
+        return length + 3;
+    }
+
+    if (value == 0.0) {
+        memcpy(dst + length, "0", 2);
+        return length + 1;
+    }
+
+    char digits[20];
+    int exponent = 0;
+    const int digitCount = (int)epFormatDigits(fabs(value), digits, &exponent);
+
+    // decimal point position relative to digits start (value is 0.digits * 10^point)
+    const int point = digitCount + exponent;
+
+    if (digitCount <= point && point <= 21) {
+        // integer: digits and trailing zeros
+        memcpy(dst + length, digits, (size_t)digitCount);
+        length += (size_t)digitCount;
+        for (int i = digitCount; i < point; i++)
+            dst[length++] = '0';
+    } else if (0 < point && point <= 21) {
+        // point inside of digits
+        memcpy(dst + length, digits, (size_t)point);
+        length += (size_t)point;
+        dst[length++] = '.';
+        memcpy(dst + length, digits + point, (size_t)(digitCount - point));
+        length += (size_t)(digitCount - point);
+    } else if (-6 < point && point <= 0) {
+        // leading zeros after point
+        dst[length++] = '0';
+        dst[length++] = '.';
+        for (int i = point; i < 0; i++)
+            dst[length++] = '0';
+        memcpy(dst + length, digits, (size_t)digitCount);
+        length += (size_t)digitCount;
+    } else {
+        // exponential form (d.ddde[-]x)
+        dst[length++] = digits[0];
+        if (digitCount > 1) {
+            dst[length++] = '.';
+            memcpy(dst + length, digits + 1, (size_t)(digitCount - 1));
+            length += (size_t)(digitCount - 1);
+        }
+
+        const int decimalExponent = point - 1;
+
+        dst[length++] = 'e';
+        if (decimalExponent < 0)
+            dst[length++] = '-';
+        length += epFormatWriteUnsigned(dst + length, (unsigned int)abs(decimalExponent));
+    }
+
+    dst[length] = '\0';
+    return length;
+} // epDoubleFormat
+
+// ep_format.c
@@ -0,0 +1,613 @@
+/**
+ * @brief binary image (serialization) format implementation file
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "ep_internal.h"
+
+/// @brief byte order mark value
+#define EP_IMAGE_BYTE_ORDER_MARK ((uint32_t)0x01020304)
+
+/// @brief image pool lookup table slot representation structure
+typedef struct __EpImageSlot {
+    uint64_t hash;  ///< key hash
+    uint32_t index; ///< pool element index + 1 (0 if slot is empty)
+} EpImageSlot;
+
+/// @brief image pool lookup table representation structure
+typedef struct __EpImageTable {
+    EpImageSlot * slots;    ///< slots (open addressing)
+    size_t        capacity; ///< count of slots (power of 2)
+    size_t        count;    ///< count of occupied slots
+} EpImageTable;
+
+/// @brief image writer representation structure
+typedef struct __EpImageWriter {
+    EpImageNode  * nodes;            ///< node array
+    size_t         nodeCount;        ///< count of nodes
+    size_t         nodeCapacity;     ///< node array capacity
+
+    double       * constants;        ///< constant pool
+    size_t         constantCount;    ///< count of constants
+    size_t         constantCapacity; ///< constant pool capacity
+    EpImageTable   constantTable;    ///< constant lookup table
+
+    uint32_t     * offsets;          ///< variable name offsets
+    size_t         offsetCount;      ///< count of offsets
+    size_t         offsetCapacity;   ///< offset array capacity
+    char         * names;            ///< variable name storage
+    size_t         nameSize;         ///< name storage size
+    size_t         nameCapacity;     ///< name storage capacity
+    EpImageTable   variableTable;    ///< variable lookup table
+} EpImageWriter;
+
+/**
+ * @brief 64-bit hash finalizer (splitmix64)
+ * 
+ * @param[in] value value to hash
+ * 
+ * @return hash
+ */
+static uint64_t epImageHash( uint64_t value ) {
+    value ^= value >> 30;
+    value *= 0xBF58476D1CE4E5B9ull;
+    value ^= value >> 27;
+    value *= 0x94D049BB133111EBull;
+    value ^= value >> 31;
+    return value;
+} // epImageHash
+
+/**
+ * @brief lookup table insertion slot finding function
+ * 
+ * @param[in,out] table table (non-null)
+ * @param[in]     hash  key hash
+ * @param[in,out] probe probing state (0 for first call)
+ * 
+ * @return slot with same hash or empty slot
+ */
+static EpImageSlot * epImageTableProbe( EpImageTable *table, uint64_t hash, size_t *probe ) {
+    const size_t mask = table->capacity - 1;
+
+    for (;;) {
+        EpImageSlot *slot = &table->slots[(hash + *probe) & mask];
+        (*probe)++;
+
+        if (slot->index == 0 || slot->hash == hash)
+            return slot;
+    }
+} // epImageTableProbe
+
+/**
+ * @brief lookup table growing function
+ * 
+ * @param[in,out] table table (non-null)
+ * 
+ * @return true if table has space for one more element, false if allocation failed
+ */
+static bool epImageTableGrow( EpImageTable *table ) {
+    if ((table->count + 1) * 2 <= table->capacity)
+        return true;
+
+    EpImageTable newTable = {
+        .slots = NULL,
+        .capacity = table->capacity == 0 ? 64 : table->capacity * 2,
+        .count = table->count,
+    };
+
+    newTable.slots = (EpImageSlot *)calloc(newTable.capacity, sizeof(EpImageSlot));
+
+    if (newTable.slots == NULL)
+        return false;
+
+    for (size_t i = 0; i < table->capacity; i++)
+        if (table->slots[i].index != 0) {
+            const size_t mask = newTable.capacity - 1;
+            size_t position = table->slots[i].hash & mask;
+
+            while (newTable.slots[position].index != 0)
+                position = (position + 1) & mask;
+            newTable.slots[position] = table->slots[i];
+        }
+
+    free(table->slots);
+    *table = newTable;
+    return true;
+} // epImageTableGrow
+
+/**
+ * @brief constant interning function
+ * 
+ * @param[in,out] writer   writer (non-null)
+ * @param[in]     constant constant to intern
+ * @param[out]    dst      constant index destination (non-null)
+ * 
+ * @note constants are compared bitwise, so image stores them exactly
+ * 
+ * @return true if succeeded, false if allocation failed
+ */
+static bool epImageInternConstant( EpImageWriter *writer, double constant, uint32_t *dst ) {
+    uint64_t bits;
+    memcpy(&bits, &constant, sizeof(bits));
+
+    if (!epImageTableGrow(&writer->constantTable))
+        return false;
+
+    const uint64_t hash = epImageHash(bits);
+    size_t probe = 0;
+
+    for (;;) {
+        EpImageSlot *slot = epImageTableProbe(&writer->constantTable, hash, &probe);
+
+        if (slot->index == 0) {
+            if (!epArrayReserve((void **)&writer->constants, &writer->constantCapacity, writer->constantCount + 1, sizeof(double)))
+                return false;
+
+            writer->constants[writer->constantCount++] = constant;
+            *slot = (EpImageSlot) { .hash = hash, .index = (uint32_t)writer->constantCount };
+            writer->constantTable.count++;
+            *dst = slot->index - 1;
+            return true;
+        }
+
+        if (memcmp(&writer->constants[slot->index - 1], &constant, sizeof(double)) == 0) {
+            *dst = slot->index - 1;
+            return true;
+        }
+    }
+} // epImageInternConstant
+
+/**
+ * @brief variable interning function
+ * 
+ * @param[in,out] writer writer (non-null)
+ * @param[in]     name   variable name (non-null)
+ * @param[out]    dst    variable index destination (non-null)
+ * 
+ * @return true if succeeded, false if allocation failed
+ */
+static bool epImageInternVariable( EpImageWriter *writer, const char *name, uint32_t *dst ) {
+    const size_t length = strlen(name);
+    uint64_t hash = 0xCBF29CE484222325ull;
+
+    // FNV-1a
+    for (size_t i = 0; i < length; i++)
+        hash = (hash ^ (uint8_t)name[i]) * 0x100000001B3ull;
+
+    if (!epImageTableGrow(&writer->variableTable))
+        return false;
+
+    size_t probe = 0;
+
+    for (;;) {
+        EpImageSlot *slot = epImageTableProbe(&writer->variableTable, hash, &probe);
+
+        if (slot->index == 0) {
+            if (false
+                || !epArrayReserve((void **)&writer->offsets, &writer->offsetCapacity, writer->offsetCount + 2, sizeof(uint32_t))
+                || !epArrayReserve((void **)&writer->names, &writer->nameCapacity, writer->nameSize + length + 1, sizeof(char))
+            )
+                return false;
+
+            if (writer->offsetCount == 0)
+                writer->offsets[writer->offsetCount++] = 0;
+
+            memcpy(writer->names + writer->nameSize, name, length + 1);
+            writer->nameSize += length + 1;
+            writer->offsets[writer->offsetCount++] = (uint32_t)writer->nameSize;
+
+            *slot = (EpImageSlot) { .hash = hash, .index = (uint32_t)writer->offsetCount - 1 };
+            writer->variableTable.count++;
+            *dst = slot->index - 1;
+            return true;
+        }
+
+        if (strcmp(writer->names + writer->offsets[slot->index - 1], name) == 0) {
+            *dst = slot->index - 1;
+            return true;
+        }
+    }
+} // epImageInternVariable
+
+/**
+ * @brief writer destructor
+ * 
+ * @param[in] writer writer to destroy (non-null)
+ */
+static void epImageWriterDtor( EpImageWriter *writer ) {
+    free(writer->nodes);
+    free(writer->constants);
+    free(writer->constantTable.slots);
+    free(writer->offsets);
+    free(writer->names);
+    free(writer->variableTable.slots);
+} // epImageWriterDtor
+
+/**
+ * @brief flat node to image appending function (EpFlatNodeVisitor)
+ * 
+ * @param[in,out] context writer (non-null)
+ * @param[in]     node    flat node (non-null)
+ * 
+ * @return true if appended, false if allocation failed
+ */
+static bool epImageWriterAppend( void *context, const EpFlatNode *node ) {
+    EpImageWriter *writer = (EpImageWriter *)context;
+    EpImageNode imageNode = {
+        .type = (uint8_t)node->type,
+        .op = 0,
+        .reserved = 0,
+        .lhs = 0,
+        .rhs = 0,
+    };
+
+    switch (node->type) {
+    case EP_NODE_VARIABLE:
+        if (!epImageInternVariable(writer, epSymbolName(node->variable), &imageNode.lhs))
+            return false;
+        break;
+
+    case EP_NODE_CONSTANT:
+        if (!epImageInternConstant(writer, node->constant, &imageNode.lhs))
+            return false;
+        break;
+
+    case EP_NODE_BINARY_OPERATOR:
+        imageNode.op = (uint8_t)node->binaryOperator.op;
+        imageNode.lhs = node->binaryOperator.lhs;
+        imageNode.rhs = node->binaryOperator.rhs;
+        break;
+
+    case EP_NODE_UNARY_OPERATOR:
+        imageNode.op = (uint8_t)node->unaryOperator.op;
+        imageNode.lhs = node->unaryOperator.operand;
+        break;
+    }
+
+    if (!epArrayReserve((void **)&writer->nodes, &writer->nodeCapacity, writer->nodeCount + 1, sizeof(EpImageNode)))
+        return false;
+
+    writer->nodes[writer->nodeCount++] = imageNode;
+    return true;
+} // epImageWriterAppend
+
+bool epImageWrite( FILE *out, const EpNode *node ) {
+    assert(out != NULL);
+    assert(node != NULL);
+
+    EpImageWriter writer = {};
+
+    if (!epNodeFlatten(node, epImageWriterAppend, &writer)) {
+        epImageWriterDtor(&writer);
+        return false;
+    }
+
+    const uint32_t variableCount = writer.offsetCount == 0 ? 0 : (uint32_t)writer.offsetCount - 1;
+    EpImageHeader header = {
+        .magic = {EP_IMAGE_MAGIC[0], EP_IMAGE_MAGIC[1], EP_IMAGE_MAGIC[2], EP_IMAGE_MAGIC[3]},
+        .version = EP_IMAGE_VERSION,
+        .byteOrderMark = EP_IMAGE_BYTE_ORDER_MARK,
+        .nodeCount = (uint32_t)writer.nodeCount,
+        .constantCount = (uint32_t)writer.constantCount,
+        .variableCount = variableCount,
+        .nameStorageSize = (uint32_t)writer.nameSize,
+        .reserved = 0,
+    };
+    const uint32_t emptyOffset = 0;
+
+    bool written = true
+        && fwrite(&header, sizeof(header), 1, out) == 1
+        && fwrite(writer.constants, sizeof(double), writer.constantCount, out) == writer.constantCount
+        && fwrite(writer.nodes, sizeof(EpImageNode), writer.nodeCount, out) == writer.nodeCount
+        && (variableCount == 0
+            ? fwrite(&emptyOffset, sizeof(uint32_t), 1, out) == 1
+            : fwrite(writer.offsets, sizeof(uint32_t), writer.offsetCount, out) == writer.offsetCount
+        )
+        && fwrite(writer.names, sizeof(char), writer.nameSize, out) == writer.nameSize
+    ;
+
+    epImageWriterDtor(&writer);
+    return written;
+} // epImageWrite
+
+EpImageStatus epImageFromMemory( const void *data, size_t size, EpImage *dst ) {
+    assert(data != NULL || size == 0);
+    assert(dst != NULL);
+
+    const char *bytes = (const char *)data;
+    EpImageHeader header;
+
+    if (size < sizeof(header))
+        return EP_IMAGE_INVALID_HEADER;
+
+    memcpy(&header, bytes, sizeof(header));
+
+    if (false
+        || memcmp(header.magic, EP_IMAGE_MAGIC, sizeof(header.magic)) != 0
+        || header.version != EP_IMAGE_VERSION
+        || header.byteOrderMark != EP_IMAGE_BYTE_ORDER_MARK
+        || (size_t)bytes % sizeof(double) != 0
+    )
+        return EP_IMAGE_INVALID_HEADER;
+
+    // check sizes (64-bit arithmetic can't overflow on 32-bit counts)
+    const uint64_t constantOffset = sizeof(EpImageHeader);
+    const uint64_t nodeOffset = constantOffset + (uint64_t)header.constantCount * sizeof(double);
+    const uint64_t variableOffset = nodeOffset + (uint64_t)header.nodeCount * sizeof(EpImageNode);
+    const uint64_t nameOffset = variableOffset + ((uint64_t)header.variableCount + 1) * sizeof(uint32_t);
+    const uint64_t totalSize = nameOffset + header.nameStorageSize;
+
+    if (totalSize > size)
+        return EP_IMAGE_INVALID_CONTENTS;
+
+    EpImage image = {
+        .nodes = (const EpImageNode *)(bytes + nodeOffset),
+        .nodeCount = header.nodeCount,
+        .constants = (const double *)(bytes + constantOffset),
+        .constantCount = header.constantCount,
+        .variableOffsets = (const uint32_t *)(bytes + variableOffset),
+        .variableNames = bytes + nameOffset,
+        .variableCount = header.variableCount,
+        .mapping = NULL,
+        .mappingSize = 0,
+    };
+
+    // validate variable table
+    if (image.variableOffsets[0] != 0)
+        return EP_IMAGE_INVALID_CONTENTS;
+
+    for (uint32_t i = 0; i < image.variableCount; i++) {
+        uint32_t begin = image.variableOffsets[i];
+        uint32_t end = image.variableOffsets[i + 1];
+
+        if (end <= begin || end > header.nameStorageSize || image.variableNames[end - 1] != '\0')
+            return EP_IMAGE_INVALID_CONTENTS;
+    }
+
+    // count of parents of every node, tree requires exactly one for every node except the root
+    uint8_t *useCounts = (uint8_t *)calloc(image.nodeCount == 0 ? 1 : image.nodeCount, sizeof(uint8_t));
+
+    if (useCounts == NULL)
+        return EP_IMAGE_INTERNAL_ERROR;
+
+    EpImageStatus status = EP_IMAGE_OK;
+
+    // validate nodes, postorder requires all children to precede parent
+    for (uint32_t i = 0; i < image.nodeCount && status == EP_IMAGE_OK; i++) {
+        const EpImageNode *node = &image.nodes[i];
+        bool valid = false;
+
+        switch ((EpNodeType)node->type) {
+        case EP_NODE_VARIABLE:
+            valid = node->lhs < image.variableCount;
+            break;
+
+        case EP_NODE_CONSTANT:
+            valid = node->lhs < image.constantCount;
+            break;
+
+        case EP_NODE_BINARY_OPERATOR:
+            valid = node->op <= EP_BINARY_OPERATOR_POWI && node->lhs < i && node->rhs < i && node->lhs != node->rhs
+                && useCounts[node->lhs]++ == 0
+                && useCounts[node->rhs]++ == 0;
+            break;
+
+        case EP_NODE_UNARY_OPERATOR:
+            valid = node->op <= EP_UNARY_OPERATOR_SQRT && node->lhs < i
+                && useCounts[node->lhs]++ == 0;
+            break;
+        }
+
+        if (!valid)
+            status = EP_IMAGE_INVALID_CONTENTS;
+    }
+
+    // the root (last node) is never referenced, as children precede parents, so every other node must be referenced once
+    for (uint32_t i = 0; i + 1 < image.nodeCount && status == EP_IMAGE_OK; i++)
+        if (useCounts[i] != 1)
+            status = EP_IMAGE_INVALID_CONTENTS;
+
+    free(useCounts);
+
+    if (status == EP_IMAGE_OK)
+        *dst = image;
+    return status;
+} // epImageFromMemory
+
+EpImageStatus epImageOpen( const char *path, EpImage *dst ) {
+    assert(path != NULL);
+    assert(dst != NULL);
+
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0)
+        return EP_IMAGE_OPEN_FAILED;
+
+    struct stat fileStat;
+
+    if (fstat(fd, &fileStat) != 0) {
+        close(fd);
+        return EP_IMAGE_OPEN_FAILED;
+    }
+
+    if (fileStat.st_size == 0) {
+        close(fd);
+        return EP_IMAGE_INVALID_HEADER;
+    }
+
+    void *mapping = mmap(NULL, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    // mapping stays valid after descriptor closing
+    close(fd);
+
+    if (mapping == MAP_FAILED)
+        return EP_IMAGE_OPEN_FAILED;
+
+    EpImageStatus status = epImageFromMemory(mapping, (size_t)fileStat.st_size, dst);
+
+    if (status != EP_IMAGE_OK) {
+        munmap(mapping, (size_t)fileStat.st_size);
+        return status;
+    }
+
+    dst->mapping = mapping;
+    dst->mappingSize = (size_t)fileStat.st_size;
+    return EP_IMAGE_OK;
+} // epImageOpen
+
+void epImageClose( EpImage *image ) {
+    if (image == NULL)
+        return;
+
+    if (image->mapping != NULL)
+        munmap(image->mapping, image->mappingSize);
+
+    *image = (EpImage) {};
+} // epImageClose
+
+const char * epImageGetVariableName( const EpImage *image, uint32_t index ) {
+    assert(image != NULL);
+    assert(index < image->variableCount);
+
+    return image->variableNames + image->variableOffsets[index];
+} // epImageGetVariableName
+
+/**
+ * @brief image node to flat node conversion function (EpFlatNodeGetter)
+ * 
+ * @param[in]  context image (non-null)
+ * @param[in]  index   node index
+ * @param[out] dst     flat node destination (non-null)
+ * 
+ * @return true if converted, false if variable name interning failed
+ */
+static bool epImageGetFlatNode( const void *context, uint32_t index, EpFlatNode *dst ) {
+    const EpImage *image = (const EpImage *)context;
+    const EpImageNode *imageNode = &image->nodes[index];
+
+    dst->type = (EpNodeType)imageNode->type;
+
+    switch (dst->type) {
+    case EP_NODE_VARIABLE:
+        dst->variable = epSymbolIntern(epImageGetVariableName(image, imageNode->lhs));
+        return dst->variable != EP_SYMBOL_INVALID;
+
+    case EP_NODE_CONSTANT:
+        dst->constant = image->constants[imageNode->lhs];
+        break;
+
+    case EP_NODE_BINARY_OPERATOR:
+        dst->binaryOperator.op = (EpBinaryOperator)imageNode->op;
+        dst->binaryOperator.lhs = imageNode->lhs;
+        dst->binaryOperator.rhs = imageNode->rhs;
+        break;
+
+    case EP_NODE_UNARY_OPERATOR:
+        dst->unaryOperator.op = (EpUnaryOperator)imageNode->op;
+        dst->unaryOperator.operand = imageNode->lhs;
+        break;
+    }
+
+    return true;
+} // epImageGetFlatNode
+
+EpNode * epImageToNode( const EpImage *image ) {
+    assert(image != NULL);
+
+    if (image->nodeCount == 0)
+        return NULL;
+
+    return epNodeUnflatten(epImageGetFlatNode, image, image->nodeCount);
+} // epImageToNode
+
+EpNodeComputeResult epImageCompute(
+    const EpImage    * image,
+    const EpVariable * variables,
+    size_t             variableCount
+) {
+    assert(image != NULL && image->nodeCount != 0);
+    assert(variableCount == 0 || (variableCount != 0 && variables != NULL));
+
+    // node values and resolved image variables (null if variable is unknown)
+    double localValues[64];
+    const EpVariable *localResolved[16];
+    double *values = image->nodeCount <= sizeof(localValues) / sizeof(localValues[0])
+        ? localValues
+        : (double *)calloc(image->nodeCount, sizeof(double));
+    const EpVariable **resolved = image->variableCount <= sizeof(localResolved) / sizeof(localResolved[0])
+        ? localResolved
+        : (const EpVariable **)calloc(image->variableCount, sizeof(const EpVariable *));
+
+    EpNodeComputeResult result = { .status = EP_NODE_COMPUTE_OK, .ok = 0.0 };
+
+    if (values == NULL || resolved == NULL) {
+        result = (EpNodeComputeResult) {
+            .status = EP_NODE_COMPUTE_INTERNAL_ERROR,
+            .unknownVariable = NULL,
+        };
+        goto __epImageCompute__end;
+    }
+
+    // resolve image variables once
+    for (uint32_t i = 0; i < image->variableCount; i++) {
+        const char *name = epImageGetVariableName(image, i);
+        size_t j = 0;
+
+        while (j < variableCount && strcmp(variables[j].name, name) != 0)
+            j++;
+
+        // variable is unknown, but it's not an error if it's not used
+        resolved[i] = j < variableCount
+            ? &variables[j]
+            : NULL;
+    }
+
+    for (uint32_t i = 0; i < image->nodeCount; i++) {
+        const EpImageNode *node = &image->nodes[i];
+
+        switch ((EpNodeType)node->type) {
+        case EP_NODE_VARIABLE: {
+            if (resolved[node->lhs] == NULL) {
+                result = (EpNodeComputeResult) {
+                    .status = EP_NODE_COMPUTE_UNKNOWN_VARIABLE,
+                    .unknownVariable = epImageGetVariableName(image, node->lhs),
+                };
+                goto __epImageCompute__end;
+            }
+
+            values[i] = resolved[node->lhs]->value;
+            break;
+        }
+
+        case EP_NODE_CONSTANT:
+            values[i] = image->constants[node->lhs];
+            break;
+
+        case EP_NODE_BINARY_OPERATOR:
+            values[i] = epBinaryOperatorApply((EpBinaryOperator)node->op, values[node->lhs], values[node->rhs]);
+            break;
+
+        case EP_NODE_UNARY_OPERATOR:
+            values[i] = epUnaryOperatorApply((EpUnaryOperator)node->op, values[node->lhs]);
+            break;
+        }
+    }
+
+    result.ok = values[image->nodeCount - 1];
+
+__epImageCompute__end:
+    if (values != localValues)
+        free(values);
+    if (resolved != localResolved)
+        free(resolved);
+    return result;
+} // epImageCompute
+
+// ep_image.c
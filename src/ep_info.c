@@ -4,127 +4,340 @@
 
 #include <string.h>
 #include <assert.h>
+#include <math.h>
+#include <stdlib.h>
 
-#include "ep.h"
+#include "ep_internal.h"
+
+/// @brief plot domain minimum (same as pgfplots default domain)
+#define EP_INFO_PLOT_MIN (-5.0)
+
+/// @brief plot domain maximum
+#define EP_INFO_PLOT_MAX 5.0
+
+/// @brief count of uniform grid cells curve is computed at before refinement
+#define EP_INFO_PLOT_GRID_SIZE ((size_t)64)
+
+/// @brief maximal count of grid cell halvings
+#define EP_INFO_PLOT_MAX_DEPTH 8
+
+/// @brief maximal distance between curve and its polyline, relative to curve value span
+#define EP_INFO_PLOT_TOLERANCE 1e-3
+
+/// @brief maximal distance between value and curve center, relative to curve value span (farther values aren't drawn)
+#define EP_INFO_PLOT_CLIP 20.0
+
+/// @brief curve sampling context representation structure
+typedef struct __EpInfoPlotContext {
+    FILE             * out;       ///< output file
+    const EpNodePool * pool;      ///< compiled curve function
+    EpVariable         variable;  ///< curve parameter
+    double             center;    ///< curve value center
+    double             span;      ///< curve value span
+    double             tolerance; ///< maximal polyline deviation
+    bool               broken;    ///< line is already broken (last written point is nan)
+} EpInfoPlotContext;
 
 /**
- * @brief expression-friendly operator
+ * @brief double comparator for qsort
  * 
- * @param[in] out  output file
- * @param[in] node node to display
+ * @param[in] lhs left hand side pointer
+ * @param[in] rhs right hand side pointer
+ * 
+ * @return comparison result
  */
-static void epNodeInfoDumpNode( FILE *out, const EpNode *node ) {
-    switch (node->type) {
-    case EP_NODE_VARIABLE: {
-        fprintf(out, "%s", node->variable);
-        break;
+static int epInfoPlotCompareDouble( const void *lhs, const void *rhs ) {
+    const double l = *(const double *)lhs;
+    const double r = *(const double *)rhs;
+
+    return (l > r) - (l < r);
+} // epInfoPlotCompareDouble
+
+/**
+ * @brief curve value computation function
+ * 
+ * @param[in,out] context sampling context
+ * @param[in]     t       parameter value
+ * 
+ * @return curve value (NaN if undefined)
+ */
+static double epInfoPlotCompute( EpInfoPlotContext *context, double t ) {
+    context->variable.value = t;
+
+    EpNodeComputeResult result = epNodePoolCompute(context->pool, &context->variable, 1);
+
+    return result.status == EP_NODE_COMPUTE_OK
+        ? result.ok
+        : NAN;
+} // epInfoPlotCompute
+
+/**
+ * @brief curve point writing function
+ * 
+ * @param[in,out] context sampling context
+ * @param[in]     t       parameter value
+ * @param[in]     y       curve value
+ * 
+ * @note undefined and far values are written as single nan per run, so pgfplots breaks line on them
+ */
+static void epInfoPlotPoint( EpInfoPlotContext *context, double t, double y ) {
+    if (isfinite(y) && fabs(y - context->center) <= EP_INFO_PLOT_CLIP * context->span) {
+        fprintf(context->out, "%.6g %.6g\n", t, y);
+        context->broken = false;
+    } else if (!context->broken) {
+        fprintf(context->out, "%.6g nan\n", t);
+        context->broken = true;
     }
-    case EP_NODE_CONSTANT: {
-        fprintf(out, "%lf", node->constant);
-        break;
+} // epInfoPlotPoint
+
+/**
+ * @brief curve segment adaptive refinement function
+ * 
+ * @param[in,out] context sampling context
+ * @param[in]     t0      segment start
+ * @param[in]     y0      value at segment start
+ * @param[in]     t1      segment end
+ * @param[in]     y1      value at segment end
+ * @param[in]     depth   count of halvings left
+ * 
+ * @note points of (t0, t1] are written, segment is halved while its midpoint is far from chord
+ */
+static void epInfoPlotRefine( EpInfoPlotContext *context, double t0, double y0, double t1, double y1, int depth ) {
+    const double tm = (t0 + t1) / 2.0;
+    const double ym = epInfoPlotCompute(context, tm);
+    const bool finite0 = isfinite(y0), finiteM = isfinite(ym), finite1 = isfinite(y1);
+
+    // domain edges are located by halving too
+    const bool refine = finite0 && finiteM && finite1
+        ? fabs(ym - (y0 + y1) / 2.0) > context->tolerance
+        : finite0 != finiteM || finiteM != finite1;
+
+    if (refine && depth > 0) {
+        epInfoPlotRefine(context, t0, y0, tm, ym, depth - 1);
+        epInfoPlotRefine(context, tm, ym, t1, y1, depth - 1);
+        return;
+    }
+
+    // jump bigger than whole curve on finest segment is discontinuity (pole), so line is broken on it
+    if (refine && finite0 && finite1 && fabs(y1 - y0) > context->span)
+        epInfoPlotPoint(context, tm, NAN);
+    else
+        epInfoPlotPoint(context, tm, ym);
+    epInfoPlotPoint(context, t1, y1);
+} // epInfoPlotRefine
+
+/**
+ * @brief curve as pgfplots coordinate table writing function
+ * 
+ * @param[in] out     output file
+ * @param[in] node    curve function (non-null)
+ * @param[in] param   curve parameter name (non-null)
+ * @param[in] options pgfplots plot options
+ * 
+ * @note curve is computed here and not by pgfplots, so TeX doesn't evaluate expressions at every sample
+ */
+static void epInfoPlot( FILE *out, const EpNode *node, const char *param, const char *options ) {
+    EpNodePool *pool = epNodePoolFromNode(node);
+    double grid[EP_INFO_PLOT_GRID_SIZE + 1];
+    double values[EP_INFO_PLOT_GRID_SIZE + 1];
+    double sorted[EP_INFO_PLOT_GRID_SIZE + 1];
+    size_t finiteCount = 0;
+
+    if (pool == NULL)
+        return;
+
+    for (size_t i = 0; i <= EP_INFO_PLOT_GRID_SIZE; i++)
+        grid[i] = EP_INFO_PLOT_MIN + (EP_INFO_PLOT_MAX - EP_INFO_PLOT_MIN) * (double)i / (double)EP_INFO_PLOT_GRID_SIZE;
+
+    const EpBatchVariable variable = { .name = param, .values = grid };
+
+    if (epNodePoolComputeBatch(pool, &variable, 1, EP_INFO_PLOT_GRID_SIZE + 1, values).status != EP_NODE_COMPUTE_OK) {
+        epNodePoolDtor(pool);
+        return;
     }
-    case EP_NODE_BINARY_OPERATOR: {
-        fprintf(out, "(");
-        epNodeInfoDumpNode(out, node->binaryOperator.lhs);
-        fprintf(out, "%s", epBinaryOperatorStr(node->binaryOperator.op));
-        epNodeInfoDumpNode(out, node->binaryOperator.rhs);
-        fprintf(out, ")");
-        break;
+
+    // value span is taken between deciles, so tolerance doesn't depend on values near poles
+    for (size_t i = 0; i <= EP_INFO_PLOT_GRID_SIZE; i++)
+        if (isfinite(values[i]))
+            sorted[finiteCount++] = values[i];
+
+    EpInfoPlotContext context = {
+        .out = out,
+        .pool = pool,
+        .variable = { .name = param, .value = 0.0 },
+        .center = 0.0,
+        .span = 1.0,
+        .tolerance = EP_INFO_PLOT_TOLERANCE,
+        .broken = true,
+    };
+
+    if (finiteCount != 0) {
+        qsort(sorted, finiteCount, sizeof(double), epInfoPlotCompareDouble);
+
+        const double lo = sorted[finiteCount / 10];
+        const double hi = sorted[finiteCount - 1 - finiteCount / 10];
+
+        context.center = (lo + hi) / 2.0;
+        context.span = hi - lo > 0.0 ? hi - lo : fmax(fabs(context.center), 1.0);
     }
+    context.tolerance = context.span * EP_INFO_PLOT_TOLERANCE;
 
-    case EP_NODE_UNARY_OPERATOR: {
-        fprintf(out, "(");
-
-        const char *str = epUnaryOperatorStr(node->unaryOperator.op);
-
-        switch (node->unaryOperator.op) {
-        case EP_UNARY_OPERATOR_NEG:
-        case EP_UNARY_OPERATOR_LN:
-            fprintf(out, "%s(", str);
-            epNodeInfoDumpNode(out, node->unaryOperator.operand);
-            fprintf(out, ")");
-            break;
-
-        case EP_UNARY_OPERATOR_SIN:
-        case EP_UNARY_OPERATOR_COS:
-        case EP_UNARY_OPERATOR_TAN:
-        case EP_UNARY_OPERATOR_COT:
-            fprintf(out, "%s(deg(", str);
-            epNodeInfoDumpNode(out, node->unaryOperator.operand);
-            fprintf(out, "))");
-            break;
-
-        case EP_UNARY_OPERATOR_ASIN:
-        case EP_UNARY_OPERATOR_ACOS:
-        case EP_UNARY_OPERATOR_ATAN:
-        case EP_UNARY_OPERATOR_ACOT:
-            fprintf(out, "rad(%s(", str);
-            epNodeInfoDumpNode(out, node->unaryOperator.operand);
-            fprintf(out, "))");
-            break;
-        }
+    fprintf(out, "\\addplot [%s, unbounded coords = jump] table {\n", options);
+    fprintf(out, "t y\n");
+    epInfoPlotPoint(&context, grid[0], values[0]);
+    for (size_t i = 0; i < EP_INFO_PLOT_GRID_SIZE; i++)
+        epInfoPlotRefine(&context, grid[i], values[i], grid[i + 1], values[i + 1], EP_INFO_PLOT_MAX_DEPTH);
+    fprintf(out, "};\n");
+
+    epNodePoolDtor(pool);
+} // epInfoPlot
+
+/// @brief function info section generation context representation structure
+typedef struct __EpInfoSectionContext {
+    const EpNode   * node;           ///< optimized function
+    const EpNode   * zero;           ///< zero constant (taylor expansion point)
+    const EpSymbol * parameters;     ///< function parameters
+    size_t           parameterCount; ///< count of function parameters
 
-        fprintf(out, ")");
-        break;
+    char          ** texts;          ///< section texts (NULL if section generation failed)
+    size_t         * textSizes;      ///< section text sizes
+} EpInfoSectionContext;
+
+/**
+ * @brief function by single parameter exploration section generation function
+ * 
+ * @param[in] out     output file
+ * @param[in] context section generation context (non-null)
+ * @param[in] index   index of parameter to explore function by
+ */
+static void epNodeGenNodeFunctionInfoSection( FILE *out, const EpInfoSectionContext *context, size_t index ) {
+    const EpNode *nodeOptimized = context->node;
+    const EpSymbol *parameters = context->parameters;
+    const size_t parameterCount = context->parameterCount;
+
+    epTraceBegin("info section", "parameter", index, NULL);
+
+    // bind constants to all parameters except current one
+    EpVariable *bindings = (EpVariable *)malloc(parameterCount * sizeof(EpVariable));
+    size_t bindingCount = 0;
+    const double bindingValue = 2.5;
+
+    if (bindings != NULL)
+        for (size_t j = 0; j < parameterCount; j++)
+            if (index != j)
+                bindings[bindingCount++] = (EpVariable) {
+                    .name = epSymbolName(parameters[j]),
+                    .value = bindingValue,
+                };
+
+    // taylor series of increasing order differentiate the same nodes again and again (cache is per section, as sections are generated in parallel)
+    EpTransformCache *cache = epTransformCacheCtor(64);
+    const EpNode *zero = context->zero;
+    const char *param = epSymbolName(parameters[index]);
+
+    fprintf(out, "\\section{Exploring function by \"%s\"}\n", param);
+
+    EpNode *substituted = bindings != NULL
+        ? epNodeSpecialize(nodeOptimized, bindings, bindingCount)
+        : NULL;
+    EpNode *derivativeByParam = NULL;
+
+    // calculate taylor series
+    EpNode *taylorSeries[6] = {NULL};
+    const size_t taylorSeriesSize = 6;
+
+    if (substituted == NULL || (derivativeByParam = epNodeOptimizeInPlace(epNodeDerivativeCached(cache, substituted, param))) == NULL) {
+        fprintf(out, "Internal error occured...\n");
+        goto __epNodeGenNodeFunctionInfoSection__end;
     }
+
+    for (size_t i = 0; i < taylorSeriesSize; i++) {
+        taylorSeries[i] = epNodeOptimizeInPlace(epNodeTaylorCached(cache, substituted, param, zero, i + 1));
+
+        if (taylorSeries[i] == NULL) {
+            fprintf(out, "Internal error occured...\n");
+            goto __epNodeGenNodeFunctionInfoSection__end;
+        }
     }
-} // epNodeInfoDumpNode
-
-static void epNodeGenNodeGetFunctionParameters(
-    const EpNode * node,
-
-    const char **  parameters,
-    size_t      *  parameterCount,
-    size_t         parameterMax
-) {
-    switch (node->type) {
-    case EP_NODE_VARIABLE: {
-        for (size_t i = 0; i < *parameterCount; i++)
-            if (strcmp(parameters[i], node->variable) == 0)
-                return;
-
-        if (*parameterCount < parameterMax)
-            parameters[(*parameterCount)++] = node->variable;
+
+    char bindingValueText[EP_DOUBLE_FORMAT_SIZE];
+
+    epDoubleFormat(bindingValue, bindingValueText);
+    fprintf(out, "With %s substituted to parameters except \"%s\": $$", bindingValueText, param);
+    epNodeDump(out, substituted, EP_DUMP_TEX);
+    fprintf(out, "$$\n");
+
+    fprintf(out, "First derivative by \"%s\": $$", param);
+    epNodeDump(out, derivativeByParam, EP_DUMP_TEX);
+    fprintf(out, "$$\n");
+
+    fprintf(out, "Taylor expansion around 0: $$");
+    epNodeDump(out, taylorSeries[taylorSeriesSize - 1], EP_DUMP_TEX);
+    fprintf(out, "+ o(%s^%zu)", param, taylorSeriesSize + 1);
+    fprintf(out, "$$\n");
+
+    // graphs
+    fprintf(out, "\\begin{tikzpicture}\n");
+    fprintf(out, "\\begin{axis} [axis lines=center]\n");
+
+    // derivative
+    epInfoPlot(out, derivativeByParam, param, "color = green, thick, mark = none");
+
+    // taylor
+    for (size_t i = 0; i < taylorSeriesSize; i++)
+        epInfoPlot(out, taylorSeries[i], param, "color = lightgray, thick, mark = none");
+
+    // function itself
+    epInfoPlot(out, substituted, param, "color = black, thick, mark = none");
+
+    fprintf(out, "\\end{axis}\n");
+    fprintf(out, "\\end{tikzpicture}\n");
+
+__epNodeGenNodeFunctionInfoSection__end:
+    epNodeDtor(substituted);
+    epNodeDtor(derivativeByParam);
+    for (size_t i = 0; i < taylorSeriesSize; i++)
+        epNodeDtor(taylorSeries[i]);
+    epTransformCacheDtor(cache);
+    free(bindings);
+
+    epTraceEnd("info section", NULL);
+} // epNodeGenNodeFunctionInfoSection
+
+/**
+ * @brief function info section into memory buffer generation task
+ * 
+ * @param[in] context section generation context
+ * @param[in] index   index of parameter to explore function by
+ */
+static void epNodeGenNodeFunctionInfoSectionTask( void *context, size_t index ) {
+    EpInfoSectionContext *self = (EpInfoSectionContext *)context;
+    FILE *out = open_memstream(&self->texts[index], &self->textSizes[index]);
+
+    if (out == NULL) {
+        self->texts[index] = NULL;
         return;
     }
-    case EP_NODE_CONSTANT:
-        return;
 
-    case EP_NODE_BINARY_OPERATOR:
-        epNodeGenNodeGetFunctionParameters(
-            node->binaryOperator.lhs,
-            parameters,
-            parameterCount,
-            parameterMax
-        );
-        epNodeGenNodeGetFunctionParameters(
-            node->binaryOperator.rhs,
-            parameters,
-            parameterCount,
-            parameterMax
-        );
-        return;
+    epNodeGenNodeFunctionInfoSection(out, self, index);
 
-    case EP_NODE_UNARY_OPERATOR:
-        epNodeGenNodeGetFunctionParameters(
-            node->unaryOperator.operand,
-            parameters,
-            parameterCount,
-            parameterMax
-        );
-        return;
+    if (fclose(out) != 0) {
+        free(self->texts[index]);
+        self->texts[index] = NULL;
     }
-} // epNodeGenNodeGetFunctionParameters
+} // epNodeGenNodeFunctionInfoSectionTask
 
 void epNodeGenNodeFunctionInfo( FILE *out, const EpNode *node ) {
-    const char *parameters[64] = {NULL};
+    EP_STATS_PHASE_BEGIN(EP_STATS_PHASE_INFO);
+    epTraceBegin("info", NULL, 0, node);
+
+    EpSymbol *parameters = NULL;
     size_t parameterCount = 0;
     EpNode *nodeOptimized = epNodeOptimize(node);
     EpNode *zero = epNodeConstant(0.0);
-    EpNode *tVar = epNodeVariable("t");
 
     // get node function parameters
-    epNodeGenNodeGetFunctionParameters(nodeOptimized, parameters, &parameterCount, 64);
+    const bool parametersCollected = nodeOptimized != NULL && epNodeCollectVariables(nodeOptimized, &parameters, &parameterCount);
 
     fprintf(out, "\\documentclass{article}\n");
     fprintf(out, "\\usepackage{graphicx}\n");
@@ -137,112 +350,63 @@ void epNodeGenNodeFunctionInfo( FILE *out, const EpNode *node ) {
     fprintf(out, "\\maketitle\n");
 
     fprintf(out, "\\section{Introduction}\n");
-    if (node == NULL || zero == NULL || tVar == NULL) {
+    if (nodeOptimized == NULL || zero == NULL || !parametersCollected) {
         fprintf(out, "Internal error occured...\n");
         goto __epNodeGenNodeFunctionInfo__end;
     }
 
     if (parameterCount == 0) {
-        // node MUST BE optimized into constant in case if there's no parameters found in it.
-        assert(node->type == EP_NODE_CONSTANT);
+        // node MUST BE optimized into constant (or its negation) in case if there's no parameters found in it.
+        EpNodeComputeResult value = epNodeCompute(nodeOptimized, NULL, 0);
+        assert(value.status == EP_NODE_COMPUTE_OK);
+
+        char valueText[EP_DOUBLE_FORMAT_SIZE];
 
-        fprintf(out, "Function is just a constant, there is nothing to look at: %lf\n", node->constant);
+        epDoubleFormat(value.ok, valueText);
+        fprintf(out, "Function is just a constant, there is nothing to look at: %s\n", valueText);
     } else {
         fprintf(out, "Function: $$");
         epNodeDump(out, nodeOptimized, EP_DUMP_TEX);
         fprintf(out, "$$\n");
     }
 
-    for (size_t i = 0; i < parameterCount; i++) {
-        // substitute zeros
-        EpSubstitution substitutions[64] = {};
-        size_t substitutionCount = 0;
-
-        EpNode *subConst = epNodeConstant(2.5);
-
-        // substitute taylor series
-        for (size_t j = 0; j < parameterCount; j++) {
-            EpSubstitution *s = &substitutions[substitutionCount++];
-            s->name = parameters[j];
-
-            s->node = i == j
-                ? tVar
-                : subConst;
-        }
-
-
-        const char *param = parameters[i];
-
-        fprintf(out, "\\section{Exploring function by \"%s\"}\n", param);
-
-        EpNode *substitutedInit = epNodeSubstitute(nodeOptimized, substitutions, substitutionCount);
-        EpNode *substituted = epNodeOptimize(substitutedInit);
-        epNodeDtor(substitutedInit);
-
-        EpNode *derivativeByParamInit = epNodeDerivative(substituted, "t");
-        EpNode *derivativeByParam = epNodeOptimize(derivativeByParamInit);
-        epNodeDtor(derivativeByParamInit);
-
-        // calculate taylor series
-        EpNode *taylorSeries[6] = {NULL};
-        const size_t taylorSeriesSize = 6;
-
-        for (size_t i = 0; i < taylorSeriesSize; i++) {
-            EpNode *taylorInit = epNodeTaylor(substituted, "t", zero, i + 1);
-            taylorSeries[i] = epNodeOptimize(taylorInit);
-            epNodeDtor(taylorInit);
-        }
-
-        fprintf(out, "With %lf substituted to parameters except \"%s\" (renamed to \"t\"): $$", subConst->constant, param);
-        epNodeDump(out, substituted, EP_DUMP_TEX);
-        fprintf(out, "$$\n");
-
-        fprintf(out, "First derivative by \"t\": $$");
-        epNodeDump(out, derivativeByParam, EP_DUMP_TEX);
-        fprintf(out, "$$\n");
-
-        fprintf(out, "Taylor expansion around 0: $$");
-        epNodeDump(out, taylorSeries[taylorSeriesSize - 1], EP_DUMP_TEX);
-        fprintf(out, "+ o(t^%zu)", taylorSeriesSize + 1);
-        fprintf(out, "$$\n");
-
-        // graphs
-        fprintf(out, "\\begin{tikzpicture}\n");
-        fprintf(out, "\\begin{axis} [axis lines=center]\n");
-
-        // derivative
-        fprintf(out, "\\addplot [color = green, smooth, thick, variable = \\t] { ");
-        epNodeInfoDumpNode(out, derivativeByParam);
-        fprintf(out, "};\n");
-
-        // taylor
-        for (size_t i = 0; i < taylorSeriesSize; i++) {
-            fprintf(out, "\\addplot [color = lightgray, smooth, thick, variable = \\t] { ");
-            epNodeInfoDumpNode(out, taylorSeries[i]);
-            fprintf(out, "};\n");
+    {
+        // sections are independent, so they're generated in parallel and then written in parameter order
+        EpInfoSectionContext context = {
+            .node = nodeOptimized,
+            .zero = zero,
+            .parameters = parameters,
+            .parameterCount = parameterCount,
+            .texts = (char **)calloc(parameterCount, sizeof(char *)),
+            .textSizes = (size_t *)calloc(parameterCount, sizeof(size_t)),
+        };
+
+        if (context.texts != NULL && context.textSizes != NULL)
+            epParallelFor(parameterCount, 0, epNodeGenNodeFunctionInfoSectionTask, &context);
+
+        for (size_t i = 0; i < parameterCount; i++) {
+            // section is generated directly if its buffer allocation failed
+            if (context.texts != NULL && context.textSizes != NULL && context.texts[i] != NULL) {
+                fwrite(context.texts[i], 1, context.textSizes[i], out);
+                free(context.texts[i]);
+            } else {
+                epNodeGenNodeFunctionInfoSection(out, &context, i);
+            }
         }
 
-        // function itself
-        fprintf(out, "\\addplot [color = black, smooth, thick, variable = \\t] { ");
-        epNodeInfoDumpNode(out, substituted);
-        fprintf(out, "};\n");
-
-        fprintf(out, "\\end{axis}\n");
-        fprintf(out, "\\end{tikzpicture}\n");
-
-
-        epNodeDtor(derivativeByParam);
-        for (size_t i = 0; i < taylorSeriesSize; i++)
-            epNodeDtor(taylorSeries[i]);
-        epNodeDtor(subConst);
+        free(context.texts);
+        free(context.textSizes);
     }
 
 __epNodeGenNodeFunctionInfo__end:
 
+    free(parameters);
     epNodeDtor(zero);
-    epNodeDtor(tVar);
     epNodeDtor(nodeOptimized);
     fprintf(out, "\\end{document}");
+
+    epTraceEnd("info", NULL);
+    EP_STATS_PHASE_END(EP_STATS_PHASE_INFO);
 } // epNodeGenNodeFunctionInfo
 
 // ep_info.c
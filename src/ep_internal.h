@@ -0,0 +1,373 @@
+/**
+ * @brief expression processor internal (non-public) declarations header
+ */
+
+#ifndef EP_INTERNAL_H_
+#define EP_INTERNAL_H_
+
+#include <stdlib.h>
+
+#include "ep.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief node hash recalculation function
+ * 
+ * @param[in] node node to update hash of (non-null, operands must have valid hashes)
+ * 
+ * @note must be called after in-place modification of node fields or operands
+ */
+void epNodeUpdateHash( EpNode *node );
+
+/// @brief count of explicit traversal stack entries stored on thread stack before switching to heap
+#define EP_LOCAL_STACK_SIZE ((size_t)64)
+
+/**
+ * @brief explicit traversal stack capacity reservation function
+ * 
+ * @param[in,out] stack      stack pointer (non-null, initially points to localStack)
+ * @param[in,out] capacity   stack capacity (non-null, initially local stack capacity)
+ * @param[in]     required   required element count
+ * @param[in]     elemSize   stack element size
+ * @param[in]     localStack local (on thread stack) buffer, contents are moved to heap on first growth
+ * 
+ * @return true if reserved, false if allocation failed
+ * 
+ * @note stack must be freed by caller if it doesn't point to localStack anymore
+ */
+bool epStackReserve( void **stack, size_t *capacity, size_t required, size_t elemSize, void *localStack );
+
+/// @brief count of resolved symbols stored on thread stack before switching to heap
+#define EP_LOCAL_SYMBOL_COUNT ((size_t)64)
+
+/**
+ * @brief named items (variables, substitutions, ...) names to symbols resolution function
+ * 
+ * @param[in] items        items (non-null if count != 0, each item must start with 'const char *name' field)
+ * @param[in] count        item count
+ * @param[in] itemSize     item size
+ * @param[in] localSymbols local (on thread stack) buffer of EP_LOCAL_SYMBOL_COUNT symbols
+ * 
+ * @return item symbols (EP_SYMBOL_INVALID for names that are not interned, NULL if allocation failed)
+ * 
+ * @note names are resolved once, so lookups in tree are integer comparisons.
+ * Names that are not interned can't occur in any node, so they never match.
+ * Result must be released by epSymbolsRelease.
+ */
+EpSymbol * epSymbolsResolve( const void *items, size_t count, size_t itemSize, EpSymbol *localSymbols );
+
+/**
+ * @brief resolved symbols releasing function
+ * 
+ * @param[in] symbols      epSymbolsResolve result (nullable)
+ * @param[in] localSymbols local buffer passed to epSymbolsResolve
+ */
+void epSymbolsRelease( EpSymbol *symbols, EpSymbol *localSymbols );
+
+/**
+ * @brief heap array capacity reservation function
+ * 
+ * @param[in,out] data     array pointer (non-null, pointed array may be NULL if capacity is 0)
+ * @param[in,out] capacity array capacity (non-null)
+ * @param[in]     required required element count
+ * @param[in]     elemSize array element size
+ * 
+ * @return true if reserved, false if allocation failed
+ */
+bool epArrayReserve( void **data, size_t *capacity, size_t required, size_t elemSize );
+
+/**
+ * @brief bit-exact node comparison function
+ * 
+ * @param[in] lhs left hand side (non-null)
+ * @param[in] rhs right hand side (non-null)
+ * 
+ * @return true if nodes have same structure and bit-identical constants, false otherwise (or if allocation failed)
+ * 
+ * @note unlike epNodeIsSame, constants are never compared within tolerance, so +0.0 and -0.0 are different
+ */
+bool epNodeIsIdentical( const EpNode *lhs, const EpNode *rhs );
+
+/**
+ * @brief node hash with constant bits calculation function
+ * 
+ * @param[in]  node node to calculate hash of (non-null)
+ * @param[out] dst  hash destination (non-null)
+ * 
+ * @return true if calculated, false if allocation failed
+ * 
+ * @note nodes that are identical by epNodeIsIdentical have same hash whatever EP_EXACT_CONSTANT_EQUALITY is set to
+ */
+bool epNodeIdentityHash( const EpNode *node, uint32_t *dst );
+
+/// @brief flat (postorder array) node representation structure, children are referenced by array index
+typedef struct __EpFlatNode {
+    EpNodeType type; ///< node type
+
+    union {
+        EpSymbol variable; ///< variable node symbol
+
+        double constant;   ///< constant node value
+
+        struct {
+            EpBinaryOperator op;  ///< binary operator
+            uint32_t         lhs; ///< left hand side index
+            uint32_t         rhs; ///< right hand side index
+        } binaryOperator;
+
+        struct {
+            EpUnaryOperator op;      ///< unary operator
+            uint32_t        operand; ///< operand index
+        } unaryOperator;
+    };
+} EpFlatNode;
+
+/**
+ * @brief flat node visiting function pointer
+ * 
+ * @param[in] context visitor context
+ * @param[in] node    flat node (index of node is count of nodes visited before it)
+ * 
+ * @return true if flattening should continue, false if it should be aborted
+ */
+typedef bool (* EpFlatNodeVisitor)( void *context, const EpFlatNode *node );
+
+/**
+ * @brief tree postorder flattening function
+ * 
+ * @param[in] node    tree to flatten (non-null)
+ * @param[in] visitor node visitor (non-null, children are visited before their parents)
+ * @param[in] context visitor context
+ * 
+ * @return true if flattened, false if allocation failed, tree is too large or visitor aborted flattening
+ */
+bool epNodeFlatten( const EpNode *node, EpFlatNodeVisitor visitor, void *context );
+
+/**
+ * @brief flat node getting function pointer
+ * 
+ * @param[in]  context getter context
+ * @param[in]  index   node index
+ * @param[out] dst     flat node destination (non-null, children indices must be less than index)
+ * 
+ * @return true if node is got, false if construction should be aborted
+ */
+typedef bool (* EpFlatNodeGetter)( const void *context, uint32_t index, EpFlatNode *dst );
+
+/**
+ * @brief tree from postorder flat nodes construction function
+ * 
+ * @param[in] getter    node getter (non-null)
+ * @param[in] context   getter context
+ * @param[in] nodeCount count of nodes (non-zero, every node except last must be used by exactly one parent)
+ * 
+ * @return tree with last node as root (NULL if allocation failed or getter aborted construction)
+ */
+EpNode * epNodeUnflatten( EpFlatNodeGetter getter, const void *context, uint32_t nodeCount );
+
+/**
+ * @brief buffer capacity reservation function
+ * 
+ * @param[in,out] buffer   buffer (non-null)
+ * @param[in]     required required free space (terminating null is reserved in addition to it)
+ * 
+ * @return true if reserved, false if allocation failed
+ */
+bool epBufferReserve( EpBuffer *buffer, size_t required );
+
+/**
+ * @brief data to buffer appending function
+ * 
+ * @param[in,out] buffer buffer (non-null)
+ * @param[in]     data   data to append (non-null if size != 0)
+ * @param[in]     size   data size
+ * 
+ * @return true if appended, false if allocation failed
+ */
+bool epBufferAppend( EpBuffer *buffer, const char *data, size_t size );
+
+/**
+ * @brief node memory allocation function
+ * 
+ * @param[in] allocator allocator (nullable, calloc is used if NULL)
+ * 
+ * @return zero-initialized node memory (NULL if allocation failed)
+ */
+static inline EpNode * epNodeAllocatorAlloc( const EpAllocator *allocator ) {
+    return allocator == NULL
+        ? (EpNode *)calloc(1, sizeof(EpNode))
+        : (EpNode *)allocator->alloc(allocator->context, sizeof(EpNode));
+} // epNodeAllocatorAlloc
+
+/**
+ * @brief node memory freeing function
+ * 
+ * @param[in] allocator allocator node is allocated with (nullable, free is used if NULL)
+ * @param[in] node      node memory to free (non-null)
+ */
+static inline void epNodeAllocatorFree( const EpAllocator *allocator, EpNode *node ) {
+    if (allocator == NULL)
+        free(node);
+    else
+        allocator->free(allocator->context, node, sizeof(EpNode));
+} // epNodeAllocatorFree
+
+/**
+ * @brief parallel task function pointer
+ * 
+ * @param[in] context task context
+ * @param[in] index   task index
+ */
+typedef void (* EpParallelTask)( void *context, size_t index );
+
+/**
+ * @brief parallel worker count getting function
+ * 
+ * @param[in] requested requested count of workers (0 to use count of online processors)
+ * 
+ * @return count of workers (at least 1)
+ */
+unsigned int epParallelGetWorkerCount( unsigned int requested );
+
+/**
+ * @brief task set on worker pool execution function
+ * 
+ * @param[in] taskCount   count of tasks
+ * @param[in] workerCount count of workers (0 to use count of online processors)
+ * @param[in] task        task function (non-null)
+ * @param[in] context     task context
+ * 
+ * @note tasks are taken by workers in index order, calling thread also participates in execution.
+ * If worker threads can't be started, remaining tasks are executed on calling thread.
+ */
+void epParallelFor( size_t taskCount, unsigned int workerCount, EpParallelTask task, void *context );
+
+/**
+ * @brief unary operator with specified accuracy on array apply function
+ * 
+ * @param[in]  op       unary operator
+ * @param[in]  accuracy accuracy
+ * @param[in]  src      operands (count elements)
+ * @param[out] dst      results destination (count elements, must not overlap src)
+ * @param[in]  count    count of elements
+ */
+void epApproxUnaryApplyArray( EpUnaryOperator op, EpMathAccuracy accuracy, const double *src, double *dst, size_t count );
+
+/**
+ * @brief sine and cosine with specified accuracy on array calculation function
+ * 
+ * @param[in]  accuracy accuracy
+ * @param[in]  src      arguments (count elements)
+ * @param[out] sinDst   sines destination (count elements)
+ * @param[out] cosDst   cosines destination (count elements)
+ * @param[in]  count    count of elements
+ */
+void epApproxSinCosArray( EpMathAccuracy accuracy, const double *src, double *sinDst, double *cosDst, size_t count );
+
+/**
+ * @brief raising to a power with specified accuracy on array function
+ * 
+ * @param[in]  accuracy accuracy
+ * @param[in]  lhs      bases (count elements)
+ * @param[in]  rhs      exponents (count elements)
+ * @param[out] dst      results destination (count elements)
+ * @param[in]  count    count of elements
+ */
+void epApproxPowArray( EpMathAccuracy accuracy, const double *lhs, const double *rhs, double *dst, size_t count );
+
+/// @brief instrumentation counter
+typedef enum __EpStatsCounter {
+    EP_STATS_COUNTER_NODE_ALLOCATIONS, ///< allocated nodes
+    EP_STATS_COUNTER_NODE_FREES,       ///< freed nodes
+    EP_STATS_COUNTER_COPY_CALLS,       ///< epNodeCopy calls
+    EP_STATS_COUNTER_COPIED_NODES,     ///< nodes copied by epNodeCopy
+
+    EP_STATS_COUNTER_COUNT,            ///< count of counters (not a counter)
+} EpStatsCounter;
+
+#ifdef EP_STATS
+
+/**
+ * @brief calling thread counter incrementing function
+ * 
+ * @param[in] counter counter
+ * @param[in] value   value to add
+ */
+void epStatsCount( EpStatsCounter counter, uint64_t value );
+
+/**
+ * @brief epNodeIsSame call accounting function
+ * 
+ * @param[in] nodes count of node pairs compared by call
+ * @param[in] depth maximal depth of compared node pair (root pair depth is 1)
+ */
+void epStatsIsSame( uint64_t nodes, uint64_t depth );
+
+/**
+ * @brief optimizer rule group hit accounting function
+ * 
+ * @param[in] rule rule group
+ */
+void epStatsRuleHit( EpStatsRule rule );
+
+/**
+ * @brief phase beginning function
+ * 
+ * @param[in] phase phase
+ * 
+ * @note only outermost of nested same phases is timed
+ */
+void epStatsPhaseBegin( EpStatsPhase phase );
+
+/**
+ * @brief phase ending function
+ * 
+ * @param[in] phase phase (must be begun by calling thread)
+ */
+void epStatsPhaseEnd( EpStatsPhase phase );
+
+#define EP_STATS_COUNT(counter, value) epStatsCount((counter), (value))
+#define EP_STATS_IS_SAME(nodes, depth) epStatsIsSame((nodes), (depth))
+#define EP_STATS_RULE_HIT(rule)        epStatsRuleHit((rule))
+#define EP_STATS_PHASE_BEGIN(phase)    epStatsPhaseBegin((phase))
+#define EP_STATS_PHASE_END(phase)      epStatsPhaseEnd((phase))
+
+#else
+
+// instrumentation is compiled out
+#define EP_STATS_COUNT(counter, value) ((void)0)
+#define EP_STATS_IS_SAME(nodes, depth) ((void)0)
+#define EP_STATS_RULE_HIT(rule)        ((void)0)
+#define EP_STATS_PHASE_BEGIN(phase)    ((void)0)
+#define EP_STATS_PHASE_END(phase)      ((void)0)
+
+#endif // defined(EP_STATS)
+
+/**
+ * @brief trace span beginning function
+ * 
+ * @param[in] name     span name (static string without characters to escape)
+ * @param[in] argName  additional argument name (static string, nullable)
+ * @param[in] argValue additional argument value
+ * @param[in] node     node which node count is span argument (nullable)
+ * 
+ * @note does nothing if trace recording is not started, node is traversed only if it is
+ */
+void epTraceBegin( const char *name, const char *argName, uint64_t argValue, const EpNode *node );
+
+/**
+ * @brief trace span ending function
+ * 
+ * @param[in] name span name (same as in epTraceBegin)
+ * @param[in] node node which node count is span result argument (nullable)
+ */
+void epTraceEnd( const char *name, const EpNode *node );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // !defined(EP_INTERNAL_H_)
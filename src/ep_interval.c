@@ -0,0 +1,597 @@
+/**
+ * @brief interval arithmetic implementation file
+ */
+
+#include <assert.h>
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+
+#include "ep_internal.h"
+
+/// @brief count of ulps results of correctly rounded operations are widened by
+#define EP_INTERVAL_ROUNDING_ULPS 1
+
+/// @brief count of ulps results of libm functions are widened by (they are not guaranteed to be correctly rounded)
+#define EP_INTERVAL_LIBM_ULPS 4
+
+/// @brief minimal integer power (relative to DBL_MIN) intermediate products of which are guaranteed to be normal
+#define EP_INTERVAL_POWI_NORMAL_MIN (4.0 * DBL_MIN)
+
+/// @brief maximal argument absolute value trigonometric function extremes and poles are searched for
+/// (above it period is comparable to ulp, so nothing but whole range can be guaranteed)
+#define EP_INTERVAL_TRIG_MAX 1e9
+
+/// @brief 2 * pi
+#define EP_INTERVAL_2PI (2.0 * M_PI)
+
+/// @brief empty interval
+static const EpInterval EP_INTERVAL_EMPTY = { .lo = INFINITY, .hi = -INFINITY };
+
+/// @brief whole real line
+static const EpInterval EP_INTERVAL_ENTIRE = { .lo = -INFINITY, .hi = INFINITY };
+
+bool epIntervalIsEmpty( EpInterval interval ) {
+    return !(interval.lo <= interval.hi);
+} // epIntervalIsEmpty
+
+/**
+ * @brief interval construction from rounded bounds function
+ * 
+ * @param[in] lo   lower bound (rounded to nearest)
+ * @param[in] hi   upper bound (rounded to nearest)
+ * @param[in] ulps count of ulps to widen bounds by
+ * 
+ * @return widened interval (NaN bounds are replaced by infinities, so result is still enclosure)
+ */
+static EpInterval epIntervalOutward( double lo, double hi, int ulps ) {
+    lo = isnan(lo) ? -INFINITY : lo;
+    hi = isnan(hi) ?  INFINITY : hi;
+
+    for (int i = 0; i < ulps; i++) {
+        lo = nextafter(lo, -INFINITY);
+        hi = nextafter(hi,  INFINITY);
+    }
+
+    return (EpInterval) { .lo = lo, .hi = hi };
+} // epIntervalOutward
+
+/**
+ * @brief interval by other interval clamping function
+ * 
+ * @param[in] interval interval to clamp
+ * @param[in] lo       minimal lower bound
+ * @param[in] hi       maximal upper bound
+ * 
+ * @return clamped interval
+ * 
+ * @note used to remove widening out of known function range (e.g. sine out of [-1, 1])
+ */
+static EpInterval epIntervalClamp( EpInterval interval, double lo, double hi ) {
+    return (EpInterval) {
+        .lo = interval.lo < lo ? lo : interval.lo,
+        .hi = interval.hi > hi ? hi : interval.hi,
+    };
+} // epIntervalClamp
+
+/**
+ * @brief zero-preserving product function
+ * 
+ * @param[in] lhs left hand side
+ * @param[in] rhs right hand side
+ * 
+ * @return lhs * rhs, 0 if one of operands is 0 (bound 0 times infinite bound is 0 in interval arithmetic)
+ */
+static double epIntervalMulBound( double lhs, double rhs ) {
+    return lhs == 0.0 || rhs == 0.0
+        ? 0.0
+        : lhs * rhs;
+} // epIntervalMulBound
+
+/**
+ * @brief interval product function
+ * 
+ * @param[in] lhs left hand side (non-empty)
+ * @param[in] rhs right hand side (non-empty)
+ * 
+ * @return product enclosure
+ */
+static EpInterval epIntervalMul( EpInterval lhs, EpInterval rhs ) {
+    const double products[4] = {
+        epIntervalMulBound(lhs.lo, rhs.lo),
+        epIntervalMulBound(lhs.lo, rhs.hi),
+        epIntervalMulBound(lhs.hi, rhs.lo),
+        epIntervalMulBound(lhs.hi, rhs.hi),
+    };
+    double lo = products[0];
+    double hi = products[0];
+
+    for (int i = 1; i < 4; i++) {
+        lo = products[i] < lo ? products[i] : lo;
+        hi = products[i] > hi ? products[i] : hi;
+    }
+
+    return epIntervalOutward(lo, hi, EP_INTERVAL_ROUNDING_ULPS);
+} // epIntervalMul
+
+/**
+ * @brief interval quotient function
+ * 
+ * @param[in] lhs dividend (non-empty)
+ * @param[in] rhs divisor (non-empty)
+ * 
+ * @return quotient enclosure
+ */
+static EpInterval epIntervalDiv( EpInterval lhs, EpInterval rhs ) {
+    // 0 / 0 is undefined, other values are divided by zero to infinities (same as in epNodeCompute)
+    if (lhs.lo == 0.0 && lhs.hi == 0.0)
+        return rhs.lo == 0.0 && rhs.hi == 0.0
+            ? EP_INTERVAL_EMPTY
+            : (EpInterval) { .lo = 0.0, .hi = 0.0 };
+
+    // divisor contains zero inside, so quotient approaches both infinities
+    if ((rhs.lo < 0.0 && rhs.hi > 0.0) || (rhs.lo == 0.0 && rhs.hi == 0.0))
+        return EP_INTERVAL_ENTIRE;
+
+    // divisor touches zero by bound, so it is replaced by reciprocal with infinite bound
+    // (zero bound is considered to have same sign as other bound, zero sign isn't tracked)
+    if (rhs.lo == 0.0)
+        return epIntervalMul(lhs, epIntervalOutward(1.0 / rhs.hi, INFINITY, EP_INTERVAL_ROUNDING_ULPS));
+    if (rhs.hi == 0.0)
+        return epIntervalMul(lhs, epIntervalOutward(-INFINITY, 1.0 / rhs.lo, EP_INTERVAL_ROUNDING_ULPS));
+
+    const double quotients[4] = {
+        lhs.lo / rhs.lo,
+        lhs.lo / rhs.hi,
+        lhs.hi / rhs.lo,
+        lhs.hi / rhs.hi,
+    };
+    double lo = quotients[0];
+    double hi = quotients[0];
+
+    for (int i = 0; i < 4; i++) {
+        // infinity / infinity, bounds can't be determined
+        if (isnan(quotients[i]))
+            return EP_INTERVAL_ENTIRE;
+
+        lo = quotients[i] < lo ? quotients[i] : lo;
+        hi = quotients[i] > hi ? quotients[i] : hi;
+    }
+
+    return epIntervalOutward(lo, hi, EP_INTERVAL_ROUNDING_ULPS);
+} // epIntervalDiv
+
+/**
+ * @brief non-negative number to positive integer power enclosure function
+ * 
+ * @param[in] base     base (non-negative)
+ * @param[in] exponent exponent (positive)
+ * 
+ * @return enclosure of exact power, libm pow result and result of repeated squaring (see epPowi)
+ * 
+ * @note squaring doubles relative error of squared value, so repeated squaring result
+ * is (exponent - 1) roundings away from exact power in worst case, not log2(exponent).
+ */
+static EpInterval epIntervalPowiMagnitude( double base, unsigned int exponent ) {
+    const double relative = ((double)exponent + EP_INTERVAL_LIBM_ULPS) * DBL_EPSILON;
+    const double power = fmin(pow(base, (double)exponent), DBL_MAX);
+    double lo = power * (1.0 - relative);
+    double hi = power * (1.0 + relative);
+
+    // subnormal intermediate products lose relative accuracy
+    if (lo < EP_INTERVAL_POWI_NORMAL_MIN) {
+        lo = 0.0;
+        hi = fmax(hi, EP_INTERVAL_POWI_NORMAL_MIN);
+    }
+
+    return epIntervalClamp(epIntervalOutward(lo, hi, EP_INTERVAL_ROUNDING_ULPS), 0.0, INFINITY);
+} // epIntervalPowiMagnitude
+
+/**
+ * @brief interval to integer power raising function
+ * 
+ * @param[in] base     base (non-empty)
+ * @param[in] exponent exponent
+ * 
+ * @return power enclosure (both for POW node with integer exponent and POWI node)
+ */
+static EpInterval epIntervalPowi( EpInterval base, int exponent ) {
+    if (exponent == 0)
+        return (EpInterval) { .lo = 1.0, .hi = 1.0 };
+
+    const unsigned int n = exponent < 0
+        ? 0u - (unsigned int)exponent
+        : (unsigned int)exponent;
+    const bool containsZero = base.lo <= 0.0 && base.hi >= 0.0;
+
+    if (n % 2 == 0) {
+        // even power depends on absolute value only
+        const EpInterval powLo = epIntervalPowiMagnitude(containsZero ? 0.0 : fmin(fabs(base.lo), fabs(base.hi)), n);
+        const EpInterval powHi = epIntervalPowiMagnitude(fmax(fabs(base.lo), fabs(base.hi)), n);
+
+        if (exponent > 0)
+            return (EpInterval) { .lo = powLo.lo, .hi = powHi.hi };
+
+        // negative even power decreases by absolute value
+        return epIntervalOutward(1.0 / powHi.hi, 1.0 / powLo.lo, EP_INTERVAL_ROUNDING_ULPS);
+    }
+
+    // odd power is increasing and keeps sign
+    const EpInterval powLo = epIntervalPowiMagnitude(fabs(base.lo), n);
+    const EpInterval powHi = epIntervalPowiMagnitude(fabs(base.hi), n);
+
+    if (exponent > 0)
+        return (EpInterval) {
+            .lo = base.lo < 0.0 ? -powLo.hi : powLo.lo,
+            .hi = base.hi < 0.0 ? -powHi.lo : powHi.hi,
+        };
+
+    // negative odd power decreases on both sides of pole at zero
+    if ((base.lo < 0.0 && base.hi > 0.0) || (base.lo == 0.0 && base.hi == 0.0))
+        return EP_INTERVAL_ENTIRE;
+    if (base.lo == 0.0)
+        return epIntervalOutward(1.0 / powHi.hi, INFINITY, EP_INTERVAL_ROUNDING_ULPS);
+    if (base.hi == 0.0)
+        return epIntervalOutward(-INFINITY, -1.0 / powLo.hi, EP_INTERVAL_ROUNDING_ULPS);
+    return base.lo > 0.0
+        ? epIntervalOutward(1.0 / powHi.hi, 1.0 / powLo.lo, EP_INTERVAL_ROUNDING_ULPS)
+        : epIntervalOutward(-1.0 / powHi.lo, -1.0 / powLo.hi, EP_INTERVAL_ROUNDING_ULPS);
+} // epIntervalPowi
+
+/**
+ * @brief interval to interval power raising function
+ * 
+ * @param[in] base     base (non-empty)
+ * @param[in] exponent exponent (non-empty)
+ * 
+ * @return power enclosure
+ */
+static EpInterval epIntervalPow( EpInterval base, EpInterval exponent ) {
+    // single integer exponent allows negative bases
+    if (exponent.lo == exponent.hi && epDoubleIsInteger(exponent.lo))
+        return epIntervalPowi(base, (int)exponent.lo);
+
+    // pow of non-negative base is monotonic by each argument, so extremes are at box corners
+    if (base.lo >= 0.0) {
+        const double corners[4] = {
+            pow(base.lo, exponent.lo),
+            pow(base.lo, exponent.hi),
+            pow(base.hi, exponent.lo),
+            pow(base.hi, exponent.hi),
+        };
+        double lo = corners[0];
+        double hi = corners[0];
+
+        for (int i = 1; i < 4; i++) {
+            lo = corners[i] < lo ? corners[i] : lo;
+            hi = corners[i] > hi ? corners[i] : hi;
+        }
+
+        return epIntervalClamp(epIntervalOutward(lo, hi, EP_INTERVAL_LIBM_ULPS), 0.0, INFINITY);
+    }
+
+    // negative bases are defined for integer exponents only, |pow| is bounded by power of absolute values
+    const double absHi = fmax(fabs(base.lo), fabs(base.hi));
+    const EpInterval magnitude = epIntervalPow((EpInterval) { .lo = 0.0, .hi = absHi }, exponent);
+
+    // no integers in exponent, so finite negative base powers are undefined everywhere (pow(-inf, y) is defined for any y)
+    if (base.hi < 0.0 && base.lo > -INFINITY && ceil(exponent.lo) > floor(exponent.hi))
+        return EP_INTERVAL_EMPTY;
+    return (EpInterval) { .lo = -magnitude.hi, .hi = magnitude.hi };
+} // epIntervalPow
+
+/**
+ * @brief interval contains point of periodic sequence checking function
+ * 
+ * @param[in] interval interval (non-empty, bounded by EP_INTERVAL_TRIG_MAX)
+ * @param[in] phase    sequence phase
+ * @param[in] period   sequence period
+ * 
+ * @return true if interval possibly contains phase + k * period for some integer k, false if it doesn't contain
+ * 
+ * @note points near bounds are considered contained, so rounding in reduction can't lose extreme or pole
+ */
+static bool epIntervalContainsPeriodic( EpInterval interval, double phase, double period ) {
+    const double slack = 1e-12 * (1.0 + fmax(fabs(interval.lo), fabs(interval.hi)));
+    const double k = ceil((interval.lo - slack - phase) / period);
+
+    return phase + k * period <= interval.hi + slack;
+} // epIntervalContainsPeriodic
+
+/**
+ * @brief sine or cosine of interval calculation function
+ * 
+ * @param[in] operand  operand (non-empty)
+ * @param[in] cosine   true to calculate cosine, false to calculate sine
+ * 
+ * @return sine or cosine enclosure
+ */
+static EpInterval epIntervalSinCos( EpInterval operand, bool cosine ) {
+    const EpInterval full = { .lo = -1.0, .hi = 1.0 };
+
+    if (false
+        || operand.hi - operand.lo >= EP_INTERVAL_2PI
+        || fabs(operand.lo) > EP_INTERVAL_TRIG_MAX
+        || fabs(operand.hi) > EP_INTERVAL_TRIG_MAX
+    )
+        return full;
+
+    const double lo = cosine ? cos(operand.lo) : sin(operand.lo);
+    const double hi = cosine ? cos(operand.hi) : sin(operand.hi);
+    EpInterval result = epIntervalOutward(fmin(lo, hi), fmax(lo, hi), EP_INTERVAL_LIBM_ULPS);
+
+    // function is monotonic between extremes, so only extremes inside interval can change bounds
+    if (epIntervalContainsPeriodic(operand, cosine ? 0.0 : M_PI_2, EP_INTERVAL_2PI))
+        result.hi = 1.0;
+    if (epIntervalContainsPeriodic(operand, cosine ? M_PI : -M_PI_2, EP_INTERVAL_2PI))
+        result.lo = -1.0;
+
+    return epIntervalClamp(result, -1.0, 1.0);
+} // epIntervalSinCos
+
+/**
+ * @brief tangent or cotangent of interval calculation function
+ * 
+ * @param[in] operand   operand (non-empty)
+ * @param[in] cotangent true to calculate cotangent, false to calculate tangent
+ * 
+ * @return tangent or cotangent enclosure
+ */
+static EpInterval epIntervalTanCot( EpInterval operand, bool cotangent ) {
+    // functions are monotonic between poles, so interval with pole inside maps to whole line
+    if (false
+        || operand.hi - operand.lo >= M_PI
+        || fabs(operand.lo) > EP_INTERVAL_TRIG_MAX
+        || fabs(operand.hi) > EP_INTERVAL_TRIG_MAX
+        || epIntervalContainsPeriodic(operand, cotangent ? 0.0 : M_PI_2, M_PI)
+    )
+        return EP_INTERVAL_ENTIRE;
+
+    // tangent increases, cotangent decreases
+    return cotangent
+        ? epIntervalOutward(
+            epUnaryOperatorApply(EP_UNARY_OPERATOR_COT, operand.hi),
+            epUnaryOperatorApply(EP_UNARY_OPERATOR_COT, operand.lo),
+            EP_INTERVAL_LIBM_ULPS
+        )
+        : epIntervalOutward(tan(operand.lo), tan(operand.hi), EP_INTERVAL_LIBM_ULPS);
+} // epIntervalTanCot
+
+EpInterval epUnaryOperatorApplyInterval( EpUnaryOperator op, EpInterval operand ) {
+    if (epIntervalIsEmpty(operand))
+        return EP_INTERVAL_EMPTY;
+
+    switch (op) {
+    case EP_UNARY_OPERATOR_NEG:
+        return (EpInterval) { .lo = -operand.hi, .hi = -operand.lo };
+
+    case EP_UNARY_OPERATOR_LN:
+        // defined at [0, +inf] (ln(0) = -inf)
+        if (operand.hi < 0.0)
+            return EP_INTERVAL_EMPTY;
+        return epIntervalOutward(log(fmax(operand.lo, 0.0)), log(operand.hi), EP_INTERVAL_LIBM_ULPS);
+
+    case EP_UNARY_OPERATOR_SIN: return epIntervalSinCos(operand, false);
+    case EP_UNARY_OPERATOR_COS: return epIntervalSinCos(operand, true);
+    case EP_UNARY_OPERATOR_TAN: return epIntervalTanCot(operand, false);
+    case EP_UNARY_OPERATOR_COT: return epIntervalTanCot(operand, true);
+
+    case EP_UNARY_OPERATOR_ASIN:
+    case EP_UNARY_OPERATOR_ACOS: {
+        // defined at [-1, 1]
+        if (operand.hi < -1.0 || operand.lo > 1.0)
+            return EP_INTERVAL_EMPTY;
+
+        const double lo = fmax(operand.lo, -1.0);
+        const double hi = fmin(operand.hi,  1.0);
+
+        // arcsine increases, arccosine decreases (range bounds are rounded up, because double pi is below real one)
+        return op == EP_UNARY_OPERATOR_ASIN
+            ? epIntervalClamp(
+                epIntervalOutward(asin(lo), asin(hi), EP_INTERVAL_LIBM_ULPS),
+                -nextafter(M_PI_2, INFINITY),
+                nextafter(M_PI_2, INFINITY)
+            )
+            : epIntervalClamp(
+                epIntervalOutward(acos(hi), acos(lo), EP_INTERVAL_LIBM_ULPS),
+                0.0,
+                nextafter(M_PI, INFINITY)
+            );
+    }
+
+    case EP_UNARY_OPERATOR_ATAN:
+        return epIntervalOutward(atan(operand.lo), atan(operand.hi), EP_INTERVAL_LIBM_ULPS);
+
+    case EP_UNARY_OPERATOR_ACOT:
+        // arccotangent decreases
+        return epIntervalClamp(
+            epIntervalOutward(
+                epUnaryOperatorApply(EP_UNARY_OPERATOR_ACOT, operand.hi),
+                epUnaryOperatorApply(EP_UNARY_OPERATOR_ACOT, operand.lo),
+                EP_INTERVAL_LIBM_ULPS
+            ),
+            0.0,
+            INFINITY
+        );
+
+    case EP_UNARY_OPERATOR_EXP:
+        return epIntervalClamp(
+            epIntervalOutward(exp(operand.lo), exp(operand.hi), EP_INTERVAL_LIBM_ULPS),
+            0.0,
+            INFINITY
+        );
+
+    case EP_UNARY_OPERATOR_SQRT:
+        // defined at [0, +inf]
+        if (operand.hi < 0.0)
+            return EP_INTERVAL_EMPTY;
+        return epIntervalClamp(
+            epIntervalOutward(sqrt(fmax(operand.lo, 0.0)), sqrt(operand.hi), EP_INTERVAL_ROUNDING_ULPS),
+            0.0,
+            INFINITY
+        );
+    }
+
+    return EP_INTERVAL_ENTIRE;
+} // epUnaryOperatorApplyInterval
+
+EpInterval epBinaryOperatorApplyInterval( EpBinaryOperator op, EpInterval lhs, EpInterval rhs ) {
+    if (epIntervalIsEmpty(lhs) || epIntervalIsEmpty(rhs)) {
+        // pow(NaN, 0) and pow(1, NaN) are 1, so power of undefined operand may still be defined
+        const bool isPower = op == EP_BINARY_OPERATOR_POW || op == EP_BINARY_OPERATOR_POWI;
+        const bool isOne = false
+            || (!epIntervalIsEmpty(rhs) && rhs.lo <= 0.0 && rhs.hi >= 0.0)
+            || (!epIntervalIsEmpty(lhs) && lhs.lo <= 1.0 && lhs.hi >= 1.0);
+
+        return isPower && isOne
+            ? (EpInterval) { .lo = 1.0, .hi = 1.0 }
+            : EP_INTERVAL_EMPTY;
+    }
+
+    switch (op) {
+    case EP_BINARY_OPERATOR_ADD:
+        return epIntervalOutward(lhs.lo + rhs.lo, lhs.hi + rhs.hi, EP_INTERVAL_ROUNDING_ULPS);
+
+    case EP_BINARY_OPERATOR_SUB:
+        return epIntervalOutward(lhs.lo - rhs.hi, lhs.hi - rhs.lo, EP_INTERVAL_ROUNDING_ULPS);
+
+    case EP_BINARY_OPERATOR_MUL: return epIntervalMul(lhs, rhs);
+    case EP_BINARY_OPERATOR_DIV: return epIntervalDiv(lhs, rhs);
+
+    case EP_BINARY_OPERATOR_POW:
+    case EP_BINARY_OPERATOR_POWI:
+        return epIntervalPow(lhs, rhs);
+    }
+
+    return EP_INTERVAL_ENTIRE;
+} // epBinaryOperatorApplyInterval
+
+/**
+ * @brief node range by resolved variable symbols computation function
+ * 
+ * @param[in] node          node to compute range of (non-null)
+ * @param[in] symbols       variable symbols (non-null if variableCount != 0)
+ * @param[in] variables     variables (non-null if variableCount != 0)
+ * @param[in] variableCount count of variables
+ * 
+ * @return computation result
+ * 
+ * @note node is computed with explicit stack, same as in epNodeCompute
+ */
+static EpNodeComputeIntervalResult epNodeComputeIntervalSymbols(
+    const EpNode             * node,
+    const EpSymbol           * symbols,
+    const EpIntervalVariable * variables,
+    size_t                     variableCount
+) {
+    // operator nodes whose operands are being computed
+    const EpNode *localFrames[EP_LOCAL_STACK_SIZE];
+    const EpNode **frames = localFrames;
+    size_t frameCount = 0;
+    size_t frameCapacity = EP_LOCAL_STACK_SIZE;
+
+    // computed left hand sides of binary operators whose right hand side is being computed
+    EpInterval localValues[EP_LOCAL_STACK_SIZE];
+    EpInterval *values = localValues;
+    size_t valueCount = 0;
+    size_t valueCapacity = EP_LOCAL_STACK_SIZE;
+
+    EpNodeComputeIntervalResult result = { .status = EP_NODE_COMPUTE_OK, .ok = EP_INTERVAL_EMPTY };
+    EpInterval value = EP_INTERVAL_EMPTY;
+
+    for (;;) {
+        // descend by left spine
+        while (node->type == EP_NODE_BINARY_OPERATOR || node->type == EP_NODE_UNARY_OPERATOR) {
+            if (frameCount + 1 > frameCapacity && !epStackReserve((void **)&frames, &frameCapacity, frameCount + 1, sizeof(const EpNode *), localFrames)) {
+                result = (EpNodeComputeIntervalResult) { .status = EP_NODE_COMPUTE_INTERNAL_ERROR, .unknownVariable = NULL };
+                goto __epNodeComputeIntervalSymbols__end;
+            }
+
+            frames[frameCount++] = node;
+            node = node->type == EP_NODE_BINARY_OPERATOR
+                ? node->binaryOperator.lhs
+                : node->unaryOperator.operand;
+        }
+
+        if (node->type == EP_NODE_CONSTANT) {
+            value = (EpInterval) { .lo = node->constant, .hi = node->constant };
+        } else {
+            size_t i = 0;
+
+            while (i < variableCount && node->variable != symbols[i])
+                i++;
+
+            if (i == variableCount) {
+                result = (EpNodeComputeIntervalResult) {
+                    .status = EP_NODE_COMPUTE_UNKNOWN_VARIABLE,
+                    .unknownVariable = epSymbolName(node->variable)
+                };
+                goto __epNodeComputeIntervalSymbols__end;
+            }
+
+            value = variables[i].value;
+        }
+
+        // ascend while operands of top operator are computed
+        for (;;) {
+            if (frameCount == 0) {
+                result.ok = value;
+                goto __epNodeComputeIntervalSymbols__end;
+            }
+
+            const EpNode *top = frames[frameCount - 1];
+
+            if (top->type == EP_NODE_UNARY_OPERATOR) {
+                value = epUnaryOperatorApplyInterval(top->unaryOperator.op, value);
+                node = top;
+                frameCount--;
+                continue;
+            }
+
+            if (node == top->binaryOperator.rhs) {
+                value = epBinaryOperatorApplyInterval(top->binaryOperator.op, values[--valueCount], value);
+                node = top;
+                frameCount--;
+                continue;
+            }
+
+            if (valueCount + 1 > valueCapacity && !epStackReserve((void **)&values, &valueCapacity, valueCount + 1, sizeof(EpInterval), localValues)) {
+                result = (EpNodeComputeIntervalResult) { .status = EP_NODE_COMPUTE_INTERNAL_ERROR, .unknownVariable = NULL };
+                goto __epNodeComputeIntervalSymbols__end;
+            }
+
+            values[valueCount++] = value;
+            node = top->binaryOperator.rhs;
+            break;
+        }
+    }
+
+__epNodeComputeIntervalSymbols__end:
+    if (frames != localFrames)
+        free(frames);
+    if (values != localValues)
+        free(values);
+    return result;
+} // epNodeComputeIntervalSymbols
+
+EpNodeComputeIntervalResult epNodeComputeInterval(
+    const EpNode             * node,
+    const EpIntervalVariable * variables,
+    size_t                     variableCount
+) {
+    assert(node != NULL);
+    assert(variableCount == 0 || (variableCount != 0 && variables != NULL));
+
+    EpSymbol localSymbols[EP_LOCAL_SYMBOL_COUNT];
+    EpSymbol *symbols = epSymbolsResolve(variables, variableCount, sizeof(EpIntervalVariable), localSymbols);
+
+    if (symbols == NULL)
+        return (EpNodeComputeIntervalResult) { .status = EP_NODE_COMPUTE_INTERNAL_ERROR, .unknownVariable = NULL };
+
+    EpNodeComputeIntervalResult result = epNodeComputeIntervalSymbols(node, symbols, variables, variableCount);
+
+    epSymbolsRelease(symbols, localSymbols);
+    return result;
+} // epNodeComputeInterval
+
+// ep_interval.c
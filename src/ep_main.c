@@ -6,6 +6,7 @@
 #include <assert.h>
 #include <string.h>
 #include <ctype.h>
+#include <stdlib.h>
 
 #define _EP_NODE_SHORT_OPERATORS
 #include "ep.h"
@@ -39,18 +40,18 @@ struct __EplExpression {
     union {
 
         struct {
-            char            varName[EP_NODE_VAR_MAX]; ///< variable to bind in
-            EplExpression * expression;               ///< expression to bind
+            EpSymbol        varName;    ///< variable to bind in
+            EplExpression * expression; ///< expression to bind
         } bind;
 
         struct {
-            char   varName[EP_NODE_VAR_MAX]; ///< variable name
-            size_t substitutionCount;
+            EpSymbol varName;           ///< variable name
+            size_t   substitutionCount;
         } sub;
 
         struct {
-            EpNode * expr;                     ///< expression
-            char     varName[EP_NODE_VAR_MAX]; ///< name of variable to get 
+            EpNode * expr;    ///< expression
+            EpSymbol varName; ///< name of variable to get 
         } derivative;
 
         struct {
@@ -66,23 +67,84 @@ struct __EplExpression {
 
 /// @brief binding representation structure
 typedef struct __EplBinding {
-    char     name[EP_NODE_VAR_MAX]; ///< binding name
-    EpNode * expression;            ///< expression
+    EpSymbol name;       ///< binding name
+    EpNode * expression; ///< expression
 } EplBinding;
 
 /**
- * @brief main project function
+ * @brief newline-separated expression file parsing and dumping function
+ * 
+ * @param[in] path file path
+ * 
+ * @return exit status
+ */
+static int eplMainParseFile( const char *path ) {
+    EpParseStreamResult stream = epParseStream(path, 0);
+
+    if (stream.status != EP_PARSE_STREAM_OK) {
+        printf("File \"%s\" parsing failed.\n", path);
+        epParseStreamResultDtor(&stream);
+        return 1;
+    }
+
+    int status = 0;
+
+    for (size_t i = 0; i < stream.entryCount; i++) {
+        const EpParseStreamEntry *entry = &stream.entries[i];
+
+        if (entry->result.status != EP_PARSE_EXPRESSION_OK) {
+            fprintf(stderr, "%s:%zu: expression parsing failed: %s\n",
+                path,
+                entry->line,
+                epParseExpressionStatusStr(entry->result.status)
+            );
+            status = 1;
+            continue;
+        }
+
+        epNodeDump(stdout, entry->result.ok.result, EP_DUMP_INFIX_EXPRESSION);
+        printf("\n");
+    }
+
+    epParseStreamResultDtor(&stream);
+    return status;
+} // eplMainParseFile
+
+/**
+ * @brief command running function
  * 
  * @param[in] argc argument count
- * @param[in] argv argument values
+ * @param[in] argv argument values (without prefix options)
  * 
  * @return exit status
  */
-int main( const int argc, const char **argv ) {
+static int eplMainRun( const int argc, const char **argv ) {
     const char *expr = "sin(x ^ 2) + 1";
     if (argc <= 1) {
         printf("usage: ./exproc [expression to explore]\n");
+        printf("       ./exproc --file [file with newline-separated expressions]\n");
+        printf("       ./exproc --approx-check\n");
+        printf("       ./exproc --round-trip-check\n");
+        printf("       ./exproc --stats [any of above] (instrumentation counters are dumped to stderr)\n");
+        printf("       ./exproc --trace [trace file] [any of above] (Chrome trace event format)\n");
+        printf("       ./exproc --memory-limit [node memory limit in bytes] [any of above]\n");
         return 0;
+    } else if (strcmp(argv[1], "--approx-check") == 0) {
+        printf("1e-7 accuracy:\n");
+        bool passed7 = epMathApproxCheck(EP_MATH_ACCURACY_APPROX7, stdout);
+        printf("1e-12 accuracy:\n");
+        bool passed12 = epMathApproxCheck(EP_MATH_ACCURACY_APPROX12, stdout);
+
+        return passed7 && passed12 ? 0 : 1;
+    } else if (strcmp(argv[1], "--round-trip-check") == 0) {
+        return epDumpRoundTripCheck(stdout) ? 0 : 1;
+    } else if (strcmp(argv[1], "--file") == 0) {
+        if (argc <= 2) {
+            printf("File path expected after --file.\n");
+            return 1;
+        }
+
+        return eplMainParseFile(argv[2]);
     } else {
         expr = argv[1];
     }
@@ -98,6 +160,7 @@ int main( const int argc, const char **argv ) {
         root = result.ok.result;
     }
     epNodeGenNodeFunctionInfo(stdout, root);
+    epNodeDtor(root);
     return 0;
 
 #if 0
@@ -161,6 +224,108 @@ int main( const int argc, const char **argv ) {
     epNodeDtor(root);
     return 0;
 #endif
+} // eplMainRun
+
+/**
+ * @brief main project function
+ * 
+ * @param[in] argc argument count
+ * @param[in] argv argument values
+ * 
+ * @return exit status
+ */
+int main( int argc, const char **argv ) {
+    bool dumpStats = false;
+    const char *tracePath = NULL;
+    const char *memoryLimit = NULL;
+
+    // prefix options are dropped, so command sees its usual arguments
+    for (;;) {
+        if (argc > 1 && strcmp(argv[1], "--stats") == 0) {
+            dumpStats = true;
+            argv[1] = argv[0];
+            argv++;
+            argc--;
+        } else if (argc > 2 && strcmp(argv[1], "--trace") == 0) {
+            tracePath = argv[2];
+            argv[2] = argv[0];
+            argv += 2;
+            argc -= 2;
+        } else if (argc > 2 && strcmp(argv[1], "--memory-limit") == 0) {
+            memoryLimit = argv[2];
+            argv[2] = argv[0];
+            argv += 2;
+            argc -= 2;
+        } else {
+            break;
+        }
+    }
+
+    EpTrackingAllocator *tracking = NULL;
+
+    if (memoryLimit != NULL) {
+        char *limitEnd = NULL;
+        const unsigned long long limit = strtoull(memoryLimit, &limitEnd, 10);
+
+        if (*memoryLimit == '\0' || *limitEnd != '\0' || limit == 0) {
+            fprintf(stderr, "Invalid memory limit \"%s\".\n", memoryLimit);
+            return 1;
+        }
+
+        if ((tracking = epTrackingAllocatorCtor((size_t)limit)) == NULL) {
+            fprintf(stderr, "Memory limit setting failed.\n");
+            return 1;
+        }
+
+        epNodeAllocatorSetGlobal(epTrackingAllocatorGetAllocator(tracking));
+    }
+
+    FILE *traceFile = NULL;
+
+    if (tracePath != NULL) {
+        traceFile = fopen(tracePath, "w");
+
+        if (traceFile == NULL) {
+            fprintf(stderr, "Trace file \"%s\" opening failed.\n", tracePath);
+            return 1;
+        }
+
+        epTraceStart(0);
+    }
+
+    int status = eplMainRun(argc, argv);
+
+    if (traceFile != NULL) {
+        if (!epTraceStop(traceFile) || fclose(traceFile) != 0) {
+            fprintf(stderr, "Trace file \"%s\" writing failed.\n", tracePath);
+            status = 1;
+        }
+    }
+
+    if (dumpStats) {
+        const EpStats stats = epStatsSnapshot();
+
+        epStatsDump(stderr, &stats);
+    }
+
+    if (tracking != NULL) {
+        const EpTrackingAllocatorStats stats = epTrackingAllocatorGetStats(tracking);
+
+        if (stats.failedCount != 0) {
+            fprintf(stderr, "Node memory limit of %zu bytes was hit (peak %zu bytes, %llu allocations refused).\n",
+                stats.limit,
+                stats.peakBytes,
+                (unsigned long long)stats.failedCount
+            );
+            status = 1;
+        }
+
+        // all nodes are destroyed by now
+        epNodeAllocatorSetGlobal(NULL);
+        epTrackingAllocatorDtor(tracking);
+    }
+
+    return status;
 } // main
 
 // ep_main.c
@@ -7,7 +7,7 @@
 #include <string.h>
 
 #define _EP_NODE_SHORT_OPERATORS
-#include "ep.h"
+#include "ep_internal.h"
 
 /**
  * @brief returns true if 'lhs' is constant node that equel to 'num', false if not
@@ -61,7 +61,37 @@ static EpNode * epOptimizedConstant( double constant ) {
 } // epOptimizedConstant
 
 /**
- * @brief raising to a power optimization function
+ * @brief operator node shell (node without operands) destructor
+ * 
+ * @param[in] node operator node to destroy without its operands (non-null)
+ */
+static void epOptimizeDtorShell( EpNode *node ) {
+    if (node->type == EP_NODE_BINARY_OPERATOR) {
+        node->binaryOperator.lhs = NULL;
+        node->binaryOperator.rhs = NULL;
+    } else if (node->type == EP_NODE_UNARY_OPERATOR) {
+        node->unaryOperator.operand = NULL;
+    }
+
+    epNodeDtor(node);
+} // epOptimizeDtorShell
+
+/**
+ * @brief negation removal function
+ * 
+ * @param[in] node negation node (non-null, consumed)
+ * 
+ * @return negation operand
+ */
+static EpNode * epOptimizeUnwrapNeg( EpNode *node ) {
+    EpNode *operand = node->unaryOperator.operand;
+
+    epOptimizeDtorShell(node);
+    return operand;
+} // epOptimizeUnwrapNeg
+
+/**
+ * @brief raising to an integer power optimization function
  * 
  * @param[in] lhs left operand (nullable)
  * @param[in] rhs right operand (nullable)
@@ -70,35 +100,7 @@ static EpNode * epOptimizedConstant( double constant ) {
  * 
  * @return created node
  */
-static EpNode * epOptimizedPow( EpNode *lhs, EpNode *rhs ) {
-    if (lhs == NULL || rhs == NULL) {
-        epNodeDtor(lhs);
-        epNodeDtor(rhs);
-        return NULL;
-    }
-
-    // check for lhs being neutral element
-    if (epOptimizeIsConstNum(lhs, 1.0)) {
-        epNodeDtor(lhs);
-        epNodeDtor(rhs);
-        return EP_CONST(1.0);
-    }
-
-    // check for rhs being neutral element
-    if (epOptimizeIsConstNum(rhs, 0.0)) {
-        epNodeDtor(lhs);
-        epNodeDtor(rhs);
-        return EP_CONST(1.0);
-    }
-
-    // check for rhs being neutral element
-    if (epOptimizeIsConstNum(rhs, 1.0)) {
-        epNodeDtor(rhs);
-        return lhs;
-    }
-
-    return EP_POW(lhs, rhs);
-} // epOptimizedPow
+static EpNode * epOptimizedPowi( EpNode *lhs, EpNode *rhs );
 
 /**
  * @brief remove lhs and rhs signs as if they are to be multiplied
@@ -117,18 +119,15 @@ static bool epOptimizeRemoveSigns( EpNode **lhsPtr, EpNode **rhsPtr ) {
     bool rhsNeg = rhs->type == EP_NODE_UNARY_OPERATOR && rhs->unaryOperator.op == EP_UNARY_OPERATOR_NEG;
 
     // remove negation
-    if (lhsNeg) {
-        EpNode *newLhs = epNodeCopy(lhs->unaryOperator.operand);
-        epNodeDtor(lhs);
-        *lhsPtr = newLhs;
-    }
+    if (lhsNeg)
+        *lhsPtr = epOptimizeUnwrapNeg(lhs);
 
     // remove negation
-    if (rhsNeg) {
-        EpNode *newRhs = epNodeCopy(rhs->unaryOperator.operand);
-        epNodeDtor(rhs);
-        *rhsPtr = newRhs;
-    }
+    if (rhsNeg)
+        *rhsPtr = epOptimizeUnwrapNeg(rhs);
+
+    if (lhsNeg || rhsNeg)
+        EP_STATS_RULE_HIT(EP_STATS_RULE_SIGN);
 
     return lhsNeg ^ rhsNeg;
 } // epOptimizeRemoveSigns
@@ -154,26 +153,31 @@ static EpNode * epOptimizedMul( EpNode *lhs, EpNode *rhs ) {
     EpNode *result = NULL;
 
     if (epOptimizeIsConstNum(lhs, 1.0)) { // check for lhs being neutral element
+        EP_STATS_RULE_HIT(EP_STATS_RULE_NEUTRAL_ELEMENT);
         epNodeDtor(lhs);
         result = rhs;
     } else if (epOptimizeIsConstNum(rhs, 1.0)) { // check for rhs being neutral element
+        EP_STATS_RULE_HIT(EP_STATS_RULE_NEUTRAL_ELEMENT);
         epNodeDtor(rhs);
         result = lhs;
     } else if (epOptimizeIsConstNum(lhs, 0.0)) { // check for lhs being neutral element
+        EP_STATS_RULE_HIT(EP_STATS_RULE_ABSORBING_ELEMENT);
         epNodeDtor(lhs);
         epNodeDtor(rhs);
 
         isNeg = false;
         result = EP_CONST(0.0);
-    } else if (epOptimizeIsConstNum(lhs, 0.0)) { // check for rhs being neutral element
+    } else if (epOptimizeIsConstNum(rhs, 0.0)) { // check for rhs being neutral element
+        EP_STATS_RULE_HIT(EP_STATS_RULE_ABSORBING_ELEMENT);
         epNodeDtor(lhs);
         epNodeDtor(rhs);
 
         isNeg = false;
         result = EP_CONST(0.0);
     } else if (epNodeIsSame(lhs, rhs)) { // check for node duplication
+        EP_STATS_RULE_HIT(EP_STATS_RULE_SAME_OPERANDS);
         epNodeDtor(rhs);
-        result = EP_POW(lhs, EP_CONST(2.0));
+        result = epOptimizedPowi(lhs, EP_CONST(2.0));
     } else {
         result = EP_MUL(lhs, rhs);
     }
@@ -204,15 +208,18 @@ static EpNode * epOptimizedDiv( EpNode *lhs, EpNode *rhs ) {
     EpNode *result = NULL;
 
     if (epOptimizeIsConstNum(lhs, 0.0)) { // check for rhs being zero
+        EP_STATS_RULE_HIT(EP_STATS_RULE_ABSORBING_ELEMENT);
         epNodeDtor(lhs);
         epNodeDtor(rhs);
 
         isNeg = false;
         result = EP_CONST(0.0);
     } else if (epOptimizeIsConstNum(rhs, 1.0)) { // check for rhs being neutral element
+        EP_STATS_RULE_HIT(EP_STATS_RULE_NEUTRAL_ELEMENT);
         epNodeDtor(rhs);
         result = lhs;
     } else if (epNodeIsSame(lhs, rhs)) {
+        EP_STATS_RULE_HIT(EP_STATS_RULE_SAME_OPERANDS);
         epNodeDtor(lhs);
         epNodeDtor(rhs);
 
@@ -227,6 +234,121 @@ static EpNode * epOptimizedDiv( EpNode *lhs, EpNode *rhs ) {
         : result;
 } // epOptimizedDiv
 
+/**
+ * @brief raising to a power optimization function
+ * 
+ * @param[in] lhs left operand (nullable)
+ * @param[in] rhs right operand (nullable)
+ * 
+ * @note operands assumed to be already optimal
+ * 
+ * @return created node
+ */
+static EpNode * epOptimizedPow( EpNode *lhs, EpNode *rhs ) {
+    if (lhs == NULL || rhs == NULL) {
+        epNodeDtor(lhs);
+        epNodeDtor(rhs);
+        return NULL;
+    }
+
+    // check for lhs being neutral element
+    if (epOptimizeIsConstNum(lhs, 1.0)) {
+        EP_STATS_RULE_HIT(EP_STATS_RULE_ABSORBING_ELEMENT);
+        epNodeDtor(lhs);
+        epNodeDtor(rhs);
+        return EP_CONST(1.0);
+    }
+
+    // check for rhs being neutral element
+    if (epOptimizeIsConstNum(rhs, 0.0)) {
+        EP_STATS_RULE_HIT(EP_STATS_RULE_ABSORBING_ELEMENT);
+        epNodeDtor(lhs);
+        epNodeDtor(rhs);
+        return EP_CONST(1.0);
+    }
+
+    // check for rhs being neutral element
+    if (epOptimizeIsConstNum(rhs, 1.0)) {
+        EP_STATS_RULE_HIT(EP_STATS_RULE_NEUTRAL_ELEMENT);
+        epNodeDtor(rhs);
+        return lhs;
+    }
+
+    // pow(x, 0.5) -> sqrt(x)
+    if (rhs->type == EP_NODE_CONSTANT && rhs->constant == 0.5) {
+        EP_STATS_RULE_HIT(EP_STATS_RULE_POWER);
+        epNodeDtor(rhs);
+        return EP_SQRT(lhs);
+    }
+
+    // pow(e, x) -> exp(x)
+    if (lhs->type == EP_NODE_CONSTANT && lhs->constant == M_E) {
+        EP_STATS_RULE_HIT(EP_STATS_RULE_POWER);
+        epNodeDtor(lhs);
+        return EP_EXP(rhs);
+    }
+
+    double rhsVal = 0.0;
+
+    // pow(x, n) -> powi(x, n), pow(x, -n) -> 1 / powi(x, n)
+    if (epOptimizeIsConst(rhs, &rhsVal) && epDoubleIsInteger(rhsVal) && epDoubleIsInteger(-rhsVal)) {
+        EP_STATS_RULE_HIT(EP_STATS_RULE_POWER);
+        epNodeDtor(rhs);
+
+        return rhsVal > 0
+            ? epOptimizedPowi(lhs, EP_CONST(rhsVal))
+            : epOptimizedDiv(EP_CONST(1.0), epOptimizedPowi(lhs, EP_CONST(-rhsVal)));
+    }
+
+    return EP_POW(lhs, rhs);
+} // epOptimizedPow
+
+static EpNode * epOptimizedPowi( EpNode *lhs, EpNode *rhs ) {
+    if (lhs == NULL || rhs == NULL) {
+        epNodeDtor(lhs);
+        epNodeDtor(rhs);
+        return NULL;
+    }
+
+    // exponent that is not a non-negative integer constant is handled as generic power
+    if (rhs->type != EP_NODE_CONSTANT || !epDoubleIsInteger(rhs->constant) || rhs->constant < 0)
+        return epOptimizedPow(lhs, rhs);
+
+    // check for lhs being neutral element or rhs being zero
+    if (epOptimizeIsConstNum(lhs, 1.0) || rhs->constant == 0.0) {
+        EP_STATS_RULE_HIT(EP_STATS_RULE_ABSORBING_ELEMENT);
+        epNodeDtor(lhs);
+        epNodeDtor(rhs);
+        return EP_CONST(1.0);
+    }
+
+    // check for rhs being neutral element
+    if (rhs->constant == 1.0) {
+        EP_STATS_RULE_HIT(EP_STATS_RULE_NEUTRAL_ELEMENT);
+        epNodeDtor(rhs);
+        return lhs;
+    }
+
+    // powi(powi(x, a), b) -> powi(x, a * b)
+    if (true
+        && lhs->type == EP_NODE_BINARY_OPERATOR
+        && lhs->binaryOperator.op == EP_BINARY_OPERATOR_POWI
+        && lhs->binaryOperator.rhs->type == EP_NODE_CONSTANT
+        && epDoubleIsInteger(lhs->binaryOperator.rhs->constant * rhs->constant)
+    ) {
+        EpNode *base = lhs->binaryOperator.lhs;
+        const double exponent = lhs->binaryOperator.rhs->constant * rhs->constant;
+
+        EP_STATS_RULE_HIT(EP_STATS_RULE_POWER);
+        epNodeDtor(lhs->binaryOperator.rhs);
+        epOptimizeDtorShell(lhs);
+        epNodeDtor(rhs);
+        return epOptimizedPowi(base, EP_CONST(exponent));
+    }
+
+    return EP_POWI(lhs, rhs);
+} // epOptimizedPowi
+
 /**
  * @brief addition optimization function
  * 
@@ -246,17 +368,20 @@ static EpNode * epOptimizedAdd( EpNode *lhs, EpNode *rhs ) {
 
     // check for lhs being neutral element
     if (epOptimizeIsConstNum(lhs, 0.0)) {
+        EP_STATS_RULE_HIT(EP_STATS_RULE_NEUTRAL_ELEMENT);
         epNodeDtor(lhs);
         return rhs;
     }
 
     // check for rhs being neutral element
     if (epOptimizeIsConstNum(rhs, 0.0)) {
+        EP_STATS_RULE_HIT(EP_STATS_RULE_NEUTRAL_ELEMENT);
         epNodeDtor(rhs);
         return lhs;
     }
 
     if (epNodeIsSame(lhs, rhs)) {
+        EP_STATS_RULE_HIT(EP_STATS_RULE_SAME_OPERANDS);
         epNodeDtor(rhs);
         return epOptimizedMul(EP_CONST(2.0), lhs);
     }
@@ -264,9 +389,8 @@ static EpNode * epOptimizedAdd( EpNode *lhs, EpNode *rhs ) {
     bool isSubstraction = rhs->type == EP_NODE_UNARY_OPERATOR && rhs->unaryOperator.op == EP_UNARY_OPERATOR_NEG;
 
     if (isSubstraction) {
-        EpNode *newRhs = epNodeCopy(rhs->unaryOperator.operand);
-        epNodeDtor(rhs);
-        rhs = newRhs;
+        EP_STATS_RULE_HIT(EP_STATS_RULE_SIGN);
+        rhs = epOptimizeUnwrapNeg(rhs);
     }
 
     return isSubstraction
@@ -293,17 +417,20 @@ static EpNode * epOptimizedSub( EpNode *lhs, EpNode *rhs ) {
 
     // check for lhs being neutral element
     if (epOptimizeIsConstNum(lhs, 0.0)) {
+        EP_STATS_RULE_HIT(EP_STATS_RULE_NEUTRAL_ELEMENT);
         epNodeDtor(lhs);
         return EP_NEG(rhs);
     }
 
     // check for rhs being neutral element
     if (epOptimizeIsConstNum(rhs, 0.0)) {
+        EP_STATS_RULE_HIT(EP_STATS_RULE_NEUTRAL_ELEMENT);
         epNodeDtor(rhs);
         return lhs;
     }
 
     if (epNodeIsSame(lhs, rhs)) {
+        EP_STATS_RULE_HIT(EP_STATS_RULE_SAME_OPERANDS);
         epNodeDtor(lhs);
         epNodeDtor(rhs);
         return EP_CONST(0.0);
@@ -312,9 +439,8 @@ static EpNode * epOptimizedSub( EpNode *lhs, EpNode *rhs ) {
     bool isAddition = rhs->type == EP_NODE_UNARY_OPERATOR && rhs->unaryOperator.op == EP_UNARY_OPERATOR_NEG;
 
     if (isAddition) {
-        EpNode *newRhs = epNodeCopy(rhs->unaryOperator.operand);
-        epNodeDtor(rhs);
-        rhs = newRhs;
+        EP_STATS_RULE_HIT(EP_STATS_RULE_SIGN);
+        rhs = epOptimizeUnwrapNeg(rhs);
     }
 
     return isAddition
@@ -332,58 +458,90 @@ static EpNode * epNodeOptimizedNeg( EpNode *node ) {
         return NULL;
 
     if (node->type == EP_NODE_UNARY_OPERATOR && node->unaryOperator.op == EP_UNARY_OPERATOR_NEG) {
-        EpNode *result = epNodeCopy(node->unaryOperator.operand);
-        epNodeDtor(node);
-        return result;
+        EP_STATS_RULE_HIT(EP_STATS_RULE_SIGN);
+        return epOptimizeUnwrapNeg(node);
     }
 
     return EP_NEG(node);
 } // epNodeOptimizedNeg
 
-EpNode * epNodeOptimize( const EpNode *node ) {
+/**
+ * @brief node in-place optimization function (epNodeOptimizeInPlace body without phase accounting)
+ * 
+ * @param[in] node node to optimize (nullable, consumed)
+ * 
+ * @return optimized node (NULL if allocation failed)
+ */
+static EpNode * epOptimizeNode( EpNode *node ) {
+    if (node == NULL)
+        return NULL;
+
     switch (node->type) {
     case EP_NODE_CONSTANT:
-        return epOptimizedConstant(node->constant);
+        // same as epOptimizedConstant, but node is reused
+        if (epDoubleIsSame(node->constant, 0.0)) {
+            node->constant = 0.0;
+            epNodeUpdateHash(node);
+        } else if (node->constant < 0) {
+            node->constant = -node->constant;
+            epNodeUpdateHash(node);
+            return EP_NEG(node);
+        }
+        return node;
 
     case EP_NODE_VARIABLE:
-        return epNodeCopy(node);
+        return node;
 
     case EP_NODE_BINARY_OPERATOR: {
-        EpNode *lhs = epNodeOptimize(node->binaryOperator.lhs);
-        EpNode *rhs = epNodeOptimize(node->binaryOperator.rhs);
+        const EpBinaryOperator binaryOperator = node->binaryOperator.op;
+        EpNode *lhs = epOptimizeNode(node->binaryOperator.lhs);
+        EpNode *rhs = epOptimizeNode(node->binaryOperator.rhs);
         double lhsVal = 0.0;
         double rhsVal = 0.0;
 
-        if (epOptimizeIsConst(lhs, &lhsVal) && epOptimizeIsConst(rhs, &rhsVal)) {
+        // operands are relinked, so shell is freed before new operator node is allocated
+        epOptimizeDtorShell(node);
+
+        if (lhs != NULL && rhs != NULL && epOptimizeIsConst(lhs, &lhsVal) && epOptimizeIsConst(rhs, &rhsVal)) {
+            EP_STATS_RULE_HIT(EP_STATS_RULE_CONSTANT_FOLD);
             epNodeDtor(lhs);
             epNodeDtor(rhs);
 
             return epOptimizedConstant(
-                epBinaryOperatorApply(node->binaryOperator.op, lhsVal, rhsVal)
+                epBinaryOperatorApply(binaryOperator, lhsVal, rhsVal)
             );
         }
 
-        switch (node->binaryOperator.op) {
+        switch (binaryOperator) {
         case EP_BINARY_OPERATOR_ADD: return epOptimizedAdd(lhs, rhs);
         case EP_BINARY_OPERATOR_SUB: return epOptimizedSub(lhs, rhs);
         case EP_BINARY_OPERATOR_MUL: return epOptimizedMul(lhs, rhs);
         case EP_BINARY_OPERATOR_DIV: return epOptimizedDiv(lhs, rhs);
         case EP_BINARY_OPERATOR_POW: return epOptimizedPow(lhs, rhs);
+        case EP_BINARY_OPERATOR_POWI: return epOptimizedPowi(lhs, rhs);
         }
+        break;
     }
 
     case EP_NODE_UNARY_OPERATOR: {
-        EpNode *op = epNodeOptimize(node->unaryOperator.operand);
+        const EpUnaryOperator unaryOperator = node->unaryOperator.op;
+        EpNode *op = epOptimizeNode(node->unaryOperator.operand);
         double opVal = 0.0;
 
+        epOptimizeDtorShell(node);
+
+        if (op == NULL)
+            return NULL;
+
         if (epOptimizeIsConst(op, &opVal)) {
+            EP_STATS_RULE_HIT(EP_STATS_RULE_CONSTANT_FOLD);
             epNodeDtor(op);
             return epOptimizedConstant(
-                epUnaryOperatorApply(node->unaryOperator.op, opVal)
+                epUnaryOperatorApply(unaryOperator, opVal)
             );
         }
 
-        switch (node->unaryOperator.op) {
+        switch (unaryOperator) {
         case EP_UNARY_OPERATOR_NEG  : return epNodeOptimizedNeg(op);
         case EP_UNARY_OPERATOR_LN   : return EP_LN(op);
         case EP_UNARY_OPERATOR_SIN  : return EP_SIN(op);
@@ -394,9 +552,34 @@ EpNode * epNodeOptimize( const EpNode *node ) {
         case EP_UNARY_OPERATOR_ACOS : return EP_ACOS(op);
         case EP_UNARY_OPERATOR_ATAN : return EP_ATAN(op);
         case EP_UNARY_OPERATOR_ACOT : return EP_ACOT(op);
+        case EP_UNARY_OPERATOR_EXP  : return EP_EXP(op);
+        case EP_UNARY_OPERATOR_SQRT : return EP_SQRT(op);
         }
     }
     }
+} // epOptimizeNode
+
+EpNode * epNodeOptimizeInPlace( EpNode *node ) {
+    EP_STATS_PHASE_BEGIN(EP_STATS_PHASE_OPTIMIZE);
+    epTraceBegin("optimize", NULL, 0, node);
+    EpNode *result = epOptimizeNode(node);
+    epTraceEnd("optimize", result);
+    EP_STATS_PHASE_END(EP_STATS_PHASE_OPTIMIZE);
+
+    return result;
+} // epNodeOptimizeInPlace
+
+EpNode * epNodeOptimize( const EpNode *node ) {
+    if (node == NULL)
+        return NULL;
+
+    EP_STATS_PHASE_BEGIN(EP_STATS_PHASE_OPTIMIZE);
+    epTraceBegin("optimize", NULL, 0, node);
+    EpNode *result = epOptimizeNode(epNodeCopy(node));
+    epTraceEnd("optimize", result);
+    EP_STATS_PHASE_END(EP_STATS_PHASE_OPTIMIZE);
+
+    return result;
 } // epNodeOptimize
 
 // ep_optimize.c
@@ -0,0 +1,90 @@
+/**
+ * @brief worker pool implementation file
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "ep_internal.h"
+
+/// @brief worker pool shared state representation structure
+typedef struct __EpParallelPool {
+    EpParallelTask      task;      ///< task function
+    void              * context;   ///< task context
+    size_t              taskCount; ///< count of tasks
+    size_t              nextTask;  ///< index of next task to take (atomic)
+    const EpAllocator * allocator; ///< node allocator of calling thread (inherited by workers)
+} EpParallelPool;
+
+/**
+ * @brief worker main function
+ * 
+ * @param[in] poolPtr worker pool pointer
+ * 
+ * @return NULL
+ */
+static void * epParallelWorker( void *poolPtr ) {
+    EpParallelPool *pool = (EpParallelPool *)poolPtr;
+    const EpAllocator *previousAllocator = epNodeAllocatorSetThread(pool->allocator);
+
+    for (;;) {
+        size_t index = __atomic_fetch_add(&pool->nextTask, 1, __ATOMIC_RELAXED);
+
+        if (index >= pool->taskCount)
+            break;
+
+        pool->task(pool->context, index);
+    }
+
+    epNodeAllocatorSetThread(previousAllocator);
+    return NULL;
+} // epParallelWorker
+
+unsigned int epParallelGetWorkerCount( unsigned int requested ) {
+    if (requested != 0)
+        return requested;
+
+    long processorCount = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return processorCount > 0
+        ? (unsigned int)processorCount
+        : 1;
+} // epParallelGetWorkerCount
+
+void epParallelFor( size_t taskCount, unsigned int workerCount, EpParallelTask task, void *context ) {
+    assert(task != NULL);
+
+    EpParallelPool pool = {
+        .task = task,
+        .context = context,
+        .taskCount = taskCount,
+        .nextTask = 0,
+        .allocator = epNodeAllocatorGet(),
+    };
+
+    workerCount = epParallelGetWorkerCount(workerCount);
+    if (workerCount > taskCount)
+        workerCount = (unsigned int)taskCount;
+
+    // calling thread is worker too
+    size_t threadCount = workerCount > 1 ? workerCount - 1 : 0;
+    pthread_t *threads = threadCount != 0
+        ? (pthread_t *)calloc(threadCount, sizeof(pthread_t))
+        : NULL;
+    size_t startedCount = 0;
+
+    if (threads != NULL)
+        while (startedCount < threadCount && pthread_create(&threads[startedCount], NULL, epParallelWorker, &pool) == 0)
+            startedCount++;
+
+    epParallelWorker(&pool);
+
+    for (size_t i = 0; i < startedCount; i++)
+        pthread_join(threads[i], NULL);
+
+    free(threads);
+} // epParallelFor
+
+// ep_parallel.c
@@ -3,25 +3,29 @@
  */
 
 #include <assert.h>
-#include <ctype.h>
+#include <locale.h>
+#include <pthread.h>
 #include <string.h>
 #include <stdint.h>
 #include <stdlib.h>
 
-#include "ep.h"
+#include "ep_internal.h"
 
 /// @brief token type
 typedef enum __EpParserTokenType {
-    EP_PARSER_TOKEN_NUMBER,   ///< floating point number
-    EP_PARSER_TOKEN_IDENT,    ///< ident
-    EP_PARSER_TOKEN_LEFT_BR,  ///< (
-    EP_PARSER_TOKEN_RIGHT_BR, ///< )
-    EP_PARSER_TOKEN_PLUS,     ///< +
-    EP_PARSER_TOKEN_MINUS,    ///< -
-    EP_PARSER_TOKEN_SLASH,    ///< /
-    EP_PARSER_TOKEN_ASTERISK, ///< *
-    EP_PARSER_TOKEN_CARET,    ///< ^
-    EP_PARSER_TOKEN_END,      ///< \0 (trailing token)
+    EP_PARSER_TOKEN_NUMBER,    ///< floating point number
+    EP_PARSER_TOKEN_IDENT,     ///< ident
+    EP_PARSER_TOKEN_LEFT_BR,   ///< (
+    EP_PARSER_TOKEN_RIGHT_BR,  ///< )
+    EP_PARSER_TOKEN_PLUS,      ///< +
+    EP_PARSER_TOKEN_MINUS,     ///< -
+    EP_PARSER_TOKEN_SLASH,     ///< /
+    EP_PARSER_TOKEN_ASTERISK,  ///< *
+    EP_PARSER_TOKEN_CARET,     ///< ^
+    EP_PARSER_TOKEN_EQUAL,     ///< =
+    EP_PARSER_TOKEN_SEMICOLON, ///< ;
+    EP_PARSER_TOKEN_COMMA,     ///< ,
+    EP_PARSER_TOKEN_END,       ///< \0 (trailing token)
 } EpParserTokenType;
 
 /// @brief token representation structure
@@ -29,18 +33,360 @@ typedef struct __EpParserToken {
     EpParserTokenType type; ///< union 'tag'
 
     union {
-        char ident[EP_NODE_VAR_MAX]; ///< ident token
-        double number;               ///< number
+        struct {
+            const char * text;   ///< ident text (points to parsed string, not null-terminated)
+            size_t       length; ///< ident length
+        } ident;                 ///< ident token
+        double number;           ///< number
     };
 } EpParserToken;
 
 /// @brief parsing context representation structure
 typedef struct __EpParser {
     const char    *         str;     ///< string slice
+    const char    *         end;     ///< string slice end (exclusive)
     EpParserToken           current; ///< current token
     EpParseExpressionResult result;  ///< expression result
 } EpParser;
 
+/// @brief character class (lexer table entry)
+typedef enum __EpParserCharClass {
+    EP_PARSER_CHAR_UNKNOWN,   ///< character that can't start any token
+    EP_PARSER_CHAR_END,       ///< \0
+    EP_PARSER_CHAR_SPACE,     ///< whitespace
+    EP_PARSER_CHAR_DIGIT,     ///< decimal digit
+    EP_PARSER_CHAR_ALPHA,     ///< latin letter or '_'
+    EP_PARSER_CHAR_DOT,       ///< .
+    EP_PARSER_CHAR_PLUS,      ///< +
+    EP_PARSER_CHAR_MINUS,     ///< -
+    EP_PARSER_CHAR_ASTERISK,  ///< *
+    EP_PARSER_CHAR_SLASH,     ///< /
+    EP_PARSER_CHAR_CARET,     ///< ^
+    EP_PARSER_CHAR_LEFT_BR,   ///< (
+    EP_PARSER_CHAR_RIGHT_BR,  ///< )
+    EP_PARSER_CHAR_EQUAL,     ///< =
+    EP_PARSER_CHAR_SEMICOLON, ///< ;
+    EP_PARSER_CHAR_COMMA,     ///< ,
+} EpParserCharClass;
+
+#define U EP_PARSER_CHAR_UNKNOWN
+#define E EP_PARSER_CHAR_END
+#define S EP_PARSER_CHAR_SPACE
+#define D EP_PARSER_CHAR_DIGIT
+#define A EP_PARSER_CHAR_ALPHA
+#define F EP_PARSER_CHAR_DOT
+#define P EP_PARSER_CHAR_PLUS
+#define M EP_PARSER_CHAR_MINUS
+#define T EP_PARSER_CHAR_ASTERISK
+#define L EP_PARSER_CHAR_SLASH
+#define C EP_PARSER_CHAR_CARET
+#define O EP_PARSER_CHAR_LEFT_BR
+#define R EP_PARSER_CHAR_RIGHT_BR
+#define Q EP_PARSER_CHAR_EQUAL
+#define K EP_PARSER_CHAR_SEMICOLON
+#define N EP_PARSER_CHAR_COMMA
+
+/// @brief character class table (locale-independent, 'C' locale classification)
+static const uint8_t epParserCharClassTable[256] = {
+    E, U, U, U, U, U, U, U, U, S, S, S, S, S, U, U,
+    U, U, U, U, U, U, U, U, U, U, U, U, U, U, U, U,
+    S, U, U, U, U, U, U, U, O, R, T, P, N, M, F, L,
+    D, D, D, D, D, D, D, D, D, D, U, K, U, Q, U, U,
+    U, A, A, A, A, A, A, A, A, A, A, A, A, A, A, A,
+    A, A, A, A, A, A, A, A, A, A, A, U, U, U, C, A,
+    U, A, A, A, A, A, A, A, A, A, A, A, A, A, A, A,
+    A, A, A, A, A, A, A, A, A, A, A, U, U, U, U, U,
+    U, U, U, U, U, U, U, U, U, U, U, U, U, U, U, U,
+    U, U, U, U, U, U, U, U, U, U, U, U, U, U, U, U,
+    U, U, U, U, U, U, U, U, U, U, U, U, U, U, U, U,
+    U, U, U, U, U, U, U, U, U, U, U, U, U, U, U, U,
+    U, U, U, U, U, U, U, U, U, U, U, U, U, U, U, U,
+    U, U, U, U, U, U, U, U, U, U, U, U, U, U, U, U,
+    U, U, U, U, U, U, U, U, U, U, U, U, U, U, U, U,
+    U, U, U, U, U, U, U, U, U, U, U, U, U, U, U, U,
+};
+
+#undef U
+#undef E
+#undef S
+#undef D
+#undef A
+#undef F
+#undef P
+#undef M
+#undef T
+#undef L
+#undef C
+#undef O
+#undef R
+#undef Q
+#undef K
+#undef N
+
+/**
+ * @brief character class getting function
+ * 
+ * @param[in] c character
+ * 
+ * @return character class
+ */
+static inline EpParserCharClass epParserCharClass( char c ) {
+    return (EpParserCharClass)epParserCharClassTable[(uint8_t)c];
+} // epParserCharClass
+
+/**
+ * @brief bounded character getting function
+ * 
+ * @param[in] ptr character pointer
+ * @param[in] end string slice end (exclusive)
+ * 
+ * @return character ptr points to or '\0' if ptr is out of slice
+ */
+static inline char epParserCharAt( const char *ptr, const char *end ) {
+    return ptr < end ? *ptr : '\0';
+} // epParserCharAt
+
+/**
+ * @brief ident continuation character checking function
+ * 
+ * @param[in] c character
+ * 
+ * @return true if character may be part of ident, false if not
+ */
+static inline bool epParserIsIdentChar( char c ) {
+    const EpParserCharClass cls = epParserCharClass(c);
+
+    return cls == EP_PARSER_CHAR_ALPHA || cls == EP_PARSER_CHAR_DIGIT;
+} // epParserIsIdentChar
+
+/// @brief 'C' numeric locale slow path numbers are converted in (0 if creation failed)
+static locale_t epParserNumberLocale = (locale_t)0;
+
+/// @brief number locale initialization flag
+static pthread_once_t epParserNumberLocaleOnce = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief number locale creation function
+ */
+static void epParserNumberLocaleCreate( void ) {
+    epParserNumberLocale = newlocale(LC_NUMERIC_MASK, "C", (locale_t)0);
+} // epParserNumberLocaleCreate
+
+/**
+ * @brief locale-independent string to double conversion function
+ * 
+ * @param[in] str null-terminated number text (non-null)
+ * 
+ * @return converted number
+ * 
+ * @note number is converted in 'C' numeric locale, so '.' is decimal point whatever LC_NUMERIC of host program is
+ */
+static double epParserStrtod( const char *str ) {
+    pthread_once(&epParserNumberLocaleOnce, epParserNumberLocaleCreate);
+
+    return epParserNumberLocale != (locale_t)0
+        ? strtod_l(str, NULL, epParserNumberLocale)
+        : strtod(str, NULL);
+} // epParserStrtod
+
+/// @brief maximal count of significant digits that fits in uint64_t
+#define EP_PARSER_NUMBER_MAX_DIGITS 19
+
+/// @brief maximal integer that is exactly representable as double
+#define EP_PARSER_NUMBER_MAX_EXACT ((uint64_t)1 << 53)
+
+/**
+ * @brief decimal number scanning function
+ * 
+ * @param[in]  str number text begin (points to digit or '.')
+ * @param[in]  end string slice end (exclusive)
+ * @param[out] dst number destination (non-null)
+ * 
+ * @return pointer to first character after number (str if there is no number)
+ * 
+ * @note grammar is [0-9]* ('.' [0-9]*)? ([eE] [+-]? [0-9]+)?, at least one mantissa digit required.
+ * Result is exact (correctly rounded) - numbers out of fast path range are converted by strtod in 'C' numeric locale.
+ */
+static const char * epParserScanNumber( const char *str, const char *end, double *dst ) {
+    /// exactly representable powers of 10
+    static const double powersOf10[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+        1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+        1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+    };
+    const int maxExactPower = (int)(sizeof(powersOf10) / sizeof(powersOf10[0])) - 1;
+
+    const char *ptr = str;
+    uint64_t mantissa = 0;
+    int digitCount = 0;     // count of significant digits in mantissa
+    int exponent = 0;       // decimal exponent
+    bool truncated = false; // mantissa digits dropped
+    bool anyDigit = false;
+
+    // skip leading zeros
+    while (epParserCharAt(ptr, end) == '0') {
+        anyDigit = true;
+        ptr++;
+    }
+
+    for (; epParserCharClass(epParserCharAt(ptr, end)) == EP_PARSER_CHAR_DIGIT; ptr++) {
+        anyDigit = true;
+        if (digitCount < EP_PARSER_NUMBER_MAX_DIGITS) {
+            mantissa = mantissa * 10 + (uint64_t)(epParserCharAt(ptr, end) - '0');
+            digitCount++;
+        } else {
+            truncated |= epParserCharAt(ptr, end) != '0';
+            exponent++;
+        }
+    }
+
+    if (epParserCharAt(ptr, end) == '.') {
+        ptr++;
+
+        // skip zeros after point (if there is no significant digits yet)
+        if (digitCount == 0)
+            while (epParserCharAt(ptr, end) == '0') {
+                anyDigit = true;
+                exponent--;
+                ptr++;
+            }
+
+        for (; epParserCharClass(epParserCharAt(ptr, end)) == EP_PARSER_CHAR_DIGIT; ptr++) {
+            anyDigit = true;
+            if (digitCount < EP_PARSER_NUMBER_MAX_DIGITS) {
+                mantissa = mantissa * 10 + (uint64_t)(epParserCharAt(ptr, end) - '0');
+                digitCount++;
+                exponent--;
+            } else {
+                truncated |= epParserCharAt(ptr, end) != '0';
+            }
+        }
+    }
+
+    if (!anyDigit)
+        return str;
+
+    // exponent is parsed only if it contains at least one digit
+    if (epParserCharAt(ptr, end) == 'e' || epParserCharAt(ptr, end) == 'E') {
+        const char *expPtr = ptr + 1;
+        bool expNegative = false;
+
+        if (epParserCharAt(expPtr, end) == '+' || epParserCharAt(expPtr, end) == '-')
+            expNegative = epParserCharAt(expPtr++, end) == '-';
+
+        if (epParserCharClass(epParserCharAt(expPtr, end)) == EP_PARSER_CHAR_DIGIT) {
+            int expValue = 0;
+
+            for (; epParserCharClass(epParserCharAt(expPtr, end)) == EP_PARSER_CHAR_DIGIT; expPtr++)
+                if (expValue < 100000)
+                    expValue = expValue * 10 + (epParserCharAt(expPtr, end) - '0');
+
+            exponent += expNegative ? -expValue : expValue;
+            ptr = expPtr;
+        }
+    }
+
+    // Clinger's fast path: both mantissa and power of 10 are exact, so single rounding occurs
+    if (!truncated && mantissa <= EP_PARSER_NUMBER_MAX_EXACT) {
+        if (mantissa == 0) {
+            *dst = 0.0;
+            return ptr;
+        }
+
+        if (exponent >= 0 && exponent <= maxExactPower) {
+            *dst = (double)mantissa * powersOf10[exponent];
+            return ptr;
+        }
+
+        if (exponent < 0 && -exponent <= maxExactPower) {
+            *dst = (double)mantissa / powersOf10[-exponent];
+            return ptr;
+        }
+    }
+
+    // slow path, number is parsed by same grammar, so strtod would stop at ptr.
+    // Number is copied because slice is not required to be null-terminated.
+    char buffer[128];
+    const size_t length = ptr - str;
+    char *copy = length < sizeof(buffer)
+        ? buffer
+        : (char *)malloc(length + 1);
+
+    if (copy == NULL)
+        return str;
+
+    memcpy(copy, str, length);
+    copy[length] = '\0';
+    *dst = epParserStrtod(copy);
+
+    if (copy != buffer)
+        free(copy);
+    return ptr;
+} // epParserScanNumber
+
+/**
+ * @brief unary operator by name lookup function
+ * 
+ * @param[in]  name   name (non-null)
+ * @param[in]  length name length
+ * @param[out] dst    operator destination (non-null)
+ * 
+ * @return true if name is unary operator name, false if not
+ * 
+ * @note uses perfect hash (length + name[length - 2] + 7 * name[length - 1]) mod 32 on operator name set
+ * (arc functions are accepted both by 'arcsin' and 'asin' names)
+ */
+static bool epParserFindUnaryOperator( const char *name, size_t length, EpUnaryOperator *dst ) {
+    static const struct {
+        const char      * name;   ///< operator name
+        size_t            length; ///< name length
+        EpUnaryOperator   op;     ///< operator
+    } table[32] = {
+        /*  0 */ {NULL    , 0, EP_UNARY_OPERATOR_NEG  },
+        /*  1 */ {"arccot", 6, EP_UNARY_OPERATOR_ACOT },
+        /*  2 */ {"sqrt"  , 4, EP_UNARY_OPERATOR_SQRT },
+        /*  3 */ {NULL    , 0, EP_UNARY_OPERATOR_NEG  },
+        /*  4 */ {NULL    , 0, EP_UNARY_OPERATOR_NEG  },
+        /*  5 */ {NULL    , 0, EP_UNARY_OPERATOR_NEG  },
+        /*  6 */ {"tan"   , 3, EP_UNARY_OPERATOR_TAN  },
+        /*  7 */ {"atan"  , 4, EP_UNARY_OPERATOR_ATAN },
+        /*  8 */ {NULL    , 0, EP_UNARY_OPERATOR_NEG  },
+        /*  9 */ {"arctan", 6, EP_UNARY_OPERATOR_ATAN },
+        /* 10 */ {NULL    , 0, EP_UNARY_OPERATOR_NEG  },
+        /* 11 */ {"exp"   , 3, EP_UNARY_OPERATOR_EXP  },
+        /* 12 */ {NULL    , 0, EP_UNARY_OPERATOR_NEG  },
+        /* 13 */ {NULL    , 0, EP_UNARY_OPERATOR_NEG  },
+        /* 14 */ {"sin"   , 3, EP_UNARY_OPERATOR_SIN  },
+        /* 15 */ {"asin"  , 4, EP_UNARY_OPERATOR_ASIN },
+        /* 16 */ {"ln"    , 2, EP_UNARY_OPERATOR_LN   },
+        /* 17 */ {"arcsin", 6, EP_UNARY_OPERATOR_ASIN },
+        /* 18 */ {NULL    , 0, EP_UNARY_OPERATOR_NEG  },
+        /* 19 */ {NULL    , 0, EP_UNARY_OPERATOR_NEG  },
+        /* 20 */ {NULL    , 0, EP_UNARY_OPERATOR_NEG  },
+        /* 21 */ {NULL    , 0, EP_UNARY_OPERATOR_NEG  },
+        /* 22 */ {NULL    , 0, EP_UNARY_OPERATOR_NEG  },
+        /* 23 */ {"cos"   , 3, EP_UNARY_OPERATOR_COS  },
+        /* 24 */ {"acos"  , 4, EP_UNARY_OPERATOR_ACOS },
+        /* 25 */ {NULL    , 0, EP_UNARY_OPERATOR_NEG  },
+        /* 26 */ {"arccos", 6, EP_UNARY_OPERATOR_ACOS },
+        /* 27 */ {NULL    , 0, EP_UNARY_OPERATOR_NEG  },
+        /* 28 */ {NULL    , 0, EP_UNARY_OPERATOR_NEG  },
+        /* 29 */ {NULL    , 0, EP_UNARY_OPERATOR_NEG  },
+        /* 30 */ {"cot"   , 3, EP_UNARY_OPERATOR_COT  },
+        /* 31 */ {"acot"  , 4, EP_UNARY_OPERATOR_ACOT },
+    };
+
+    if (length < 2)
+        return false;
+
+    const size_t hash = (length + (uint8_t)name[length - 2] + 7 * (size_t)(uint8_t)name[length - 1]) & 31;
+
+    if (table[hash].length != length || memcmp(table[hash].name, name, length) != 0)
+        return false;
+
+    *dst = table[hash].op;
+    return true;
+} // epParserFindUnaryOperator
 
 /**
  * @brief next token parsing function
@@ -50,67 +396,56 @@ typedef struct __EpParser {
  * @return true if parsed successfully, false if smth went wrong
  */
 static bool epParserNext( EpParser *const self ) {
-    while (isspace(*self->str))
+    while (epParserCharClass(epParserCharAt(self->str, self->end)) == EP_PARSER_CHAR_SPACE)
         self->str++;
 
-    const char current = *self->str;
-
-    // quite bad fix, actually
-    if (current == '\0') {
+    switch (epParserCharClass(epParserCharAt(self->str, self->end))) {
+    case EP_PARSER_CHAR_END:
         self->current.type = EP_PARSER_TOKEN_END;
         return true;
-    }
 
-    bool found = true;
-
-    switch (current) {
-    case '+' : self->current.type = EP_PARSER_TOKEN_PLUS     ; break;
-    case '-' : self->current.type = EP_PARSER_TOKEN_MINUS    ; break;
-    case '*' : self->current.type = EP_PARSER_TOKEN_ASTERISK ; break;
-    case '/' : self->current.type = EP_PARSER_TOKEN_SLASH    ; break;
-    case '^' : self->current.type = EP_PARSER_TOKEN_CARET    ; break;
-    case '(' : self->current.type = EP_PARSER_TOKEN_LEFT_BR  ; break;
-    case ')' : self->current.type = EP_PARSER_TOKEN_RIGHT_BR ; break;
-    default : found = false;
-    }
+    case EP_PARSER_CHAR_PLUS     : self->current.type = EP_PARSER_TOKEN_PLUS     ; self->str++; return true;
+    case EP_PARSER_CHAR_MINUS    : self->current.type = EP_PARSER_TOKEN_MINUS    ; self->str++; return true;
+    case EP_PARSER_CHAR_ASTERISK : self->current.type = EP_PARSER_TOKEN_ASTERISK ; self->str++; return true;
+    case EP_PARSER_CHAR_SLASH    : self->current.type = EP_PARSER_TOKEN_SLASH    ; self->str++; return true;
+    case EP_PARSER_CHAR_CARET    : self->current.type = EP_PARSER_TOKEN_CARET    ; self->str++; return true;
+    case EP_PARSER_CHAR_LEFT_BR  : self->current.type = EP_PARSER_TOKEN_LEFT_BR  ; self->str++; return true;
+    case EP_PARSER_CHAR_RIGHT_BR : self->current.type = EP_PARSER_TOKEN_RIGHT_BR ; self->str++; return true;
+    case EP_PARSER_CHAR_EQUAL    : self->current.type = EP_PARSER_TOKEN_EQUAL    ; self->str++; return true;
+    case EP_PARSER_CHAR_SEMICOLON: self->current.type = EP_PARSER_TOKEN_SEMICOLON; self->str++; return true;
+    case EP_PARSER_CHAR_COMMA    : self->current.type = EP_PARSER_TOKEN_COMMA    ; self->str++; return true;
 
-    if (found) {
-        self->str++;
-        return true;
-    }
+    case EP_PARSER_CHAR_DIGIT:
+    case EP_PARSER_CHAR_DOT: {
+        const char *end = epParserScanNumber(self->str, self->end, &self->current.number);
 
-    if (isdigit(current) || current == '-' || current == '.') {
-        char *end = NULL;
+        if (end == self->str)
+            break;
 
         self->current.type = EP_PARSER_TOKEN_NUMBER;
-        self->current.number = strtod(self->str, &end);
-
         self->str = end;
         return true;
     }
 
-    if (isalnum(current) || current == '_') {
-        const char *end = self->str;
+    case EP_PARSER_CHAR_ALPHA: {
+        const char *end = self->str + 1;
 
-        while (isalnum(*end) || *end == '_')
+        while (epParserIsIdentChar(epParserCharAt(end, self->end)))
             end++;
 
-        if (end - self->str >= EP_NODE_VAR_MAX - 1) {
-            self->result.status = EP_PARSE_EXPRESSION_TOO_LONG_VAR_NAME;
-            self->result.tooLongVarName.begin = self->str;
-            self->result.tooLongVarName.end = end;
-
-            return false;
-        }
-
         self->current.type = EP_PARSER_TOKEN_IDENT;
-        memset(self->current.ident, 0, EP_NODE_VAR_MAX);
-        memcpy(self->current.ident, self->str, end - self->str);
+        self->current.ident.text = self->str;
+        self->current.ident.length = end - self->str;
 
         self->str = end;
         return true;
     }
 
+    case EP_PARSER_CHAR_UNKNOWN:
+    case EP_PARSER_CHAR_SPACE:
+        break;
+    }
+
     self->result.status = EP_PARSE_EXPRESSION_UNKNOWN_TOKEN;
     return false;
 } // epParserNext
@@ -118,15 +453,17 @@ static bool epParserNext( EpParser *const self ) {
 /**
  * @brief parser setting up function
  * 
- * @param[in]  str string to parse pointer
+ * @param[in]  str string slice to parse begin
+ * @param[in]  end string slice end (exclusive)
  * @param[out] dst parser pointer (non-null)
  * 
  * @return true if parser initialization succeeded, false if not.
  * @note in case if start failed, dst->result field contains error that happened during parser initialization
  */
-bool epParserStart( const char *str, EpParser *dst ) {
+static bool epParserStart( const char *str, const char *end, EpParser *dst ) {
     *dst = (EpParser) {
         .str = str,
+        .end = end,
         .current = {},
         .result = {},
     };
@@ -134,263 +471,620 @@ bool epParserStart( const char *str, EpParser *dst ) {
     return epParserNext(dst);
 } // epParserStart
 
+/// @brief parser operator stack frame type
+typedef enum __EpParserFrameType {
+    EP_PARSER_FRAME_BINARY_OPERATOR, ///< pending binary operator
+    EP_PARSER_FRAME_UNARY_OPERATOR,  ///< pending prefix unary operator
+    EP_PARSER_FRAME_BRACKET,         ///< opened bracket
+    EP_PARSER_FRAME_CALL_FIRST,      ///< opened binary operator call bracket, first argument is parsed
+    EP_PARSER_FRAME_CALL_SECOND,     ///< opened binary operator call bracket, second argument is parsed
+} EpParserFrameType;
+
+/// @brief parser operator stack frame representation structure
+typedef struct __EpParserFrame {
+    EpParserFrameType type; ///< frame type
+
+    union {
+        EpBinaryOperator binaryOperator; ///< pending binary operator (or called one)
+        EpUnaryOperator  unaryOperator;  ///< pending prefix unary operator
+    };
+} EpParserFrame;
+
+/// @brief let-bound name representation structure
+typedef struct __EpParserBinding {
+    EpSymbol   name;  ///< bound name (EP_SYMBOL_INVALID if slot is empty)
+    EpNode   * value; ///< bound expression
+} EpParserBinding;
+
+/// @brief explicit parsing stacks representation structure
+typedef struct __EpParserStacks {
+    EpParserFrame   * frames;          ///< operator stack
+    size_t            frameCount;      ///< operator stack size
+    size_t            frameCapacity;   ///< operator stack capacity
+
+    EpNode         ** operands;        ///< operand stack
+    size_t            operandCount;    ///< operand stack size
+    size_t            operandCapacity; ///< operand stack capacity
+
+    EpParserBinding * bindings;        ///< let-bound names (open addressing table)
+    size_t            bindingCount;    ///< count of bound names
+    size_t            bindingCapacity; ///< binding table slot count (0 or power of 2)
+} EpParserStacks;
+
 /**
- * @brief '+' and '-' operators parsing function
+ * @brief parser stacks destructor
  * 
- * @param[in]  self parser pointer
- * @param[out] dst  node parsing destination (non-null)
+ * @param[in] stacks stacks to destroy (non-null)
  * 
- * @return true if parsed successfully, false if not.
+ * @note all operands left on stack are destroyed
  */
-static bool epParseSum( EpParser *const self, EpNode **dst );
+static void epParserStacksDtor( EpParserStacks *stacks ) {
+    for (size_t i = 0; i < stacks->operandCount; i++)
+        epNodeDtor(stacks->operands[i]);
+
+    for (size_t i = 0; i < stacks->bindingCapacity; i++)
+        if (stacks->bindings[i].name != EP_SYMBOL_INVALID)
+            epNodeDtor(stacks->bindings[i].value);
+
+    free(stacks->bindings);
+    free(stacks->operands);
+    free(stacks->frames);
+} // epParserStacksDtor
 
 /**
- * @brief '*' and '/' operators parsing function
+ * @brief binding table slot by name finding function
  * 
- * @param[in]  self parser pointer
- * @param[out] dst  node parsing destination (non-null)
+ * @param[in] bindings binding table (non-null)
+ * @param[in] capacity binding table slot count (power of 2)
+ * @param[in] name     name to find slot of
  * 
- * @return true if parsed successfully, false if not.
+ * @return slot bound to name or empty slot name should be placed in
  */
-static bool epParseProduct( EpParser *const self, EpNode **dst );
+static EpParserBinding * epParserFindBindingSlot( EpParserBinding *bindings, size_t capacity, EpSymbol name ) {
+    size_t index = (name * 0x9E3779B1u) & (capacity - 1);
+
+    while (bindings[index].name != EP_SYMBOL_INVALID && bindings[index].name != name)
+        index = (index + 1) & (capacity - 1);
+    return &bindings[index];
+} // epParserFindBindingSlot
 
 /**
- * @brief '^' operator parsing function
+ * @brief bound expression getting function
  * 
- * @param[in]  self parser pointer
- * @param[out] dst  node parsing destination (non-null)
+ * @param[in] stacks stacks (non-null)
+ * @param[in] name   name
  * 
- * @return true if parsed successfully, false if not.
+ * @return expression bound to name (NULL if name is not bound)
  */
-static bool epParsePower( EpParser *const self, EpNode **dst );
+static const EpNode * epParserGetBinding( const EpParserStacks *stacks, EpSymbol name ) {
+    if (stacks->bindingCount == 0)
+        return NULL;
+
+    return epParserFindBindingSlot(stacks->bindings, stacks->bindingCapacity, name)->value;
+} // epParserGetBinding
 
 /**
- * @brief 'basic' expression parsing function (unary operator and number | variable | expression in brackets)
+ * @brief name to expression binding function
  * 
- * @param[in]  self parser pointer
- * @param[out] dst  node parsing destination (non-null)
+ * @param[in] stacks stacks (non-null)
+ * @param[in] name   name to bind (not EP_SYMBOL_INVALID)
+ * @param[in] value  expression to bind (non-null, ownership is taken)
  * 
- * @return true if parsed successfully, false if not.
+ * @note expression previously bound to the same name is destroyed
+ * 
+ * @return true if bound, false if allocation failed (value is destroyed then)
  */
-static bool epParseExpressionImpl( EpParser *const self, EpNode **dst );
+static bool epParserBind( EpParserStacks *stacks, EpSymbol name, EpNode *value ) {
+    // load factor is kept below 1/2
+    if ((stacks->bindingCount + 1) * 2 > stacks->bindingCapacity) {
+        const size_t newCapacity = stacks->bindingCapacity == 0 ? 16 : stacks->bindingCapacity * 2;
+        EpParserBinding *newBindings = (EpParserBinding *)malloc(newCapacity * sizeof(EpParserBinding));
+
+        if (newBindings == NULL) {
+            epNodeDtor(value);
+            return false;
+        }
 
+        for (size_t i = 0; i < newCapacity; i++)
+            newBindings[i] = (EpParserBinding) { .name = EP_SYMBOL_INVALID, .value = NULL };
 
-bool epParseSum( EpParser *const self, EpNode **dst ) {
-    EpNode *lhs = NULL;
+        for (size_t i = 0; i < stacks->bindingCapacity; i++)
+            if (stacks->bindings[i].name != EP_SYMBOL_INVALID)
+                *epParserFindBindingSlot(newBindings, newCapacity, stacks->bindings[i].name) = stacks->bindings[i];
 
-    if (!epParseProduct(self, &lhs))
-        return false;
+        free(stacks->bindings);
+        stacks->bindings = newBindings;
+        stacks->bindingCapacity = newCapacity;
+    }
 
-    for (;;) {
-        EpBinaryOperator op;
+    EpParserBinding *slot = epParserFindBindingSlot(stacks->bindings, stacks->bindingCapacity, name);
 
-        switch (self->current.type) {
-        case EP_PARSER_TOKEN_PLUS  : op = EP_BINARY_OPERATOR_ADD; break;
-        case EP_PARSER_TOKEN_MINUS : op = EP_BINARY_OPERATOR_SUB; break;
+    if (slot->name == EP_SYMBOL_INVALID) {
+        slot->name = name;
+        stacks->bindingCount++;
+    } else {
+        epNodeDtor(slot->value);
+    }
 
-        default:
-            *dst = lhs;
-            return true;
-        }
+    slot->value = value;
+    return true;
+} // epParserBind
 
-        if (!epParserNext(self)) {
-            epNodeDtor(lhs);
+/**
+ * @brief frame pushing function
+ * 
+ * @param[in] stacks stacks (non-null)
+ * @param[in] frame  frame to push
+ * 
+ * @return true if pushed, false if allocation failed
+ */
+static bool epParserPushFrame( EpParserStacks *stacks, EpParserFrame frame ) {
+    if (stacks->frameCount >= stacks->frameCapacity) {
+        size_t newCapacity = stacks->frameCapacity == 0 ? 16 : stacks->frameCapacity * 2;
+        EpParserFrame *newFrames = (EpParserFrame *)realloc(stacks->frames, newCapacity * sizeof(EpParserFrame));
+
+        if (newFrames == NULL)
             return false;
-        }
 
-        // parse rhs
-        EpNode *rhs = NULL;
-        if (!epParseProduct(self, &rhs)) {
-            epNodeDtor(lhs);
+        stacks->frames = newFrames;
+        stacks->frameCapacity = newCapacity;
+    }
+
+    stacks->frames[stacks->frameCount++] = frame;
+    return true;
+} // epParserPushFrame
+
+/**
+ * @brief operand pushing function
+ * 
+ * @param[in] stacks  stacks (non-null)
+ * @param[in] operand operand to push (nullable, ownership is taken)
+ * 
+ * @return true if pushed, false if operand is null or allocation failed
+ */
+static bool epParserPushOperand( EpParserStacks *stacks, EpNode *operand ) {
+    if (operand == NULL)
+        return false;
+
+    if (stacks->operandCount >= stacks->operandCapacity) {
+        size_t newCapacity = stacks->operandCapacity == 0 ? 16 : stacks->operandCapacity * 2;
+        EpNode **newOperands = (EpNode **)realloc(stacks->operands, newCapacity * sizeof(EpNode *));
+
+        if (newOperands == NULL) {
+            epNodeDtor(operand);
             return false;
         }
 
-        // ok, because epNodeBinaryOperator gathers lhs and rhs ownership.
-        lhs = epNodeBinaryOperator(op, lhs, rhs);
+        stacks->operands = newOperands;
+        stacks->operandCapacity = newCapacity;
+    }
 
-        if (lhs == NULL) {
-            self->result.status = EP_PARSE_EXPRESSION_INTERNAL_ERROR;
-            return false;
+    stacks->operands[stacks->operandCount++] = operand;
+    return true;
+} // epParserPushOperand
+
+/**
+ * @brief top binary operator frame reduction function
+ * 
+ * @param[in] stacks stacks (non-null, top frame is binary operator, at least two operands)
+ * 
+ * @return true if reduced, false if allocation failed
+ */
+static bool epParserReduce( EpParserStacks *stacks ) {
+    assert(stacks->frameCount > 0 && stacks->frames[stacks->frameCount - 1].type == EP_PARSER_FRAME_BINARY_OPERATOR);
+    assert(stacks->operandCount >= 2);
+
+    const EpBinaryOperator op = stacks->frames[--stacks->frameCount].binaryOperator;
+    EpNode *rhs = stacks->operands[--stacks->operandCount];
+    EpNode *lhs = stacks->operands[--stacks->operandCount];
+
+    // ok, because epNodeBinaryOperator gathers lhs and rhs ownership.
+    return epParserPushOperand(stacks, epNodeBinaryOperator(op, lhs, rhs));
+} // epParserReduce
+
+/**
+ * @brief top prefix unary operator frame reduction function
+ * 
+ * @param[in] stacks stacks (non-null, top frame is unary operator, at least one operand)
+ * 
+ * @return true if reduced, false if allocation failed
+ */
+static bool epParserReduceUnaryFrame( EpParserStacks *stacks ) {
+    assert(stacks->frameCount > 0 && stacks->frames[stacks->frameCount - 1].type == EP_PARSER_FRAME_UNARY_OPERATOR);
+    assert(stacks->operandCount >= 1);
+
+    const EpUnaryOperator op = stacks->frames[--stacks->frameCount].unaryOperator;
+    EpNode *operand = stacks->operands[--stacks->operandCount];
+
+    return epParserPushOperand(stacks, epNodeUnaryOperator(op, operand));
+} // epParserReduceUnaryFrame
+
+/**
+ * @brief binary operator frames reduction function
+ * 
+ * @param[in] stacks   stacks (non-null)
+ * @param[in] priority minimal priority of operator to reduce
+ * 
+ * @return true if reduced, false if allocation failed
+ * 
+ * @note reduction stops at first bracket frame or operator with lower priority.
+ * Prefix operators left pending before power chain are reduced by any operator with lower priority than power.
+ */
+static bool epParserReduceWhile( EpParserStacks *stacks, int priority ) {
+    const int powerPriority = epBinaryOperatorGetPriority(EP_BINARY_OPERATOR_POW);
+
+    while (stacks->frameCount > 0) {
+        const EpParserFrame *top = &stacks->frames[stacks->frameCount - 1];
+
+        if (top->type == EP_PARSER_FRAME_BINARY_OPERATOR && epBinaryOperatorGetPriority(top->binaryOperator) >= priority) {
+            if (!epParserReduce(stacks))
+                return false;
+        } else if (top->type == EP_PARSER_FRAME_UNARY_OPERATOR && priority < powerPriority) {
+            if (!epParserReduceUnaryFrame(stacks))
+                return false;
+        } else {
+            break;
         }
     }
-} // epParseSum
+    return true;
+} // epParserReduceWhile
+
+/**
+ * @brief prefix unary operator frames reduction function
+ * 
+ * @param[in] stacks      stacks (non-null, top operand is complete operand of top unary operator frames)
+ * @param[in] beforePower true if operand is followed by '^'
+ * 
+ * @return true if reduced, false if allocation failed
+ * 
+ * @note minus binds looser than '^', so if operand is followed by '^', reduction stops at first minus
+ */
+static bool epParserReduceUnary( EpParserStacks *stacks, bool beforePower ) {
+    while (true
+        && stacks->frameCount > 0
+        && stacks->frames[stacks->frameCount - 1].type == EP_PARSER_FRAME_UNARY_OPERATOR
+        && !(beforePower && stacks->frames[stacks->frameCount - 1].unaryOperator == EP_UNARY_OPERATOR_NEG)
+    )
+        if (!epParserReduceUnaryFrame(stacks))
+            return false;
+    return true;
+} // epParserReduceUnary
+
+/**
+ * @brief binary operator token to binary operator conversion function
+ * 
+ * @param[in]  type token type
+ * @param[out] dst  operator destination (non-null)
+ * 
+ * @return true if token is binary operator, false if not
+ */
+static bool epParserTokenBinaryOperator( EpParserTokenType type, EpBinaryOperator *dst ) {
+    switch (type) {
+    case EP_PARSER_TOKEN_PLUS     : *dst = EP_BINARY_OPERATOR_ADD; return true;
+    case EP_PARSER_TOKEN_MINUS    : *dst = EP_BINARY_OPERATOR_SUB; return true;
+    case EP_PARSER_TOKEN_ASTERISK : *dst = EP_BINARY_OPERATOR_MUL; return true;
+    case EP_PARSER_TOKEN_SLASH    : *dst = EP_BINARY_OPERATOR_DIV; return true;
+    case EP_PARSER_TOKEN_CARET    : *dst = EP_BINARY_OPERATOR_POW; return true;
+    default                       : return false;
+    }
+} // epParserTokenBinaryOperator
+
+/**
+ * @brief binary operator call start checking function
+ * 
+ * @param[in,out] self parser pointer (current token is IDENT)
+ * @param[out]    dst  called operator destination (non-null)
+ * 
+ * @return true if IDENT is called operator name followed by '(' (both are consumed then), false if not (parser is not changed then)
+ * 
+ * @note 'powi' is not reserved, so it is still usable as variable name
+ */
+static bool epParserCallStart( EpParser *const self, EpBinaryOperator *dst ) {
+    if (self->current.ident.length != 4 || memcmp(self->current.ident.text, "powi", 4) != 0)
+        return false;
 
-bool epParseProduct( EpParser *const self, EpNode **dst ) {
-    EpNode *lhs = NULL;
+    // lookahead, parser is restored if this is not call
+    const EpParser saved = *self;
 
-    if (!epParsePower(self, &lhs))
+    if (!epParserNext(self) || self->current.type != EP_PARSER_TOKEN_LEFT_BR || !epParserNext(self)) {
+        *self = saved;
         return false;
+    }
+
+    *dst = EP_BINARY_OPERATOR_POWI;
+    return true;
+} // epParserCallStart
 
+/**
+ * @brief expression grammar parsing function
+ * 
+ * @param[in]  self       parser pointer
+ * @param[in]  stacks     parsing stacks (non-null, operator and operand stacks are empty)
+ * @param[in]  terminator token expression must end with (END or SEMICOLON, it is not consumed)
+ * @param[out] dst        node parsing destination (non-null)
+ * 
+ * @return true if parsed successfully, false if not.
+ * 
+ * @note this is iterative precedence climbing (operator stack) parser of grammar:
+ *     Grammar    ::= Sum terminator
+ *     Sum        ::= Product (('+' | '-') Product)*
+ *     Product    ::= Negation (('*' | '/') Negation)*
+ *     Negation   ::= '-' Negation | Power
+ *     Power      ::= Expression ('^' ('-' Negation | Expression))*
+ *     Expression ::= UNARY_OPERATOR ('-' Negation | Expression) | '(' Sum ')' | 'powi' '(' Sum ',' Sum ')' | IDENT | NUMBER
+ * All binary operators are left-associative. Named prefix operators bind tighter than any binary one
+ * ('sin x ^ 2' is '(sin x) ^ 2'), and minus binds looser than '^' ('-x ^ 2' is '-(x ^ 2)', '2 ^ -x ^ 2' is
+ * '2 ^ -(x ^ 2)'). Minus directly before number that is not base of power is parsed as negative constant.
+ * 'powi(x, n)' is integer power node (it is not read from 'x ^ n', which is always generic power).
+ * Let-bound IDENT is replaced by copy of bound expression. Nesting depth is limited only by available memory.
+ */
+static bool epParseGrammar( EpParser *const self, EpParserStacks *stacks, EpParserTokenType terminator, EpNode **dst ) {
     for (;;) {
-        EpBinaryOperator op;
+        // parse prefix unary operators, they are applied when their operand is complete
+        for (;;) {
+            EpUnaryOperator unaryOperator = EP_UNARY_OPERATOR_NEG;
+
+            if (self->current.type != EP_PARSER_TOKEN_MINUS && !(true
+                && self->current.type == EP_PARSER_TOKEN_IDENT
+                && epParserFindUnaryOperator(self->current.ident.text, self->current.ident.length, &unaryOperator)
+            ))
+                break;
 
-        switch (self->current.type) {
-        case EP_PARSER_TOKEN_ASTERISK : op = EP_BINARY_OPERATOR_MUL; break;
-        case EP_PARSER_TOKEN_SLASH    : op = EP_BINARY_OPERATOR_DIV; break;
+            if (!epParserPushFrame(stacks, (EpParserFrame) {
+                .type = EP_PARSER_FRAME_UNARY_OPERATOR,
+                .unaryOperator = unaryOperator,
+            })) {
+                self->result.status = EP_PARSE_EXPRESSION_INTERNAL_ERROR;
+                return false;
+            }
 
-        default:
-            *dst = lhs;
-            return true;
+            if (!epParserNext(self))
+                return false;
         }
 
-        if (!epParserNext(self)) {
-            epNodeDtor(lhs);
-            return false;
-        }
+        EpNode *operand = NULL;
+        bool isNumber = false;
 
-        // parse rhs
-        EpNode *rhs = NULL;
-        if (!epParsePower(self, &rhs)) {
-            epNodeDtor(lhs);
-            return false;
-        }
+        switch (self->current.type) {
+        case EP_PARSER_TOKEN_LEFT_BR: {
+            EpParserFrame frame = { .type = EP_PARSER_FRAME_BRACKET, .binaryOperator = EP_BINARY_OPERATOR_ADD }; // operator is unused
 
-        // ok, because epNodeBinaryOperator gathers lhs and rhs ownership.
-        lhs = epNodeBinaryOperator(op, lhs, rhs);
+            if (!epParserPushFrame(stacks, frame)) {
+                self->result.status = EP_PARSE_EXPRESSION_INTERNAL_ERROR;
+                return false;
+            }
 
-        if (lhs == NULL) {
-            self->result.status = EP_PARSE_EXPRESSION_INTERNAL_ERROR;
-            return false;
+            if (!epParserNext(self))
+                return false;
+            continue; // parse bracket contents
         }
-    }
-} // epParseProduct
 
-bool epParsePower( EpParser *const self, EpNode **dst ) {
-    EpNode *lhs = NULL;
+        case EP_PARSER_TOKEN_IDENT: {
+            EpBinaryOperator callOperator;
 
-    if (!epParseExpressionImpl(self, &lhs))
-        return false;
+            if (epParserCallStart(self, &callOperator)) {
+                if (!epParserPushFrame(stacks, (EpParserFrame) {
+                    .type = EP_PARSER_FRAME_CALL_FIRST,
+                    .binaryOperator = callOperator,
+                })) {
+                    self->result.status = EP_PARSE_EXPRESSION_INTERNAL_ERROR;
+                    return false;
+                }
+                continue; // parse first argument
+            }
 
-    for (;;) {
-        if (self->current.type != EP_PARSER_TOKEN_CARET) {
-            *dst = lhs;
-            return true;
+            const EpSymbol symbol = epSymbolInternSlice(self->current.ident.text, self->current.ident.length);
+
+            if (symbol != EP_SYMBOL_INVALID) {
+                const EpNode *bound = epParserGetBinding(stacks, symbol);
+
+                operand = bound != NULL
+                    ? epNodeCopy(bound)
+                    : epNodeVariableSymbol(symbol);
+            }
+            break;
         }
 
-        if (!epParserNext(self)) {
-            epNodeDtor(lhs);
+        case EP_PARSER_TOKEN_NUMBER:
+            operand = epNodeConstant(self->current.number);
+            isNumber = true;
+            break;
+
+        default:
+            self->result.status = EP_PARSE_EXPRESSION_NUMBER_IDENT_OR_BRACKET_EXPECTED;
             return false;
         }
 
-        // parse rhs
-        EpNode *rhs = NULL;
-        if (!epParseExpressionImpl(self, &rhs)) {
-            epNodeDtor(lhs);
+        if (!epParserNext(self)) {
+            epNodeDtor(operand);
             return false;
         }
 
-        // ok, because epNodeBinaryOperator gathers lhs and rhs ownership.
-        lhs = epNodeBinaryOperator(EP_BINARY_OPERATOR_POW, lhs, rhs);
+        const bool beforePower = self->current.type == EP_PARSER_TOKEN_CARET;
+
+        // innermost minus is folded into constant, unless constant is base of power
+        if (true
+            && isNumber
+            && operand != NULL
+            && !beforePower
+            && stacks->frameCount > 0
+            && stacks->frames[stacks->frameCount - 1].type == EP_PARSER_FRAME_UNARY_OPERATOR
+            && stacks->frames[stacks->frameCount - 1].unaryOperator == EP_UNARY_OPERATOR_NEG
+        ) {
+            stacks->frameCount--;
+            operand->constant = -operand->constant;
+            epNodeUpdateHash(operand);
+        }
 
-        if (lhs == NULL) {
+        if (!epParserPushOperand(stacks, operand) || !epParserReduceUnary(stacks, beforePower)) {
             self->result.status = EP_PARSE_EXPRESSION_INTERNAL_ERROR;
             return false;
         }
-    }
-} // epParsePower
-
-bool epParseExpressionImpl( EpParser *const self, EpNode **dst ) {
-    EpNode *result = NULL;
-
-    EpUnaryOperator unaryOperator = EP_UNARY_OPERATOR_ACOS;
-    bool unaryParsed = false;
-
-    static struct {
-        const char *name;
-        EpUnaryOperator op;
-    } unaryOperators[] = {
-        {"ln"     , EP_UNARY_OPERATOR_LN   },
-        {"sin"    , EP_UNARY_OPERATOR_SIN  },
-        {"cos"    , EP_UNARY_OPERATOR_COS  },
-        {"tan"    , EP_UNARY_OPERATOR_TAN  },
-        {"cot"    , EP_UNARY_OPERATOR_COT  },
-        {"arcsin" , EP_UNARY_OPERATOR_ASIN },
-        {"arccos" , EP_UNARY_OPERATOR_ACOS },
-        {"arctan" , EP_UNARY_OPERATOR_ATAN },
-        {"arccot" , EP_UNARY_OPERATOR_ACOT },
-    };
 
-    // try to parse prefix unary operator
-    if (self->current.type == EP_PARSER_TOKEN_IDENT)
-        for (size_t i = 0; i < sizeof(unaryOperators) / sizeof(unaryOperators[0]); i++)
-            if (strcmp(unaryOperators[i].name, self->current.ident) == 0) {
-                unaryParsed = true;
-                unaryOperator = unaryOperators[i].op;
+        // parse closing brackets and binary operator after operand
+        for (;;) {
+            EpBinaryOperator op;
+
+            if (epParserTokenBinaryOperator(self->current.type, &op)) {
+                if (!epParserReduceWhile(stacks, epBinaryOperatorGetPriority(op)) || !epParserPushFrame(stacks, (EpParserFrame) {
+                    .type = EP_PARSER_FRAME_BINARY_OPERATOR,
+                    .binaryOperator = op,
+                })) {
+                    self->result.status = EP_PARSE_EXPRESSION_INTERNAL_ERROR;
+                    return false;
+                }
 
                 if (!epParserNext(self))
                     return false;
+                break; // parse next operand
+            }
 
-                break;
+            if (!epParserReduceWhile(stacks, 0)) {
+                self->result.status = EP_PARSE_EXPRESSION_INTERNAL_ERROR;
+                return false;
             }
 
-    switch (self->current.type) {
-    case EP_PARSER_TOKEN_LEFT_BR:
-        if (!epParserNext(self))
-            return false;
+            // all binary operators are reduced, so top frame is either bracket (or call) or there is no frames at all
+            if (stacks->frameCount == 0) {
+                if (self->current.type != terminator) {
+                    self->result.status = terminator == EP_PARSER_TOKEN_SEMICOLON
+                        ? EP_PARSE_EXPRESSION_NO_SEMICOLON
+                        : EP_PARSE_EXPRESSION_NO_END;
+                    return false;
+                }
 
-        if (!epParseSum(self, &result))
-            return false;
+                assert(stacks->operandCount == 1);
+                *dst = stacks->operands[--stacks->operandCount];
+                return true;
+            }
 
-        if (self->current.type != EP_PARSER_TOKEN_RIGHT_BR) {
-            epNodeDtor(result);
-            self->result.status = EP_PARSE_EXPRESSION_NO_CLOSING_BRACKET;
-            return false;
-        }
-        break;
+            EpParserFrame *top = &stacks->frames[stacks->frameCount - 1];
 
-    case EP_PARSER_TOKEN_IDENT:
-        result = epNodeVariable(self->current.ident);
-        break;
+            if (top->type == EP_PARSER_FRAME_CALL_FIRST) {
+                if (self->current.type != EP_PARSER_TOKEN_COMMA) {
+                    self->result.status = EP_PARSE_EXPRESSION_NO_COMMA;
+                    return false;
+                }
 
-    case EP_PARSER_TOKEN_NUMBER:
-        result = epNodeConstant(self->current.number);
-        break;
+                top->type = EP_PARSER_FRAME_CALL_SECOND;
 
-    default:
-        self->result.status = EP_PARSE_EXPRESSION_NUMBER_IDENT_OR_BRACKET_EXPECTED;
-        return false;
-    }
+                if (!epParserNext(self))
+                    return false;
+                break; // parse second argument
+            }
 
-    if (!epParserNext(self)) {
-        epNodeDtor(result);
-        return false;
-    }
+            if (self->current.type != EP_PARSER_TOKEN_RIGHT_BR) {
+                self->result.status = EP_PARSE_EXPRESSION_NO_CLOSING_BRACKET;
+                return false;
+            }
 
-    if (unaryParsed)
-        result = epNodeUnaryOperator(unaryOperator, result);
+            // call is reduced as binary operator of its two arguments
+            if (top->type == EP_PARSER_FRAME_CALL_SECOND) {
+                top->type = EP_PARSER_FRAME_BINARY_OPERATOR;
 
-    if (result == NULL) {
-        self->result.status = EP_PARSE_EXPRESSION_INTERNAL_ERROR;
-        return false;
+                if (!epParserReduce(stacks)) {
+                    self->result.status = EP_PARSE_EXPRESSION_INTERNAL_ERROR;
+                    return false;
+                }
+            } else {
+                stacks->frameCount--;
+            }
+
+            if (!epParserNext(self))
+                return false;
+
+            // bracket (or call) contents is complete operand of prefix operators before bracket
+            if (!epParserReduceUnary(stacks, self->current.type == EP_PARSER_TOKEN_CARET)) {
+                self->result.status = EP_PARSE_EXPRESSION_INTERNAL_ERROR;
+                return false;
+            }
+        }
     }
+} // epParseGrammar
 
-    *dst = result;
-    return true;
-} // epParseExpression
+/**
+ * @brief program (expression with let-bindings) parsing function
+ * 
+ * @param[in]  self   parser pointer
+ * @param[in]  stacks parsing stacks (non-null, empty)
+ * @param[out] dst    node parsing destination (non-null)
+ * 
+ * @return true if parsed successfully, false if not.
+ * 
+ * @note grammar is:
+ *     Program ::= ('let' IDENT '=' Sum ';')* Grammar
+ * 'let' is not reserved: it starts binding only if it is followed by IDENT (not unary operator name) and '=',
+ * so it is still usable as variable name. Bound names shadow variables in following expressions.
+ */
+static bool epParseProgram( EpParser *const self, EpParserStacks *stacks, EpNode **dst ) {
+    for (;;) {
+        if (false
+            || self->current.type != EP_PARSER_TOKEN_IDENT
+            || self->current.ident.length != 3
+            || memcmp(self->current.ident.text, "let", 3) != 0
+        )
+            return epParseGrammar(self, stacks, EP_PARSER_TOKEN_END, dst);
+
+        // lookahead, parser is restored if this is not binding
+        const EpParser saved = *self;
+        EpUnaryOperator unaryOperator;
+
+        if (false
+            || !epParserNext(self)
+            || self->current.type != EP_PARSER_TOKEN_IDENT
+            || epParserFindUnaryOperator(self->current.ident.text, self->current.ident.length, &unaryOperator)
+        ) {
+            *self = saved;
+            return epParseGrammar(self, stacks, EP_PARSER_TOKEN_END, dst);
+        }
 
-bool epParseGrammar( EpParser *const self, EpNode **dst ) {
-    EpNode *sumDst = NULL;
+        const char *nameText = self->current.ident.text;
+        const size_t nameLength = self->current.ident.length;
 
-    if (!epParseSum(self, &sumDst))
-        return false;
+        if (!epParserNext(self) || self->current.type != EP_PARSER_TOKEN_EQUAL) {
+            *self = saved;
+            return epParseGrammar(self, stacks, EP_PARSER_TOKEN_END, dst);
+        }
 
-    if (self->current.type != EP_PARSER_TOKEN_END) {
-        epNodeDtor(sumDst);
-        self->result.status = EP_PARSE_EXPRESSION_NO_END;
-        return false;
-    }
+        EpNode *value = NULL;
 
-    *dst = sumDst;
-    return true;
-} // epParseGrammar
+        if (!epParserNext(self) || !epParseGrammar(self, stacks, EP_PARSER_TOKEN_SEMICOLON, &value))
+            return false;
 
-EpParseExpressionResult epParseExpression( const char *str ) {
-    assert(str != NULL);
+        const EpSymbol name = epSymbolInternSlice(nameText, nameLength);
+
+        if (name == EP_SYMBOL_INVALID) {
+            epNodeDtor(value);
+            self->result.status = EP_PARSE_EXPRESSION_INTERNAL_ERROR;
+            return false;
+        }
+
+        if (!epParserBind(stacks, name, value)) {
+            self->result.status = EP_PARSE_EXPRESSION_INTERNAL_ERROR;
+            return false;
+        }
+
+        if (!epParserNext(self))
+            return false;
+    }
+} // epParseProgram
+
+EpParseExpressionResult epParseExpressionSlice( const char *begin, const char *end ) {
+    assert(begin != NULL);
+    assert(end >= begin);
 
     EpParser parser = {};
+    EpParserStacks stacks = {};
     EpNode *dst = NULL;
 
-    return epParserStart(str, &parser) && epParseGrammar(&parser, &dst)
+    EP_STATS_PHASE_BEGIN(EP_STATS_PHASE_PARSE);
+    epTraceBegin("parse", "characters", (uint64_t)(end - begin), NULL);
+    bool parsed = epParserStart(begin, end, &parser) && epParseProgram(&parser, &stacks, &dst);
+    epParserStacksDtor(&stacks);
+    epTraceEnd("parse", parsed ? dst : NULL);
+    EP_STATS_PHASE_END(EP_STATS_PHASE_PARSE);
+
+    return parsed
         ? (EpParseExpressionResult) {
             .status = EP_PARSE_EXPRESSION_OK,
             .ok = {
@@ -400,6 +1094,26 @@ EpParseExpressionResult epParseExpression( const char *str ) {
         }
         : parser.result
     ;
+} // epParseExpressionSlice
+
+EpParseExpressionResult epParseExpression( const char *str ) {
+    assert(str != NULL);
+
+    return epParseExpressionSlice(str, str + strlen(str));
 } // epParseExpression
 
+const char * epParseExpressionStatusStr( EpParseExpressionStatus status ) {
+    switch (status) {
+    case EP_PARSE_EXPRESSION_OK                               : return "ok";
+    case EP_PARSE_EXPRESSION_INTERNAL_ERROR                   : return "internal error";
+    case EP_PARSE_EXPRESSION_NO_CLOSING_BRACKET               : return "no closing bracket";
+    case EP_PARSE_EXPRESSION_UNKNOWN_TOKEN                    : return "unknown token";
+    case EP_PARSE_EXPRESSION_NO_END                           : return "expression end expected";
+    case EP_PARSE_EXPRESSION_UNEXPECTED_EXPRESSION_END        : return "unexpected expression end";
+    case EP_PARSE_EXPRESSION_NUMBER_IDENT_OR_BRACKET_EXPECTED : return "number, ident or bracket expected";
+    case EP_PARSE_EXPRESSION_NO_SEMICOLON                     : return "';' after let-binding expected";
+    case EP_PARSE_EXPRESSION_NO_COMMA                         : return "',' between call arguments expected";
+    }
+} // epParseExpressionStatusStr
+
 // ep_parser.c
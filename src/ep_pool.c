@@ -0,0 +1,655 @@
+/**
+ * @brief index-based compact node pool implementation file
+ */
+
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ep_internal.h"
+
+static_assert(sizeof(EpPoolNode) == 16, "pool node must be two times smaller than binary operator node");
+
+/// @brief count of node values computed without allocation
+#define EP_NODE_POOL_LOCAL_VALUE_COUNT ((size_t)64)
+
+/// @brief count of points computed by one node sweep in batch computation
+#define EP_NODE_POOL_BATCH_SIZE ((size_t)64)
+
+/// @brief pool construction context representation structure
+typedef struct __EpNodePoolBuilder {
+    EpNodePool * pool;         ///< pool under construction
+    size_t       nodeCapacity; ///< pool node array capacity
+} EpNodePoolBuilder;
+
+/**
+ * @brief is unary operator trigonometric function of sine and cosine checking function
+ * 
+ * @param[in] op operator
+ * 
+ * @return true if op is sin, cos, tan or cot, false otherwise
+ */
+static bool epNodePoolIsTrig( EpUnaryOperator op ) {
+    return false
+        || op == EP_UNARY_OPERATOR_SIN
+        || op == EP_UNARY_OPERATOR_COS
+        || op == EP_UNARY_OPERATOR_TAN
+        || op == EP_UNARY_OPERATOR_COT
+    ;
+} // epNodePoolIsTrig
+
+/**
+ * @brief trigonometric function from sine and cosine of argument calculation function
+ * 
+ * @param[in] op  operator (sin, cos, tan or cot)
+ * @param[in] sin argument sine
+ * @param[in] cos argument cosine
+ * 
+ * @return function value
+ */
+static inline double epNodePoolTrigFromSinCos( EpUnaryOperator op, double sin, double cos ) {
+    switch (op) {
+    case EP_UNARY_OPERATOR_SIN: return sin;
+    case EP_UNARY_OPERATOR_COS: return cos;
+    case EP_UNARY_OPERATOR_TAN: return sin / cos;
+    case EP_UNARY_OPERATOR_COT: return cos / sin;
+    default:
+        assert(false && "unreachable");
+        return 0.0;
+    }
+} // epNodePoolTrigFromSinCos
+
+/**
+ * @brief sine and cosine computation function
+ * 
+ * @param[in]  x      argument
+ * @param[out] sinDst sine destination (non-null)
+ * @param[out] cosDst cosine destination (non-null)
+ */
+static inline void epNodePoolSinCos( double x, double *sinDst, double *cosDst ) {
+#ifdef __GLIBC__
+    // argument is reduced once for both functions
+    sincos(x, sinDst, cosDst);
+#else
+    *sinDst = sin(x);
+    *cosDst = cos(x);
+#endif
+} // epNodePoolSinCos
+
+/**
+ * @brief pool subtrees exact equality checking function
+ * 
+ * @param[in] pool  pool (non-null)
+ * @param[in] sizes subtree sizes (non-null)
+ * @param[in] lhs   first subtree root index
+ * @param[in] rhs   second subtree root index
+ * 
+ * @return true if subtrees are same, false otherwise
+ * 
+ * @note subtree is contiguous range in postorder, so subtrees are compared node by node with indices relative to range start
+ */
+static bool epNodePoolSubtreeIsSame( const EpNodePool *pool, const uint32_t *sizes, uint32_t lhs, uint32_t rhs ) {
+    if (sizes[lhs] != sizes[rhs])
+        return false;
+
+    const uint32_t lhsBegin = lhs + 1 - sizes[lhs];
+    const uint32_t rhsBegin = rhs + 1 - sizes[rhs];
+
+    for (uint32_t i = 0; i < sizes[lhs]; i++) {
+        const EpPoolNode *l = &pool->nodes[lhsBegin + i];
+        const EpPoolNode *r = &pool->nodes[rhsBegin + i];
+        const EpNodeType type = EP_POOL_NODE_TYPE(l->info);
+
+        if (type != EP_POOL_NODE_TYPE(r->info))
+            return false;
+
+        switch (type) {
+        case EP_NODE_VARIABLE:
+            if (l->info != r->info)
+                return false;
+            break;
+
+        case EP_NODE_CONSTANT:
+            if (memcmp(&l->constant, &r->constant, sizeof(double)) != 0)
+                return false;
+            break;
+
+        case EP_NODE_BINARY_OPERATOR:
+            if (EP_POOL_NODE_OP(l->info) != EP_POOL_NODE_OP(r->info) || l->lhs - lhsBegin != r->lhs - rhsBegin || l->rhs - lhsBegin != r->rhs - rhsBegin)
+                return false;
+            break;
+
+        // trigonometric role is not compared, because it doesn't affect value
+        case EP_NODE_UNARY_OPERATOR:
+            if (EP_POOL_NODE_OP(l->info) != EP_POOL_NODE_OP(r->info) || l->lhs - lhsBegin != r->lhs - rhsBegin)
+                return false;
+            break;
+        }
+    }
+
+    return true;
+} // epNodePoolSubtreeIsSame
+
+/// @brief trigonometric node grouping candidate representation structure
+typedef struct __EpNodePoolTrigCandidate {
+    uint32_t hash;  ///< operand subtree hash
+    uint32_t index; ///< node index
+} EpNodePoolTrigCandidate;
+
+/**
+ * @brief trigonometric grouping candidates comparison function (qsort comparator)
+ * 
+ * @param[in] lhs first candidate
+ * @param[in] rhs second candidate
+ * 
+ * @return comparison result (by hash, then by index)
+ */
+static int epNodePoolTrigCandidateCompare( const void *lhs, const void *rhs ) {
+    const EpNodePoolTrigCandidate *l = (const EpNodePoolTrigCandidate *)lhs;
+    const EpNodePoolTrigCandidate *r = (const EpNodePoolTrigCandidate *)rhs;
+
+    if (l->hash != r->hash)
+        return l->hash < r->hash ? -1 : 1;
+    if (l->index != r->index)
+        return l->index < r->index ? -1 : 1;
+    return 0;
+} // epNodePoolTrigCandidateCompare
+
+/**
+ * @brief sin/cos/tan/cot nodes of same arguments grouping function
+ * 
+ * @param[in,out] pool pool to group nodes of (non-null)
+ * 
+ * @note pool is left unchanged if allocation failed
+ */
+static void epNodePoolGroupTrig( EpNodePool *pool ) {
+    uint32_t candidateCount = 0;
+
+    for (uint32_t i = 0; i < pool->nodeCount; i++)
+        if (EP_POOL_NODE_TYPE(pool->nodes[i].info) == EP_NODE_UNARY_OPERATOR && epNodePoolIsTrig((EpUnaryOperator)EP_POOL_NODE_OP(pool->nodes[i].info)))
+            candidateCount++;
+
+    if (candidateCount < 2)
+        return;
+
+    uint32_t *sizes = (uint32_t *)malloc(pool->nodeCount * sizeof(uint32_t));
+    uint32_t *hashes = (uint32_t *)malloc(pool->nodeCount * sizeof(uint32_t));
+    EpNodePoolTrigCandidate *candidates = (EpNodePoolTrigCandidate *)malloc(candidateCount * sizeof(EpNodePoolTrigCandidate));
+    uint32_t *lastMembers = (uint32_t *)malloc(candidateCount * sizeof(uint32_t));
+
+    if (sizes == NULL || hashes == NULL || candidates == NULL || lastMembers == NULL)
+        goto __epNodePoolGroupTrig__end;
+
+    // subtree sizes and hashes, children precede parents
+    candidateCount = 0;
+    for (uint32_t i = 0; i < pool->nodeCount; i++) {
+        const EpPoolNode *node = &pool->nodes[i];
+        uint64_t hash = EP_POOL_NODE_TYPE(node->info) | (uint64_t)EP_POOL_NODE_OP(node->info) << 8;
+
+        sizes[i] = 1;
+
+        switch (EP_POOL_NODE_TYPE(node->info)) {
+        case EP_NODE_VARIABLE:
+            hash ^= (uint64_t)EP_POOL_NODE_SYMBOL(node->info) << 16;
+            break;
+
+        case EP_NODE_CONSTANT: {
+            uint64_t bits;
+
+            memcpy(&bits, &node->constant, sizeof(bits));
+            hash ^= bits;
+            break;
+        }
+
+        case EP_NODE_BINARY_OPERATOR:
+            sizes[i] += sizes[node->lhs] + sizes[node->rhs];
+            hash = (hash * 31 + hashes[node->lhs]) * 31 + hashes[node->rhs];
+            break;
+
+        case EP_NODE_UNARY_OPERATOR:
+            sizes[i] += sizes[node->lhs];
+            hash = hash * 31 + hashes[node->lhs];
+
+            if (epNodePoolIsTrig((EpUnaryOperator)EP_POOL_NODE_OP(node->info)))
+                candidates[candidateCount++] = (EpNodePoolTrigCandidate) { .hash = hashes[node->lhs], .index = i };
+            break;
+        }
+
+        hash *= 0x9E3779B97F4A7C15ull;
+        hashes[i] = (uint32_t)(hash >> 32);
+    }
+
+    qsort(candidates, candidateCount, sizeof(EpNodePoolTrigCandidate), epNodePoolTrigCandidateCompare);
+
+    // group candidates of same argument, every run of same hash is in index order, so group lead precedes members
+    for (uint32_t begin = 0; begin < candidateCount; ) {
+        uint32_t end = begin + 1;
+
+        while (end < candidateCount && candidates[end].hash == candidates[begin].hash)
+            end++;
+
+        for (uint32_t i = begin; i < end; i++) {
+            EpPoolNode *lead = &pool->nodes[candidates[i].index];
+
+            if (EP_POOL_NODE_TRIG_ROLE(lead->info) != EP_POOL_TRIG_SINGLE)
+                continue;
+
+            lastMembers[i] = candidates[i].index;
+
+            for (uint32_t j = i + 1; j < end; j++) {
+                EpPoolNode *member = &pool->nodes[candidates[j].index];
+
+                if (EP_POOL_NODE_TRIG_ROLE(member->info) != EP_POOL_TRIG_SINGLE || !epNodePoolSubtreeIsSame(pool, sizes, lead->lhs, member->lhs))
+                    continue;
+
+                member->info = EP_POOL_NODE_INFO(EP_NODE_UNARY_OPERATOR, EP_POOL_NODE_OP(member->info), EP_POOL_TRIG_MEMBER);
+                member->rhs = 0;
+                pool->nodes[lastMembers[i]].rhs = candidates[j].index;
+                lastMembers[i] = candidates[j].index;
+            }
+
+            if (lastMembers[i] != candidates[i].index)
+                lead->info = EP_POOL_NODE_INFO(EP_NODE_UNARY_OPERATOR, EP_POOL_NODE_OP(lead->info), EP_POOL_TRIG_LEAD);
+        }
+
+        begin = end;
+    }
+
+__epNodePoolGroupTrig__end:
+    free(sizes);
+    free(hashes);
+    free(candidates);
+    free(lastMembers);
+} // epNodePoolGroupTrig
+
+/**
+ * @brief flat node to pool appending function (EpFlatNodeVisitor)
+ * 
+ * @param[in,out] context pool builder (non-null)
+ * @param[in]     node    flat node (non-null)
+ * 
+ * @return true if appended, false if allocation failed or variable symbol doesn't fit into pool node
+ */
+static bool epNodePoolAppend( void *context, const EpFlatNode *node ) {
+    EpNodePoolBuilder *builder = (EpNodePoolBuilder *)context;
+    EpPoolNode poolNode = {
+        .info = EP_POOL_NODE_INFO(node->type, 0, 0),
+        .lhs = 0,
+        .rhs = 0,
+    };
+
+    switch (node->type) {
+    case EP_NODE_VARIABLE:
+        if (node->variable > EP_POOL_NODE_SYMBOL_MAX)
+            return false;
+        poolNode.info = EP_POOL_NODE_INFO(EP_NODE_VARIABLE, 0, node->variable);
+        break;
+
+    case EP_NODE_CONSTANT:
+        poolNode.constant = node->constant;
+        break;
+
+    case EP_NODE_BINARY_OPERATOR:
+        poolNode.info = EP_POOL_NODE_INFO(EP_NODE_BINARY_OPERATOR, node->binaryOperator.op, 0);
+        poolNode.lhs = node->binaryOperator.lhs;
+        poolNode.rhs = node->binaryOperator.rhs;
+        break;
+
+    case EP_NODE_UNARY_OPERATOR:
+        poolNode.info = EP_POOL_NODE_INFO(EP_NODE_UNARY_OPERATOR, node->unaryOperator.op, 0);
+        poolNode.lhs = node->unaryOperator.operand;
+        break;
+    }
+
+    EpNodePool *pool = builder->pool;
+
+    if (!epArrayReserve((void **)&pool->nodes, &builder->nodeCapacity, (size_t)pool->nodeCount + 1, sizeof(EpPoolNode)))
+        return false;
+
+    pool->nodes[pool->nodeCount++] = poolNode;
+    return true;
+} // epNodePoolAppend
+
+EpNodePool * epNodePoolFromNode( const EpNode *node ) {
+    assert(node != NULL);
+
+    EpNodePoolBuilder builder = {
+        .pool = (EpNodePool *)calloc(1, sizeof(EpNodePool)),
+        .nodeCapacity = 0,
+    };
+
+    if (builder.pool == NULL)
+        return NULL;
+
+    if (!epNodeFlatten(node, epNodePoolAppend, &builder)) {
+        epNodePoolDtor(builder.pool);
+        return NULL;
+    }
+
+    epNodePoolGroupTrig(builder.pool);
+    return builder.pool;
+} // epNodePoolFromNode
+
+void epNodePoolDtor( EpNodePool *pool ) {
+    if (pool == NULL)
+        return;
+
+    free(pool->nodes);
+    free(pool);
+} // epNodePoolDtor
+
+/**
+ * @brief pool node to flat node conversion function (EpFlatNodeGetter)
+ * 
+ * @param[in]  context pool (non-null)
+ * @param[in]  index   node index
+ * @param[out] dst     flat node destination (non-null)
+ * 
+ * @return true
+ */
+static bool epNodePoolGetFlatNode( const void *context, uint32_t index, EpFlatNode *dst ) {
+    const EpPoolNode *poolNode = &((const EpNodePool *)context)->nodes[index];
+
+    dst->type = EP_POOL_NODE_TYPE(poolNode->info);
+
+    switch (dst->type) {
+    case EP_NODE_VARIABLE:
+        dst->variable = EP_POOL_NODE_SYMBOL(poolNode->info);
+        break;
+
+    case EP_NODE_CONSTANT:
+        dst->constant = poolNode->constant;
+        break;
+
+    case EP_NODE_BINARY_OPERATOR:
+        dst->binaryOperator.op = (EpBinaryOperator)EP_POOL_NODE_OP(poolNode->info);
+        dst->binaryOperator.lhs = poolNode->lhs;
+        dst->binaryOperator.rhs = poolNode->rhs;
+        break;
+
+    case EP_NODE_UNARY_OPERATOR:
+        dst->unaryOperator.op = (EpUnaryOperator)EP_POOL_NODE_OP(poolNode->info);
+        dst->unaryOperator.operand = poolNode->lhs;
+        break;
+    }
+
+    return true;
+} // epNodePoolGetFlatNode
+
+EpNode * epNodePoolToNode( const EpNodePool *pool ) {
+    assert(pool != NULL && pool->nodeCount != 0);
+
+    return epNodeUnflatten(epNodePoolGetFlatNode, pool, pool->nodeCount);
+} // epNodePoolToNode
+
+EpNodeComputeResult epNodePoolCompute(
+    const EpNodePool * pool,
+    const EpVariable * variables,
+    size_t             variableCount
+) {
+    assert(pool != NULL && pool->nodeCount != 0);
+    assert(variableCount == 0 || (variableCount != 0 && variables != NULL));
+
+    double localValues[EP_NODE_POOL_LOCAL_VALUE_COUNT];
+    EpSymbol localSymbols[EP_LOCAL_SYMBOL_COUNT];
+    double *values = pool->nodeCount <= EP_NODE_POOL_LOCAL_VALUE_COUNT
+        ? localValues
+        : (double *)malloc(pool->nodeCount * sizeof(double));
+    EpSymbol *symbols = epSymbolsResolve(variables, variableCount, sizeof(EpVariable), localSymbols);
+
+    EpNodeComputeResult result = { .status = EP_NODE_COMPUTE_OK, .ok = 0.0 };
+
+    if (values == NULL || symbols == NULL) {
+        result = (EpNodeComputeResult) {
+            .status = EP_NODE_COMPUTE_INTERNAL_ERROR,
+            .unknownVariable = NULL,
+        };
+        goto __epNodePoolCompute__end;
+    }
+
+    for (uint32_t i = 0; i < pool->nodeCount; i++) {
+        const EpPoolNode *node = &pool->nodes[i];
+
+        switch (EP_POOL_NODE_TYPE(node->info)) {
+        case EP_NODE_VARIABLE: {
+            const EpSymbol symbol = EP_POOL_NODE_SYMBOL(node->info);
+            size_t j = 0;
+
+            while (j < variableCount && symbols[j] != symbol)
+                j++;
+
+            if (j == variableCount) {
+                result = (EpNodeComputeResult) {
+                    .status = EP_NODE_COMPUTE_UNKNOWN_VARIABLE,
+                    .unknownVariable = epSymbolName(symbol),
+                };
+                goto __epNodePoolCompute__end;
+            }
+
+            values[i] = variables[j].value;
+            break;
+        }
+
+        case EP_NODE_CONSTANT:
+            values[i] = node->constant;
+            break;
+
+        case EP_NODE_BINARY_OPERATOR:
+            values[i] = epBinaryOperatorApply((EpBinaryOperator)EP_POOL_NODE_OP(node->info), values[node->lhs], values[node->rhs]);
+            break;
+
+        case EP_NODE_UNARY_OPERATOR:
+            switch (EP_POOL_NODE_TRIG_ROLE(node->info)) {
+            case EP_POOL_TRIG_SINGLE:
+                values[i] = epUnaryOperatorApply((EpUnaryOperator)EP_POOL_NODE_OP(node->info), values[node->lhs]);
+                break;
+
+            case EP_POOL_TRIG_LEAD: {
+                double sin, cos;
+
+                epNodePoolSinCos(values[node->lhs], &sin, &cos);
+                for (uint32_t j = i; j != 0; j = pool->nodes[j].rhs)
+                    values[j] = epNodePoolTrigFromSinCos((EpUnaryOperator)EP_POOL_NODE_OP(pool->nodes[j].info), sin, cos);
+                break;
+            }
+
+            case EP_POOL_TRIG_MEMBER:
+                break;
+            }
+            break;
+        }
+    }
+
+    result.ok = values[pool->nodeCount - 1];
+
+__epNodePoolCompute__end:
+    if (values != localValues)
+        free(values);
+    epSymbolsRelease(symbols, localSymbols);
+    return result;
+} // epNodePoolCompute
+
+/**
+ * @brief node pool values at several points computation implementation function
+ * 
+ * @param[in]  pool          pool to compute (non-null, non-empty)
+ * @param[in]  variables     variables used in computation array (non-null if variableCount != 0)
+ * @param[in]  variableCount count of variables used in computation
+ * @param[in]  pointCount    count of points to compute pool at
+ * @param[in]  accuracy      accuracy of math functions
+ * @param[out] results       computation results destination (non-null if pointCount != 0)
+ * 
+ * @return computation status
+ */
+static EpNodeComputeResult epNodePoolComputeBatchImpl(
+    const EpNodePool      * pool,
+    const EpBatchVariable * variables,
+    size_t                  variableCount,
+    size_t                  pointCount,
+    EpMathAccuracy          accuracy,
+    double                * results
+) {
+    assert(pool != NULL && pool->nodeCount != 0);
+    assert(variableCount == 0 || (variableCount != 0 && variables != NULL));
+    assert(pointCount == 0 || (pointCount != 0 && results != NULL));
+
+    // values of every node at every point of block, node values are contiguous
+    double *values = (double *)malloc((size_t)pool->nodeCount * EP_NODE_POOL_BATCH_SIZE * sizeof(double));
+    // variable index of every variable node
+    size_t *variableIndices = (size_t *)malloc(pool->nodeCount * sizeof(size_t));
+    EpSymbol localSymbols[EP_LOCAL_SYMBOL_COUNT];
+    EpSymbol *symbols = epSymbolsResolve(variables, variableCount, sizeof(EpBatchVariable), localSymbols);
+
+    EpNodeComputeResult result = { .status = EP_NODE_COMPUTE_OK, .ok = 0.0 };
+
+    if (values == NULL || variableIndices == NULL || symbols == NULL) {
+        result = (EpNodeComputeResult) {
+            .status = EP_NODE_COMPUTE_INTERNAL_ERROR,
+            .unknownVariable = NULL,
+        };
+        goto __epNodePoolComputeBatchImpl__end;
+    }
+
+    // resolve variables once for all points
+    for (uint32_t i = 0; i < pool->nodeCount; i++) {
+        if (EP_POOL_NODE_TYPE(pool->nodes[i].info) != EP_NODE_VARIABLE)
+            continue;
+
+        const EpSymbol symbol = EP_POOL_NODE_SYMBOL(pool->nodes[i].info);
+        size_t j = 0;
+
+        while (j < variableCount && symbols[j] != symbol)
+            j++;
+
+        if (j == variableCount) {
+            result = (EpNodeComputeResult) {
+                .status = EP_NODE_COMPUTE_UNKNOWN_VARIABLE,
+                .unknownVariable = epSymbolName(symbol),
+            };
+            goto __epNodePoolComputeBatchImpl__end;
+        }
+
+        variableIndices[i] = j;
+    }
+
+    for (size_t blockBegin = 0; blockBegin < pointCount; blockBegin += EP_NODE_POOL_BATCH_SIZE) {
+        const size_t blockSize = pointCount - blockBegin < EP_NODE_POOL_BATCH_SIZE
+            ? pointCount - blockBegin
+            : EP_NODE_POOL_BATCH_SIZE;
+
+        for (uint32_t i = 0; i < pool->nodeCount; i++) {
+            const EpPoolNode *node = &pool->nodes[i];
+            double *dst = values + (size_t)i * EP_NODE_POOL_BATCH_SIZE;
+
+            switch (EP_POOL_NODE_TYPE(node->info)) {
+            case EP_NODE_VARIABLE:
+                memcpy(dst, variables[variableIndices[i]].values + blockBegin, blockSize * sizeof(double));
+                break;
+
+            case EP_NODE_CONSTANT:
+                for (size_t k = 0; k < blockSize; k++)
+                    dst[k] = node->constant;
+                break;
+
+            case EP_NODE_BINARY_OPERATOR: {
+                const double *lhs = values + (size_t)node->lhs * EP_NODE_POOL_BATCH_SIZE;
+                const double *rhs = values + (size_t)node->rhs * EP_NODE_POOL_BATCH_SIZE;
+                const EpBinaryOperator op = (EpBinaryOperator)EP_POOL_NODE_OP(node->info);
+
+                // operator is dispatched once per block, so arithmetic loops are plain element-wise loops
+                switch (op) {
+                case EP_BINARY_OPERATOR_ADD: for (size_t k = 0; k < blockSize; k++) dst[k] = lhs[k] + rhs[k]; break;
+                case EP_BINARY_OPERATOR_SUB: for (size_t k = 0; k < blockSize; k++) dst[k] = lhs[k] - rhs[k]; break;
+                case EP_BINARY_OPERATOR_MUL: for (size_t k = 0; k < blockSize; k++) dst[k] = lhs[k] * rhs[k]; break;
+                case EP_BINARY_OPERATOR_DIV: for (size_t k = 0; k < blockSize; k++) dst[k] = lhs[k] / rhs[k]; break;
+                case EP_BINARY_OPERATOR_POW: epApproxPowArray(accuracy, lhs, rhs, dst, blockSize); break;
+                default:
+                    for (size_t k = 0; k < blockSize; k++)
+                        dst[k] = epBinaryOperatorApply(op, lhs[k], rhs[k]);
+                    break;
+                }
+                break;
+            }
+
+            case EP_NODE_UNARY_OPERATOR: {
+                const double *operand = values + (size_t)node->lhs * EP_NODE_POOL_BATCH_SIZE;
+                const EpUnaryOperator op = (EpUnaryOperator)EP_POOL_NODE_OP(node->info);
+
+                switch (EP_POOL_NODE_TRIG_ROLE(node->info)) {
+                case EP_POOL_TRIG_SINGLE:
+                    if (op == EP_UNARY_OPERATOR_NEG)
+                        for (size_t k = 0; k < blockSize; k++)
+                            dst[k] = -operand[k];
+                    else
+                        epApproxUnaryApplyArray(op, accuracy, operand, dst, blockSize);
+                    break;
+
+                case EP_POOL_TRIG_LEAD:
+                    if (accuracy == EP_MATH_ACCURACY_EXACT) {
+                        for (size_t k = 0; k < blockSize; k++) {
+                            double sin, cos;
+
+                            epNodePoolSinCos(operand[k], &sin, &cos);
+                            for (uint32_t j = i; j != 0; j = pool->nodes[j].rhs)
+                                values[(size_t)j * EP_NODE_POOL_BATCH_SIZE + k] = epNodePoolTrigFromSinCos(
+                                    (EpUnaryOperator)EP_POOL_NODE_OP(pool->nodes[j].info),
+                                    sin,
+                                    cos
+                                );
+                        }
+                    } else {
+                        double sin[EP_NODE_POOL_BATCH_SIZE];
+                        double cos[EP_NODE_POOL_BATCH_SIZE];
+
+                        epApproxSinCosArray(accuracy, operand, sin, cos, blockSize);
+                        for (uint32_t j = i; j != 0; j = pool->nodes[j].rhs) {
+                            const EpUnaryOperator trigOp = (EpUnaryOperator)EP_POOL_NODE_OP(pool->nodes[j].info);
+                            double *trigDst = values + (size_t)j * EP_NODE_POOL_BATCH_SIZE;
+
+                            for (size_t k = 0; k < blockSize; k++)
+                                trigDst[k] = epNodePoolTrigFromSinCos(trigOp, sin[k], cos[k]);
+                        }
+                    }
+                    break;
+
+                case EP_POOL_TRIG_MEMBER:
+                    break;
+                }
+                break;
+            }
+            }
+        }
+
+        memcpy(results + blockBegin, values + (size_t)(pool->nodeCount - 1) * EP_NODE_POOL_BATCH_SIZE, blockSize * sizeof(double));
+    }
+
+__epNodePoolComputeBatchImpl__end:
+    free(values);
+    free(variableIndices);
+    epSymbolsRelease(symbols, localSymbols);
+    return result;
+} // epNodePoolComputeBatchImpl
+
+EpNodeComputeResult epNodePoolComputeBatch(
+    const EpNodePool      * pool,
+    const EpBatchVariable * variables,
+    size_t                  variableCount,
+    size_t                  pointCount,
+    double                * results
+) {
+    return epNodePoolComputeBatchImpl(pool, variables, variableCount, pointCount, EP_MATH_ACCURACY_EXACT, results);
+} // epNodePoolComputeBatch
+
+EpNodeComputeResult epNodePoolComputeBatchApprox(
+    const EpNodePool      * pool,
+    const EpBatchVariable * variables,
+    size_t                  variableCount,
+    size_t                  pointCount,
+    EpMathAccuracy          accuracy,
+    double                * results
+) {
+    return epNodePoolComputeBatchImpl(pool, variables, variableCount, pointCount, accuracy, results);
+} // epNodePoolComputeBatchApprox
+
+// ep_pool.c
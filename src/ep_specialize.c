@@ -0,0 +1,149 @@
+/**
+ * @brief partial evaluation (specialization) implementation file
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+
+#include "ep_internal.h"
+
+/// @brief specialization intermediate result representation structure
+typedef struct __EpSpecializeResult {
+    EpNode * node;  ///< residual node (NULL if subtree is folded into 'value')
+    double   value; ///< folded subtree value (valid only if node is NULL)
+} EpSpecializeResult;
+
+/**
+ * @brief folded value to node conversion function
+ * 
+ * @param[in] result specialization result
+ * 
+ * @return residual node or constant node with folded value (NULL if allocation failed)
+ */
+static EpNode * epSpecializeResultToNode( EpSpecializeResult result ) {
+    return result.node != NULL
+        ? result.node
+        : epNodeConstant(result.value);
+} // epSpecializeResultToNode
+
+/**
+ * @brief specialization implementation function
+ * 
+ * @param[in]  node         node to specialize (non-null)
+ * @param[in]  symbols      binding variable symbols (non-null if bindingCount != 0)
+ * @param[in]  bindings     variable bindings (non-null if bindingCount != 0)
+ * @param[in]  bindingCount count of bindings
+ * @param[out] dst          specialization result destination (non-null)
+ * 
+ * @return true if succeeded, false if allocation failed
+ * 
+ * @note variable-free subtrees are not materialized: they are returned in dst->value
+ * and converted to constant nodes only if they meet a residual sibling.
+ */
+static bool epNodeSpecializeImpl(
+    const EpNode       * node,
+    const EpSymbol     * symbols,
+    const EpVariable   * bindings,
+    size_t               bindingCount,
+    EpSpecializeResult * dst
+) {
+    switch (node->type) {
+    case EP_NODE_VARIABLE: {
+        for (size_t i = 0; i < bindingCount; i++)
+            if (node->variable == symbols[i]) {
+                *dst = (EpSpecializeResult) { .node = NULL, .value = bindings[i].value };
+                return true;
+            }
+
+        *dst = (EpSpecializeResult) { .node = epNodeCopy(node), .value = 0.0 };
+        return dst->node != NULL;
+    }
+
+    case EP_NODE_CONSTANT:
+        *dst = (EpSpecializeResult) { .node = NULL, .value = node->constant };
+        return true;
+
+    case EP_NODE_BINARY_OPERATOR: {
+        EpSpecializeResult lhs = {};
+        EpSpecializeResult rhs = {};
+
+        if (!epNodeSpecializeImpl(node->binaryOperator.lhs, symbols, bindings, bindingCount, &lhs))
+            return false;
+
+        if (!epNodeSpecializeImpl(node->binaryOperator.rhs, symbols, bindings, bindingCount, &rhs)) {
+            epNodeDtor(lhs.node);
+            return false;
+        }
+
+        // fold
+        if (lhs.node == NULL && rhs.node == NULL) {
+            *dst = (EpSpecializeResult) {
+                .node = NULL,
+                .value = epBinaryOperatorApply(node->binaryOperator.op, lhs.value, rhs.value),
+            };
+            return true;
+        }
+
+        // ok, because epNodeBinaryOperator gathers lhs and rhs ownership.
+        *dst = (EpSpecializeResult) {
+            .node = epNodeBinaryOperator(
+                node->binaryOperator.op,
+                epSpecializeResultToNode(lhs),
+                epSpecializeResultToNode(rhs)
+            ),
+            .value = 0.0,
+        };
+        return dst->node != NULL;
+    }
+
+    case EP_NODE_UNARY_OPERATOR: {
+        EpSpecializeResult operand = {};
+
+        if (!epNodeSpecializeImpl(node->unaryOperator.operand, symbols, bindings, bindingCount, &operand))
+            return false;
+
+        // fold
+        if (operand.node == NULL) {
+            *dst = (EpSpecializeResult) {
+                .node = NULL,
+                .value = epUnaryOperatorApply(node->unaryOperator.op, operand.value),
+            };
+            return true;
+        }
+
+        *dst = (EpSpecializeResult) {
+            .node = epNodeUnaryOperator(node->unaryOperator.op, operand.node),
+            .value = 0.0,
+        };
+        return dst->node != NULL;
+    }
+    }
+
+    return false;
+} // epNodeSpecializeImpl
+
+EpNode * epNodeSpecialize(
+    const EpNode     * node,
+    const EpVariable * bindings,
+    size_t             bindingCount
+) {
+    assert(node != NULL);
+    assert(bindingCount == 0 || (bindingCount != 0 && bindings != NULL));
+
+    EpSymbol localSymbols[EP_LOCAL_SYMBOL_COUNT];
+    EpSymbol *symbols = epSymbolsResolve(bindings, bindingCount, sizeof(EpVariable), localSymbols);
+
+    if (symbols == NULL)
+        return NULL;
+
+    EpSpecializeResult result = {};
+    bool succeeded = epNodeSpecializeImpl(node, symbols, bindings, bindingCount, &result);
+
+    epSymbolsRelease(symbols, localSymbols);
+
+    return succeeded
+        ? epSpecializeResultToNode(result)
+        : NULL;
+} // epNodeSpecialize
+
+// ep_specialize.c
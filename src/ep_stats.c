@@ -0,0 +1,351 @@
+/**
+ * @brief runtime instrumentation counters implementation file
+ */
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "ep_internal.h"
+
+#ifdef EP_STATS
+
+/// @brief per-thread counter block representation structure
+typedef struct __EpStatsBlock EpStatsBlock;
+
+struct __EpStatsBlock {
+    uint64_t          counters[EP_STATS_COUNTER_COUNT]; ///< counters (written by owner thread only, except reset)
+    uint64_t          isSameCalls;                      ///< epNodeIsSame calls
+    uint64_t          isSameNodes;                      ///< node pairs compared by epNodeIsSame
+    uint64_t          isSameMaxDepth;                   ///< maximal comparison depth of single epNodeIsSame call
+    uint64_t          ruleHits[EP_STATS_RULE_COUNT];    ///< optimizer rule group hits
+    EpStatsPhaseTimer phases[EP_STATS_PHASE_COUNT];     ///< phase timers
+
+    unsigned int      phaseDepths[EP_STATS_PHASE_COUNT]; ///< nesting depths of running phases (owner thread only)
+    uint64_t          phaseStarts[EP_STATS_PHASE_COUNT]; ///< start times of running phases (owner thread only)
+
+    EpStatsBlock    * next;                              ///< next block in active or free list
+}; // struct __EpStatsBlock
+
+/// @brief block list mutex
+static pthread_mutex_t epStatsMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/// @brief thread exit key initialization flag
+static pthread_once_t epStatsKeyOnce = PTHREAD_ONCE_INIT;
+
+/// @brief thread exit key (block is retired by its destructor)
+static pthread_key_t epStatsKey;
+
+/// @brief blocks of running threads
+static EpStatsBlock *epStatsActiveBlocks = NULL;
+
+/// @brief blocks of finished threads (reused by new threads)
+static EpStatsBlock *epStatsFreeBlocks = NULL;
+
+/// @brief counters accumulated by finished threads
+static EpStatsBlock epStatsRetired = {};
+
+/// @brief calling thread block (NULL if not acquired yet)
+static __thread EpStatsBlock *epStatsThreadBlock = NULL;
+
+/**
+ * @brief counter value adding function
+ * 
+ * @param[in,out] counter counter (non-null, owned by calling thread)
+ * @param[in]     value   value to add
+ * 
+ * @note counter has single writer, so it isn't locked, load and store are atomic only for concurrent snapshot readers
+ */
+static inline void epStatsAdd( uint64_t *counter, uint64_t value ) {
+    __atomic_store_n(counter, __atomic_load_n(counter, __ATOMIC_RELAXED) + value, __ATOMIC_RELAXED);
+} // epStatsAdd
+
+/**
+ * @brief block counters to accumulator adding function
+ * 
+ * @param[in,out] dst accumulator (non-null)
+ * @param[in]     src block to add counters of (non-null)
+ */
+static void epStatsBlockAccumulate( EpStatsBlock *dst, const EpStatsBlock *src ) {
+    for (size_t i = 0; i < EP_STATS_COUNTER_COUNT; i++)
+        dst->counters[i] += __atomic_load_n(&src->counters[i], __ATOMIC_RELAXED);
+
+    dst->isSameCalls += __atomic_load_n(&src->isSameCalls, __ATOMIC_RELAXED);
+    dst->isSameNodes += __atomic_load_n(&src->isSameNodes, __ATOMIC_RELAXED);
+
+    const uint64_t isSameMaxDepth = __atomic_load_n(&src->isSameMaxDepth, __ATOMIC_RELAXED);
+
+    if (isSameMaxDepth > dst->isSameMaxDepth)
+        dst->isSameMaxDepth = isSameMaxDepth;
+
+    for (size_t i = 0; i < EP_STATS_RULE_COUNT; i++)
+        dst->ruleHits[i] += __atomic_load_n(&src->ruleHits[i], __ATOMIC_RELAXED);
+
+    for (size_t i = 0; i < EP_STATS_PHASE_COUNT; i++) {
+        dst->phases[i].calls += __atomic_load_n(&src->phases[i].calls, __ATOMIC_RELAXED);
+        dst->phases[i].nanoseconds += __atomic_load_n(&src->phases[i].nanoseconds, __ATOMIC_RELAXED);
+    }
+} // epStatsBlockAccumulate
+
+/**
+ * @brief block counters resetting function
+ * 
+ * @param[in,out] block block to reset counters of (non-null)
+ * 
+ * @note running phase state is kept, so phases begun before reset are timed correctly
+ */
+static void epStatsBlockReset( EpStatsBlock *block ) {
+    for (size_t i = 0; i < EP_STATS_COUNTER_COUNT; i++)
+        __atomic_store_n(&block->counters[i], 0, __ATOMIC_RELAXED);
+
+    __atomic_store_n(&block->isSameCalls, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&block->isSameNodes, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&block->isSameMaxDepth, 0, __ATOMIC_RELAXED);
+
+    for (size_t i = 0; i < EP_STATS_RULE_COUNT; i++)
+        __atomic_store_n(&block->ruleHits[i], 0, __ATOMIC_RELAXED);
+
+    for (size_t i = 0; i < EP_STATS_PHASE_COUNT; i++) {
+        __atomic_store_n(&block->phases[i].calls, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&block->phases[i].nanoseconds, 0, __ATOMIC_RELAXED);
+    }
+} // epStatsBlockReset
+
+/**
+ * @brief thread exit block retiring function
+ * 
+ * @param[in] ptr exiting thread block
+ */
+static void epStatsBlockRetire( void *ptr ) {
+    EpStatsBlock *block = (EpStatsBlock *)ptr;
+
+    pthread_mutex_lock(&epStatsMutex);
+
+    epStatsBlockAccumulate(&epStatsRetired, block);
+
+    EpStatsBlock **link = &epStatsActiveBlocks;
+
+    while (*link != block)
+        link = &(*link)->next;
+    *link = block->next;
+
+    block->next = epStatsFreeBlocks;
+    epStatsFreeBlocks = block;
+
+    pthread_mutex_unlock(&epStatsMutex);
+} // epStatsBlockRetire
+
+/**
+ * @brief thread exit key creation function
+ */
+static void epStatsKeyCreate( void ) {
+    pthread_key_create(&epStatsKey, epStatsBlockRetire);
+} // epStatsKeyCreate
+
+/**
+ * @brief calling thread block getting function
+ * 
+ * @return calling thread block (NULL if allocation failed, thread isn't accounted then)
+ */
+static EpStatsBlock * epStatsGetThreadBlock( void ) {
+    if (epStatsThreadBlock != NULL)
+        return epStatsThreadBlock;
+
+    pthread_once(&epStatsKeyOnce, epStatsKeyCreate);
+    pthread_mutex_lock(&epStatsMutex);
+
+    EpStatsBlock *block = epStatsFreeBlocks;
+
+    if (block != NULL)
+        epStatsFreeBlocks = block->next;
+    else
+        block = (EpStatsBlock *)malloc(sizeof(EpStatsBlock));
+
+    if (block != NULL) {
+        memset(block, 0, sizeof(EpStatsBlock));
+        block->next = epStatsActiveBlocks;
+        epStatsActiveBlocks = block;
+    }
+
+    pthread_mutex_unlock(&epStatsMutex);
+
+    if (block != NULL)
+        pthread_setspecific(epStatsKey, block);
+
+    return epStatsThreadBlock = block;
+} // epStatsGetThreadBlock
+
+/**
+ * @brief monotonic time getting function
+ * 
+ * @return time (in nanoseconds)
+ */
+static uint64_t epStatsTime( void ) {
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (uint64_t)time.tv_sec * 1000000000ull + (uint64_t)time.tv_nsec;
+} // epStatsTime
+
+void epStatsCount( EpStatsCounter counter, uint64_t value ) {
+    EpStatsBlock *block = epStatsGetThreadBlock();
+
+    if (block != NULL)
+        epStatsAdd(&block->counters[counter], value);
+} // epStatsCount
+
+void epStatsIsSame( uint64_t nodes, uint64_t depth ) {
+    EpStatsBlock *block = epStatsGetThreadBlock();
+
+    if (block == NULL)
+        return;
+
+    epStatsAdd(&block->isSameCalls, 1);
+    epStatsAdd(&block->isSameNodes, nodes);
+    if (depth > __atomic_load_n(&block->isSameMaxDepth, __ATOMIC_RELAXED))
+        __atomic_store_n(&block->isSameMaxDepth, depth, __ATOMIC_RELAXED);
+} // epStatsIsSame
+
+void epStatsRuleHit( EpStatsRule rule ) {
+    EpStatsBlock *block = epStatsGetThreadBlock();
+
+    if (block != NULL)
+        epStatsAdd(&block->ruleHits[rule], 1);
+} // epStatsRuleHit
+
+void epStatsPhaseBegin( EpStatsPhase phase ) {
+    EpStatsBlock *block = epStatsGetThreadBlock();
+
+    if (block != NULL && block->phaseDepths[phase]++ == 0)
+        block->phaseStarts[phase] = epStatsTime();
+} // epStatsPhaseBegin
+
+void epStatsPhaseEnd( EpStatsPhase phase ) {
+    EpStatsBlock *block = epStatsGetThreadBlock();
+
+    if (block == NULL || block->phaseDepths[phase] == 0 || --block->phaseDepths[phase] != 0)
+        return;
+
+    epStatsAdd(&block->phases[phase].calls, 1);
+    epStatsAdd(&block->phases[phase].nanoseconds, epStatsTime() - block->phaseStarts[phase]);
+} // epStatsPhaseEnd
+
+EpStats epStatsSnapshot( void ) {
+    EpStatsBlock total = {};
+
+    pthread_mutex_lock(&epStatsMutex);
+
+    epStatsBlockAccumulate(&total, &epStatsRetired);
+    for (const EpStatsBlock *block = epStatsActiveBlocks; block != NULL; block = block->next)
+        epStatsBlockAccumulate(&total, block);
+
+    pthread_mutex_unlock(&epStatsMutex);
+
+    EpStats stats = {
+        .enabled         = true,
+        .nodeAllocations = total.counters[EP_STATS_COUNTER_NODE_ALLOCATIONS],
+        .nodeFrees       = total.counters[EP_STATS_COUNTER_NODE_FREES],
+        .copyCalls       = total.counters[EP_STATS_COUNTER_COPY_CALLS],
+        .copiedNodes     = total.counters[EP_STATS_COUNTER_COPIED_NODES],
+        .isSameCalls     = total.isSameCalls,
+        .isSameNodes     = total.isSameNodes,
+        .isSameMaxDepth  = total.isSameMaxDepth,
+        .ruleHits        = {},
+        .phases          = {},
+    };
+
+    memcpy(stats.ruleHits, total.ruleHits, sizeof(stats.ruleHits));
+    memcpy(stats.phases, total.phases, sizeof(stats.phases));
+    return stats;
+} // epStatsSnapshot
+
+void epStatsReset( void ) {
+    pthread_mutex_lock(&epStatsMutex);
+
+    epStatsBlockReset(&epStatsRetired);
+    for (EpStatsBlock *block = epStatsActiveBlocks; block != NULL; block = block->next)
+        epStatsBlockReset(block);
+
+    pthread_mutex_unlock(&epStatsMutex);
+} // epStatsReset
+
+#else
+
+EpStats epStatsSnapshot( void ) {
+    EpStats stats = {};
+
+    stats.enabled = false;
+    return stats;
+} // epStatsSnapshot
+
+void epStatsReset( void ) {
+} // epStatsReset
+
+#endif // defined(EP_STATS)
+
+const char * epStatsPhaseStr( EpStatsPhase phase ) {
+    switch (phase) {
+    case EP_STATS_PHASE_PARSE      : return "parse";
+    case EP_STATS_PHASE_OPTIMIZE   : return "optimize";
+    case EP_STATS_PHASE_DERIVATIVE : return "derivative";
+    case EP_STATS_PHASE_TAYLOR     : return "taylor";
+    case EP_STATS_PHASE_SUBSTITUTE : return "substitute";
+    case EP_STATS_PHASE_COMPUTE    : return "compute";
+    case EP_STATS_PHASE_DUMP       : return "dump";
+    case EP_STATS_PHASE_INFO       : return "info";
+    case EP_STATS_PHASE_COUNT      : break;
+    }
+    return "unknown";
+} // epStatsPhaseStr
+
+const char * epStatsRuleStr( EpStatsRule rule ) {
+    switch (rule) {
+    case EP_STATS_RULE_CONSTANT_FOLD     : return "constant folding";
+    case EP_STATS_RULE_NEUTRAL_ELEMENT   : return "neutral element";
+    case EP_STATS_RULE_ABSORBING_ELEMENT : return "absorbing element";
+    case EP_STATS_RULE_SAME_OPERANDS     : return "same operands";
+    case EP_STATS_RULE_SIGN              : return "sign";
+    case EP_STATS_RULE_POWER             : return "power";
+    case EP_STATS_RULE_COUNT             : break;
+    }
+    return "unknown";
+} // epStatsRuleStr
+
+void epStatsDump( FILE *out, const EpStats *stats ) {
+    assert(out != NULL);
+    assert(stats != NULL);
+
+    if (!stats->enabled) {
+        fprintf(out, "stats: instrumentation is disabled at build time (EP_STATS)\n");
+        return;
+    }
+
+    fprintf(out, "stats:\n");
+    fprintf(out, "  node allocations   : %llu\n", (unsigned long long)stats->nodeAllocations);
+    fprintf(out, "  node frees         : %llu\n", (unsigned long long)stats->nodeFrees);
+    fprintf(out, "  epNodeCopy         : %llu calls, %llu nodes\n",
+        (unsigned long long)stats->copyCalls,
+        (unsigned long long)stats->copiedNodes
+    );
+    fprintf(out, "  epNodeIsSame       : %llu calls, %llu node pairs, depth at most %llu\n",
+        (unsigned long long)stats->isSameCalls,
+        (unsigned long long)stats->isSameNodes,
+        (unsigned long long)stats->isSameMaxDepth
+    );
+
+    fprintf(out, "  optimizer rule hits:\n");
+    for (int rule = 0; rule < EP_STATS_RULE_COUNT; rule++)
+        fprintf(out, "    %-18s : %llu\n", epStatsRuleStr((EpStatsRule)rule), (unsigned long long)stats->ruleHits[rule]);
+
+    fprintf(out, "  phases:\n");
+    for (int phase = 0; phase < EP_STATS_PHASE_COUNT; phase++)
+        fprintf(out, "    %-18s : %llu calls, %.3f ms\n",
+            epStatsPhaseStr((EpStatsPhase)phase),
+            (unsigned long long)stats->phases[phase].calls,
+            (double)stats->phases[phase].nanoseconds * 1e-6
+        );
+} // epStatsDump
+
+// ep_stats.c
@@ -0,0 +1,268 @@
+/**
+ * @brief multi-expression file (stream) parsing implementation file
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "ep_internal.h"
+
+/// @brief minimal size of chunk parsed by single task
+#define EP_PARSE_STREAM_MIN_CHUNK_SIZE ((size_t)1 << 16)
+
+/// @brief count of chunks per worker (for load balancing)
+#define EP_PARSE_STREAM_CHUNKS_PER_WORKER 4
+
+/// @brief single chunk parsing state representation structure
+typedef struct __EpParseStreamChunk {
+    const char         * begin;         ///< chunk begin (line begin)
+    const char         * end;           ///< chunk end (exclusive, line begin or text end)
+
+    EpParseStreamEntry * entries;       ///< parsed lines (line numbers are relative to chunk)
+    size_t               entryCount;    ///< count of parsed lines
+    size_t               entryCapacity; ///< entry array capacity
+    size_t               lineCount;     ///< count of lines in chunk
+    bool                 failed;        ///< true if allocation failed during chunk parsing
+} EpParseStreamChunk;
+
+/**
+ * @brief whitespace-only line checking function
+ * 
+ * @param[in] begin line begin
+ * @param[in] end   line end (exclusive)
+ * 
+ * @return true if line contains only whitespace characters, false if not
+ */
+static bool epParseStreamLineIsBlank( const char *begin, const char *end ) {
+    for (const char *ptr = begin; ptr < end; ptr++)
+        switch (*ptr) {
+        case ' ' : case '\t': case '\r': case '\v': case '\f':
+            break;
+
+        default:
+            return false;
+        }
+    return true;
+} // epParseStreamLineIsBlank
+
+/**
+ * @brief chunk entry pushing function
+ * 
+ * @param[in] chunk chunk (non-null)
+ * @param[in] entry entry to push
+ * 
+ * @return true if pushed, false if allocation failed
+ */
+static bool epParseStreamChunkPush( EpParseStreamChunk *chunk, EpParseStreamEntry entry ) {
+    if (chunk->entryCount >= chunk->entryCapacity) {
+        size_t newCapacity = chunk->entryCapacity == 0 ? 64 : chunk->entryCapacity * 2;
+        EpParseStreamEntry *newEntries = (EpParseStreamEntry *)realloc(chunk->entries, newCapacity * sizeof(EpParseStreamEntry));
+
+        if (newEntries == NULL)
+            return false;
+
+        chunk->entries = newEntries;
+        chunk->entryCapacity = newCapacity;
+    }
+
+    chunk->entries[chunk->entryCount++] = entry;
+    return true;
+} // epParseStreamChunkPush
+
+/**
+ * @brief chunk parsing task
+ * 
+ * @param[in] context chunk array
+ * @param[in] index   index of chunk to parse
+ */
+static void epParseStreamChunkTask( void *context, size_t index ) {
+    EpParseStreamChunk *chunk = (EpParseStreamChunk *)context + index;
+    const char *line = chunk->begin;
+
+    while (line < chunk->end) {
+        const char *lineEnd = (const char *)memchr(line, '\n', chunk->end - line);
+
+        if (lineEnd == NULL)
+            lineEnd = chunk->end;
+
+        chunk->lineCount++;
+
+        if (!epParseStreamLineIsBlank(line, lineEnd)) {
+            EpParseStreamEntry entry = {
+                .line = chunk->lineCount,
+                .result = epParseExpressionSlice(line, lineEnd),
+            };
+
+            if (!epParseStreamChunkPush(chunk, entry)) {
+                if (entry.result.status == EP_PARSE_EXPRESSION_OK)
+                    epNodeDtor(entry.result.ok.result);
+                chunk->failed = true;
+                return;
+            }
+        }
+
+        line = lineEnd + 1;
+    }
+} // epParseStreamChunkTask
+
+/**
+ * @brief chunk entries destructor
+ * 
+ * @param[in] chunk chunk to destroy entries of (non-null)
+ */
+static void epParseStreamChunkDtor( EpParseStreamChunk *chunk ) {
+    for (size_t i = 0; i < chunk->entryCount; i++)
+        if (chunk->entries[i].result.status == EP_PARSE_EXPRESSION_OK)
+            epNodeDtor(chunk->entries[i].result.ok.result);
+    free(chunk->entries);
+} // epParseStreamChunkDtor
+
+/**
+ * @brief text parsing function
+ * 
+ * @param[in]  text        text to parse
+ * @param[in]  textSize    text size
+ * @param[in]  workerCount count of workers
+ * @param[out] dst         result destination (non-null, entries and entryCount fields are filled)
+ * 
+ * @return true if succeeded, false if allocation failed
+ */
+static bool epParseStreamText( const char *text, size_t textSize, unsigned int workerCount, EpParseStreamResult *dst ) {
+    size_t chunkCount = (size_t)workerCount * EP_PARSE_STREAM_CHUNKS_PER_WORKER;
+
+    if (chunkCount > textSize / EP_PARSE_STREAM_MIN_CHUNK_SIZE + 1)
+        chunkCount = textSize / EP_PARSE_STREAM_MIN_CHUNK_SIZE + 1;
+
+    EpParseStreamChunk *chunks = (EpParseStreamChunk *)calloc(chunkCount, sizeof(EpParseStreamChunk));
+
+    if (chunks == NULL)
+        return false;
+
+    // split text to chunks at line boundaries
+    const char *textEnd = text + textSize;
+    const char *chunkBegin = text;
+
+    for (size_t i = 0; i < chunkCount; i++) {
+        const char *chunkEnd = text + textSize / chunkCount * (i + 1);
+
+        if (i + 1 == chunkCount || chunkEnd <= chunkBegin) {
+            chunkEnd = i + 1 == chunkCount ? textEnd : chunkBegin;
+        } else {
+            const char *newline = (const char *)memchr(chunkEnd, '\n', textEnd - chunkEnd);
+            chunkEnd = newline == NULL ? textEnd : newline + 1;
+        }
+
+        chunks[i].begin = chunkBegin;
+        chunks[i].end = chunkEnd;
+        chunkBegin = chunkEnd;
+    }
+
+    epParallelFor(chunkCount, workerCount, epParseStreamChunkTask, chunks);
+
+    // gather results in input order
+    size_t entryCount = 0;
+    bool failed = false;
+
+    for (size_t i = 0; i < chunkCount; i++) {
+        entryCount += chunks[i].entryCount;
+        failed |= chunks[i].failed;
+    }
+
+    EpParseStreamEntry *entries = failed || entryCount == 0
+        ? NULL
+        : (EpParseStreamEntry *)calloc(entryCount, sizeof(EpParseStreamEntry));
+
+    if (failed || (entryCount != 0 && entries == NULL)) {
+        for (size_t i = 0; i < chunkCount; i++)
+            epParseStreamChunkDtor(&chunks[i]);
+        free(chunks);
+        return false;
+    }
+
+    size_t lineOffset = 0;
+    size_t entryOffset = 0;
+
+    for (size_t i = 0; i < chunkCount; i++) {
+        for (size_t j = 0; j < chunks[i].entryCount; j++) {
+            entries[entryOffset] = chunks[i].entries[j];
+            entries[entryOffset].line += lineOffset;
+            entryOffset++;
+        }
+
+        lineOffset += chunks[i].lineCount;
+        free(chunks[i].entries);
+    }
+    free(chunks);
+
+    dst->entries = entries;
+    dst->entryCount = entryCount;
+    return true;
+} // epParseStreamText
+
+EpParseStreamResult epParseStream( const char *path, unsigned int threadCount ) {
+    assert(path != NULL);
+
+    EpParseStreamResult result = {
+        .status = EP_PARSE_STREAM_OPEN_FAILED,
+        .entries = NULL,
+        .entryCount = 0,
+        .text = NULL,
+        .textSize = 0,
+    };
+
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0)
+        return result;
+
+    struct stat fileStat;
+
+    if (fstat(fd, &fileStat) != 0) {
+        close(fd);
+        return result;
+    }
+
+    if (fileStat.st_size != 0) {
+        void *text = mmap(NULL, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (text == MAP_FAILED) {
+            close(fd);
+            return result;
+        }
+
+        madvise(text, (size_t)fileStat.st_size, MADV_SEQUENTIAL);
+        result.text = (const char *)text;
+        result.textSize = (size_t)fileStat.st_size;
+    }
+
+    // mapping stays valid after descriptor closing
+    close(fd);
+
+    result.status = epParseStreamText(result.text, result.textSize, epParallelGetWorkerCount(threadCount), &result)
+        ? EP_PARSE_STREAM_OK
+        : EP_PARSE_STREAM_INTERNAL_ERROR;
+
+    return result;
+} // epParseStream
+
+void epParseStreamResultDtor( EpParseStreamResult *result ) {
+    if (result == NULL)
+        return;
+
+    for (size_t i = 0; i < result->entryCount; i++)
+        if (result->entries[i].result.status == EP_PARSE_EXPRESSION_OK)
+            epNodeDtor(result->entries[i].result.ok.result);
+    free(result->entries);
+
+    if (result->text != NULL)
+        munmap((void *)result->text, result->textSize);
+
+    *result = (EpParseStreamResult) {};
+} // epParseStreamResultDtor
+
+// ep_stream.c
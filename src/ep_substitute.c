@@ -2,23 +2,30 @@
  * @brief substitution function
  */
 
-#include <string.h>
+#include <stdlib.h>
 
-#include "ep.h"
+#include "ep_internal.h"
 
-EpNode * epNodeSubstitute(
+/**
+ * @brief substitution by resolved variable symbols function
+ * 
+ * @param[in] node              node to substitute variables in (non-null)
+ * @param[in] symbols           substituted variable symbols (non-null)
+ * @param[in] substitutions     substitutions (non-null)
+ * @param[in] substitutionCount count of substitutions
+ * 
+ * @return node with substituted variables (null if allocation failed)
+ */
+static EpNode * epNodeSubstituteSymbols(
     const EpNode         * node,
+    const EpSymbol       * symbols,
     const EpSubstitution * substitutions,
     size_t                 substitutionCount
 ) {
-    // yeah
-    if (substitutionCount == 0)
-        return epNodeCopy(node);
-
     switch (node->type) {
     case EP_NODE_VARIABLE:
         for (size_t i = 0; i < substitutionCount; i++)
-            if (strcmp(node->variable, substitutions[i].name) == 0)
+            if (node->variable == symbols[i])
                 return epNodeCopy(substitutions[i].node);
         return epNodeCopy(node);
 
@@ -28,16 +35,122 @@ EpNode * epNodeSubstitute(
     case EP_NODE_BINARY_OPERATOR:
         return epNodeBinaryOperator(
             node->binaryOperator.op,
-            epNodeSubstitute(node->binaryOperator.lhs, substitutions, substitutionCount),
-            epNodeSubstitute(node->binaryOperator.rhs, substitutions, substitutionCount)
+            epNodeSubstituteSymbols(node->binaryOperator.lhs, symbols, substitutions, substitutionCount),
+            epNodeSubstituteSymbols(node->binaryOperator.rhs, symbols, substitutions, substitutionCount)
         );
 
     case EP_NODE_UNARY_OPERATOR:
         return epNodeUnaryOperator(
             node->unaryOperator.op,
-            epNodeSubstitute(node->unaryOperator.operand, substitutions, substitutionCount)
+            epNodeSubstituteSymbols(node->unaryOperator.operand, symbols, substitutions, substitutionCount)
         );
     }
+} // epNodeSubstituteSymbols
+
+/**
+ * @brief consuming substitution by resolved variable symbols function
+ * 
+ * @param[in,out] nodePtr           pointer to node to substitute variables in (non-null, points to non-null)
+ * @param[in]     symbols           substituted variable symbols (non-null)
+ * @param[in]     substitutions     substitutions (non-null)
+ * @param[in]     substitutionCount count of substitutions
+ * 
+ * @return true if succeeded, false if allocation failed (tree under nodePtr stays valid in this case)
+ */
+static bool epNodeSubstituteInPlaceSymbols(
+    EpNode              ** nodePtr,
+    const EpSymbol       * symbols,
+    const EpSubstitution * substitutions,
+    size_t                 substitutionCount
+) {
+    EpNode *node = *nodePtr;
+
+    switch (node->type) {
+    case EP_NODE_VARIABLE:
+        for (size_t i = 0; i < substitutionCount; i++)
+            if (node->variable == symbols[i]) {
+                EpNode *substituted = epNodeCopy(substitutions[i].node);
+
+                if (substituted == NULL)
+                    return false;
+
+                epNodeDtor(node);
+                *nodePtr = substituted;
+                return true;
+            }
+        return true;
+
+    case EP_NODE_CONSTANT:
+        return true;
+
+    case EP_NODE_BINARY_OPERATOR: {
+        // hash is updated even if substitution failed, because one of operands may be already replaced
+        bool succeeded = true
+            && epNodeSubstituteInPlaceSymbols(&node->binaryOperator.lhs, symbols, substitutions, substitutionCount)
+            && epNodeSubstituteInPlaceSymbols(&node->binaryOperator.rhs, symbols, substitutions, substitutionCount)
+        ;
+        epNodeUpdateHash(node);
+        return succeeded;
+    }
+
+    case EP_NODE_UNARY_OPERATOR: {
+        bool succeeded = epNodeSubstituteInPlaceSymbols(&node->unaryOperator.operand, symbols, substitutions, substitutionCount);
+        epNodeUpdateHash(node);
+        return succeeded;
+    }
+    }
+
+    return false;
+} // epNodeSubstituteInPlaceSymbols
+
+EpNode * epNodeSubstitute(
+    const EpNode         * node,
+    const EpSubstitution * substitutions,
+    size_t                 substitutionCount
+) {
+    // yeah
+    if (substitutionCount == 0)
+        return epNodeCopy(node);
+
+    EpSymbol localSymbols[EP_LOCAL_SYMBOL_COUNT];
+    EpSymbol *symbols = epSymbolsResolve(substitutions, substitutionCount, sizeof(EpSubstitution), localSymbols);
+
+    if (symbols == NULL)
+        return NULL;
+
+    EP_STATS_PHASE_BEGIN(EP_STATS_PHASE_SUBSTITUTE);
+    EpNode *result = epNodeSubstituteSymbols(node, symbols, substitutions, substitutionCount);
+    EP_STATS_PHASE_END(EP_STATS_PHASE_SUBSTITUTE);
+
+    epSymbolsRelease(symbols, localSymbols);
+    return result;
 } // epNodeSubstitute
 
+EpNode * epNodeSubstituteInPlace(
+    EpNode               * node,
+    const EpSubstitution * substitutions,
+    size_t                 substitutionCount
+) {
+    if (node == NULL || substitutionCount == 0)
+        return node;
+
+    EpSymbol localSymbols[EP_LOCAL_SYMBOL_COUNT];
+    EpSymbol *symbols = epSymbolsResolve(substitutions, substitutionCount, sizeof(EpSubstitution), localSymbols);
+
+    if (symbols == NULL) {
+        epNodeDtor(node);
+        return NULL;
+    }
+
+    EP_STATS_PHASE_BEGIN(EP_STATS_PHASE_SUBSTITUTE);
+    if (!epNodeSubstituteInPlaceSymbols(&node, symbols, substitutions, substitutionCount)) {
+        epNodeDtor(node);
+        node = NULL;
+    }
+    EP_STATS_PHASE_END(EP_STATS_PHASE_SUBSTITUTE);
+
+    epSymbolsRelease(symbols, localSymbols);
+    return node;
+} // epNodeSubstituteInPlace
+
 // ep_substitute.c
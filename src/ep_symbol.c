@@ -0,0 +1,237 @@
+/**
+ * @brief global symbol (variable name) table implementation file
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "ep.h"
+
+/// @brief count of symbols in single name block (power of 2)
+#define EP_SYMBOL_BLOCK_SIZE ((size_t)1024)
+
+/// @brief maximal count of name blocks
+#define EP_SYMBOL_BLOCK_MAX ((size_t)4096)
+
+/// @brief symbol hash table slot representation structure
+typedef struct __EpSymbolSlot {
+    uint32_t hash;   ///< symbol name hash
+    EpSymbol symbol; ///< symbol (EP_SYMBOL_INVALID if slot is empty)
+} EpSymbolSlot;
+
+/// @brief symbol table representation structure
+typedef struct __EpSymbolTable {
+    pthread_rwlock_t   lock;                       ///< table lock (names are read without it)
+
+    const char      ** blocks[EP_SYMBOL_BLOCK_MAX]; ///< name blocks (blocks are never moved, so names are read without lock)
+    size_t             symbolCount;                ///< count of symbols
+
+    EpSymbolSlot     * slots;                      ///< hash table slots (open addressing)
+    size_t             slotCount;                  ///< count of slots (power of 2)
+} EpSymbolTable;
+
+/// @brief global symbol table
+static EpSymbolTable epSymbolTable = {
+    .lock        = PTHREAD_RWLOCK_INITIALIZER,
+    .blocks      = {},
+    .symbolCount = 0,
+    .slots       = NULL,
+    .slotCount   = 0,
+};
+
+/**
+ * @brief symbol name hashing function (FNV-1a)
+ * 
+ * @param[in] name   name (non-null if length != 0)
+ * @param[in] length name length
+ * 
+ * @return name hash
+ */
+static uint32_t epSymbolHash( const char *name, size_t length ) {
+    uint32_t hash = 0x811C9DC5u;
+
+    for (size_t i = 0; i < length; i++)
+        hash = (hash ^ (uint8_t)name[i]) * 0x01000193u;
+    return hash;
+} // epSymbolHash
+
+/**
+ * @brief symbol name getting function (table must be locked or symbol must be published)
+ * 
+ * @param[in] symbol symbol
+ * 
+ * @return symbol name
+ */
+static const char * epSymbolTableName( EpSymbol symbol ) {
+    return epSymbolTable.blocks[symbol / EP_SYMBOL_BLOCK_SIZE][symbol % EP_SYMBOL_BLOCK_SIZE];
+} // epSymbolTableName
+
+/**
+ * @brief symbol lookup function (table must be locked)
+ * 
+ * @param[in] name   name
+ * @param[in] length name length
+ * @param[in] hash   name hash
+ * 
+ * @return slot that contains symbol or empty slot to insert symbol to (NULL if table has no slots)
+ */
+static EpSymbolSlot * epSymbolTableLookup( const char *name, size_t length, uint32_t hash ) {
+    if (epSymbolTable.slotCount == 0)
+        return NULL;
+
+    const size_t mask = epSymbolTable.slotCount - 1;
+
+    for (size_t i = hash & mask; ; i = (i + 1) & mask) {
+        EpSymbolSlot *slot = &epSymbolTable.slots[i];
+
+        if (slot->symbol == EP_SYMBOL_INVALID)
+            return slot;
+
+        if (slot->hash == hash) {
+            const char *slotName = epSymbolTableName(slot->symbol);
+
+            if (strncmp(slotName, name, length) == 0 && slotName[length] == '\0')
+                return slot;
+        }
+    }
+} // epSymbolTableLookup
+
+/**
+ * @brief hash table growing function (table must be write-locked)
+ * 
+ * @return true if table has space for one more symbol, false if allocation failed
+ */
+static bool epSymbolTableGrow( void ) {
+    if ((epSymbolTable.symbolCount + 1) * 2 <= epSymbolTable.slotCount)
+        return true;
+
+    size_t newSlotCount = epSymbolTable.slotCount == 0 ? 256 : epSymbolTable.slotCount * 2;
+    EpSymbolSlot *newSlots = (EpSymbolSlot *)malloc(newSlotCount * sizeof(EpSymbolSlot));
+
+    if (newSlots == NULL)
+        return false;
+
+    for (size_t i = 0; i < newSlotCount; i++)
+        newSlots[i] = (EpSymbolSlot) { .hash = 0, .symbol = EP_SYMBOL_INVALID };
+
+    for (size_t i = 0; i < epSymbolTable.slotCount; i++) {
+        EpSymbolSlot slot = epSymbolTable.slots[i];
+
+        if (slot.symbol == EP_SYMBOL_INVALID)
+            continue;
+
+        size_t position = slot.hash & (newSlotCount - 1);
+
+        while (newSlots[position].symbol != EP_SYMBOL_INVALID)
+            position = (position + 1) & (newSlotCount - 1);
+        newSlots[position] = slot;
+    }
+
+    free(epSymbolTable.slots);
+    epSymbolTable.slots = newSlots;
+    epSymbolTable.slotCount = newSlotCount;
+    return true;
+} // epSymbolTableGrow
+
+/**
+ * @brief symbol insertion function (table must be write-locked, symbol must be absent)
+ * 
+ * @param[in] name   name
+ * @param[in] length name length
+ * @param[in] hash   name hash
+ * 
+ * @return inserted symbol (EP_SYMBOL_INVALID if allocation failed)
+ */
+static EpSymbol epSymbolTableInsert( const char *name, size_t length, uint32_t hash ) {
+    const size_t symbol = epSymbolTable.symbolCount;
+    const size_t blockIndex = symbol / EP_SYMBOL_BLOCK_SIZE;
+
+    if (blockIndex >= EP_SYMBOL_BLOCK_MAX || !epSymbolTableGrow())
+        return EP_SYMBOL_INVALID;
+
+    if (epSymbolTable.blocks[blockIndex] == NULL) {
+        epSymbolTable.blocks[blockIndex] = (const char **)calloc(EP_SYMBOL_BLOCK_SIZE, sizeof(const char *));
+
+        if (epSymbolTable.blocks[blockIndex] == NULL)
+            return EP_SYMBOL_INVALID;
+    }
+
+    char *nameCopy = (char *)malloc(length + 1);
+
+    if (nameCopy == NULL)
+        return EP_SYMBOL_INVALID;
+
+    if (length != 0)
+        memcpy(nameCopy, name, length);
+    nameCopy[length] = '\0';
+
+    epSymbolTable.blocks[blockIndex][symbol % EP_SYMBOL_BLOCK_SIZE] = nameCopy;
+    epSymbolTable.symbolCount++;
+
+    *epSymbolTableLookup(name, length, hash) = (EpSymbolSlot) {
+        .hash = hash,
+        .symbol = (EpSymbol)symbol,
+    };
+
+    return (EpSymbol)symbol;
+} // epSymbolTableInsert
+
+EpSymbol epSymbolInternSlice( const char *name, size_t length ) {
+    assert(name != NULL || length == 0);
+
+    const uint32_t hash = epSymbolHash(name, length);
+    EpSymbol symbol = EP_SYMBOL_INVALID;
+
+    // fast path, most of names are already interned
+    pthread_rwlock_rdlock(&epSymbolTable.lock);
+    EpSymbolSlot *slot = epSymbolTableLookup(name, length, hash);
+    if (slot != NULL)
+        symbol = slot->symbol;
+    pthread_rwlock_unlock(&epSymbolTable.lock);
+
+    if (symbol != EP_SYMBOL_INVALID)
+        return symbol;
+
+    // slow path, lookup is repeated because symbol may be inserted between locks
+    pthread_rwlock_wrlock(&epSymbolTable.lock);
+    slot = epSymbolTableLookup(name, length, hash);
+
+    symbol = slot != NULL && slot->symbol != EP_SYMBOL_INVALID
+        ? slot->symbol
+        : epSymbolTableInsert(name, length, hash);
+    pthread_rwlock_unlock(&epSymbolTable.lock);
+
+    return symbol;
+} // epSymbolInternSlice
+
+EpSymbol epSymbolIntern( const char *name ) {
+    assert(name != NULL);
+
+    return epSymbolInternSlice(name, strlen(name));
+} // epSymbolIntern
+
+EpSymbol epSymbolFind( const char *name ) {
+    assert(name != NULL);
+
+    const size_t length = strlen(name);
+    const uint32_t hash = epSymbolHash(name, length);
+    EpSymbol symbol = EP_SYMBOL_INVALID;
+
+    pthread_rwlock_rdlock(&epSymbolTable.lock);
+    EpSymbolSlot *slot = epSymbolTableLookup(name, length, hash);
+    if (slot != NULL)
+        symbol = slot->symbol;
+    pthread_rwlock_unlock(&epSymbolTable.lock);
+
+    return symbol;
+} // epSymbolFind
+
+const char * epSymbolName( EpSymbol symbol ) {
+    assert(symbol != EP_SYMBOL_INVALID);
+
+    return epSymbolTableName(symbol);
+} // epSymbolName
+
+// ep_symbol.c
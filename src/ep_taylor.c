@@ -3,7 +3,7 @@
  */
 
 #define _EP_NODE_SHORT_OPERATORS
-#include "ep.h"
+#include "ep_internal.h"
 
 /**
  * @brief factorial calculation function
@@ -20,26 +20,53 @@ static unsigned long long epFactorial( unsigned long long number ) {
     return result;
 } // epFactorial
 
-EpNode * epNodeTaylor(
-    const EpNode * node,
-    const char   * var,
-    const EpNode * point,
-    unsigned int   count
+EpNode * epNodeTaylorCached(
+    EpTransformCache * cache,
+    const EpNode     * node,
+    const char       * var,
+    const EpNode     * point,
+    unsigned int       count
 ) {
     EpSubstitution varSubstitution = {
         .name = var,
         .node = point
     };
 
+    EP_STATS_PHASE_BEGIN(EP_STATS_PHASE_TAYLOR);
+    epTraceBegin("taylor", "count", count, node);
+
     EpNode *lhs = epNodeSubstitute(node, &varSubstitution, 1);
-    EpNode *derivative = epNodeCopy(node);
+    const EpNode *current = node;
+    EpNode *derivative = NULL;
+
+    for (unsigned int i = 0; i < count && lhs != NULL; i++) {
+        epTraceBegin("taylor order", "order", i + 1, NULL);
+        epTraceBegin("derivative order", "order", i + 1, NULL);
 
-    for (unsigned int i = 0; i < count; i++) {
         // calculate next derivative
-        derivative = epNodeDerivative(derivative, var);
-        EpNode *optDerivative = epNodeOptimize(derivative);
+        EpNode *nextDerivative = NULL;
+
+        if (cache == NULL) {
+            nextDerivative = epNodeOptimizeInPlace(epNodeDerivative(current, var));
+        } else {
+            EpNode *rawDerivative = epNodeDerivativeCached(cache, current, var);
+
+            if (rawDerivative != NULL)
+                nextDerivative = epNodeOptimizeCached(cache, rawDerivative);
+            epNodeDtor(rawDerivative);
+        }
+        epTraceEnd("derivative order", nextDerivative);
+
         epNodeDtor(derivative);
-        derivative = optDerivative;
+        derivative = nextDerivative;
+        current = derivative;
+
+        if (derivative == NULL) {
+            epNodeDtor(lhs);
+            lhs = NULL;
+            epTraceEnd("taylor order", NULL);
+            break;
+        }
 
         // add next taylor series participant
         lhs = EP_ADD(
@@ -58,9 +85,24 @@ EpNode * epNodeTaylor(
                 )
             )
         );
+
+        epTraceEnd("taylor order", lhs);
     }
 
+    epNodeDtor(derivative);
+
+    epTraceEnd("taylor", lhs);
+    EP_STATS_PHASE_END(EP_STATS_PHASE_TAYLOR);
     return lhs;
+} // epNodeTaylorCached
+
+EpNode * epNodeTaylor(
+    const EpNode * node,
+    const char   * var,
+    const EpNode * point,
+    unsigned int   count
+) {
+    return epNodeTaylorCached(NULL, node, var, point, count);
 } // epNodeTaylor
 
 // ep_taylor.c
@@ -0,0 +1,332 @@
+/**
+ * @brief Chrome trace event recording implementation file
+ */
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "ep_internal.h"
+
+/// @brief trace event representation structure
+typedef struct __EpTraceEvent {
+    const char * name;     ///< span name
+    const char * argName;  ///< additional argument name (NULL if there's no argument)
+    uint64_t     argValue; ///< additional argument value
+    uint64_t     nodes;    ///< node count argument
+    uint64_t     time;     ///< event time (in nanoseconds)
+    char         phase;    ///< 'B' for span beginning, 'E' for span ending
+    bool         hasNodes; ///< true if event has node count argument
+} EpTraceEvent;
+
+/// @brief per-thread trace event ring buffer representation structure
+typedef struct __EpTraceBuffer EpTraceBuffer;
+
+struct __EpTraceBuffer {
+    EpTraceEvent  * events;   ///< event ring (written by owner thread only)
+    size_t          capacity; ///< event ring capacity
+    uint64_t        head;     ///< count of events ever written (published by release store)
+    unsigned int    threadId; ///< trace thread identifier
+    EpTraceBuffer * next;     ///< next buffer in recording buffer list
+}; // struct __EpTraceBuffer
+
+/// @brief buffer list and recording state mutex
+static pthread_mutex_t epTraceMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/// @brief recording flag (atomic)
+static bool epTraceRecording = false;
+
+/// @brief recording generation (atomic, buffers of previous generations are freed)
+static uint64_t epTraceGeneration = 0;
+
+/// @brief recording start time (in nanoseconds)
+static uint64_t epTraceStartTime = 0;
+
+/// @brief event capacity of buffers of current recording
+static size_t epTraceEventCapacity = 0;
+
+/// @brief count of threads registered in current recording
+static unsigned int epTraceThreadCount = 0;
+
+/// @brief buffers of current recording
+static EpTraceBuffer *epTraceBuffers = NULL;
+
+/// @brief calling thread buffer (valid only if epTraceThreadGeneration is current)
+static __thread EpTraceBuffer *epTraceThreadBuffer = NULL;
+
+/// @brief generation calling thread buffer belongs to
+static __thread uint64_t epTraceThreadGeneration = 0;
+
+/**
+ * @brief monotonic time getting function
+ * 
+ * @return time (in nanoseconds)
+ */
+static uint64_t epTraceTime( void ) {
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (uint64_t)time.tv_sec * 1000000000ull + (uint64_t)time.tv_nsec;
+} // epTraceTime
+
+/**
+ * @brief calling thread buffer getting function
+ * 
+ * @return calling thread buffer (NULL if recording is stopped or allocation failed)
+ */
+static EpTraceBuffer * epTraceGetThreadBuffer( void ) {
+    const uint64_t generation = __atomic_load_n(&epTraceGeneration, __ATOMIC_ACQUIRE);
+
+    if (epTraceThreadBuffer != NULL && epTraceThreadGeneration == generation)
+        return epTraceThreadBuffer;
+
+    EpTraceBuffer *buffer = NULL;
+
+    pthread_mutex_lock(&epTraceMutex);
+
+    if (epTraceRecording) {
+        // events are allocated with buffer header
+        buffer = (EpTraceBuffer *)malloc(sizeof(EpTraceBuffer) + epTraceEventCapacity * sizeof(EpTraceEvent));
+
+        if (buffer != NULL) {
+            buffer->events = (EpTraceEvent *)(buffer + 1);
+            buffer->capacity = epTraceEventCapacity;
+            buffer->head = 0;
+            buffer->threadId = ++epTraceThreadCount;
+            buffer->next = epTraceBuffers;
+            epTraceBuffers = buffer;
+        }
+    }
+
+    // generation is read again, as recording could be restarted before lock is taken
+    epTraceThreadGeneration = __atomic_load_n(&epTraceGeneration, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&epTraceMutex);
+
+    return epTraceThreadBuffer = buffer;
+} // epTraceGetThreadBuffer
+
+/**
+ * @brief tree node counting function
+ * 
+ * @param[in]  node  tree root (non-null)
+ * @param[out] count node count destination (non-null)
+ * 
+ * @return true if counted, false if allocation failed
+ */
+static bool epTraceNodeCount( const EpNode *node, uint64_t *count ) {
+    const EpNode *localStack[EP_LOCAL_STACK_SIZE];
+    const EpNode **stack = localStack;
+    size_t stackSize = 0;
+    size_t stackCapacity = EP_LOCAL_STACK_SIZE;
+    bool counted = true;
+
+    *count = 0;
+    stack[stackSize++] = node;
+
+    while (stackSize != 0) {
+        const EpNode *current = stack[--stackSize];
+
+        (*count)++;
+
+        if (!epStackReserve((void **)&stack, &stackCapacity, stackSize + 2, sizeof(const EpNode *), localStack)) {
+            counted = false;
+            break;
+        }
+
+        switch (current->type) {
+        case EP_NODE_VARIABLE:
+        case EP_NODE_CONSTANT:
+            break;
+
+        case EP_NODE_BINARY_OPERATOR:
+            stack[stackSize++] = current->binaryOperator.lhs;
+            stack[stackSize++] = current->binaryOperator.rhs;
+            break;
+
+        case EP_NODE_UNARY_OPERATOR:
+            stack[stackSize++] = current->unaryOperator.operand;
+            break;
+        }
+    }
+
+    if (stack != localStack)
+        free(stack);
+    return counted;
+} // epTraceNodeCount
+
+/**
+ * @brief trace event recording function
+ * 
+ * @param[in] event event to record (time is set by function)
+ * @param[in] node  node to count nodes of (nullable)
+ */
+static void epTraceRecord( EpTraceEvent event, const EpNode *node ) {
+    EpTraceBuffer *buffer = epTraceGetThreadBuffer();
+
+    if (buffer == NULL)
+        return;
+
+    // node counting time is excluded from span
+    if (event.phase == 'E')
+        event.time = epTraceTime();
+
+    event.hasNodes = node != NULL && epTraceNodeCount(node, &event.nodes);
+
+    if (event.phase == 'B')
+        event.time = epTraceTime();
+
+    // ring has single writer, so slot is filled before head publishes it
+    const uint64_t head = buffer->head;
+
+    buffer->events[head % buffer->capacity] = event;
+    __atomic_store_n(&buffer->head, head + 1, __ATOMIC_RELEASE);
+} // epTraceRecord
+
+void epTraceBegin( const char *name, const char *argName, uint64_t argValue, const EpNode *node ) {
+    if (!__atomic_load_n(&epTraceRecording, __ATOMIC_RELAXED))
+        return;
+
+    epTraceRecord((EpTraceEvent) {
+        .name = name,
+        .argName = argName,
+        .argValue = argValue,
+        .nodes = 0,
+        .time = 0,
+        .phase = 'B',
+        .hasNodes = false,
+    }, node);
+} // epTraceBegin
+
+void epTraceEnd( const char *name, const EpNode *node ) {
+    if (!__atomic_load_n(&epTraceRecording, __ATOMIC_RELAXED))
+        return;
+
+    epTraceRecord((EpTraceEvent) {
+        .name = name,
+        .argName = NULL,
+        .argValue = 0,
+        .nodes = 0,
+        .time = 0,
+        .phase = 'E',
+        .hasNodes = false,
+    }, node);
+} // epTraceEnd
+
+bool epTraceStart( size_t eventCapacity ) {
+    pthread_mutex_lock(&epTraceMutex);
+
+    if (epTraceRecording) {
+        pthread_mutex_unlock(&epTraceMutex);
+        return false;
+    }
+
+    epTraceEventCapacity = eventCapacity == 0
+        ? EP_TRACE_DEFAULT_EVENT_CAPACITY
+        : eventCapacity;
+    epTraceThreadCount = 0;
+    epTraceStartTime = epTraceTime();
+
+    // thread buffers of previous recording are invalidated
+    __atomic_store_n(&epTraceGeneration, epTraceGeneration + 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&epTraceRecording, true, __ATOMIC_RELAXED);
+
+    pthread_mutex_unlock(&epTraceMutex);
+    return true;
+} // epTraceStart
+
+/**
+ * @brief buffer events in Chrome trace event format dumping function
+ * 
+ * @param[in]     out    output file (non-null)
+ * @param[in]     buffer buffer to dump (non-null)
+ * @param[in,out] first  true if no event is dumped yet (non-null)
+ * 
+ * @return count of overwritten events
+ */
+static uint64_t epTraceDumpBuffer( FILE *out, const EpTraceBuffer *buffer, bool *first ) {
+    const uint64_t head = __atomic_load_n(&buffer->head, __ATOMIC_ACQUIRE);
+    const uint64_t begin = head > buffer->capacity
+        ? head - buffer->capacity
+        : 0;
+
+    fprintf(out, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"thread %u\"}}",
+        *first ? "" : ",",
+        buffer->threadId,
+        buffer->threadId
+    );
+    *first = false;
+
+    // span ends which beginnings are overwritten are skipped
+    size_t depth = 0;
+
+    for (uint64_t i = begin; i < head; i++) {
+        const EpTraceEvent *event = &buffer->events[i % buffer->capacity];
+        const uint64_t time = event->time - epTraceStartTime;
+
+        if (event->phase == 'E') {
+            if (depth == 0)
+                continue;
+            depth--;
+        } else {
+            depth++;
+        }
+
+        fprintf(out, ",\n{\"name\":\"%s\",\"cat\":\"exproc\",\"ph\":\"%c\",\"ts\":%llu.%03llu,\"pid\":1,\"tid\":%u,\"args\":{",
+            event->name,
+            event->phase,
+            (unsigned long long)(time / 1000),
+            (unsigned long long)(time % 1000),
+            buffer->threadId
+        );
+
+        if (event->argName != NULL)
+            fprintf(out, "\"%s\":%llu%s", event->argName, (unsigned long long)event->argValue, event->hasNodes ? "," : "");
+        if (event->hasNodes)
+            fprintf(out, "\"nodes\":%llu", (unsigned long long)event->nodes);
+        fprintf(out, "}}");
+    }
+
+    return begin;
+} // epTraceDumpBuffer
+
+bool epTraceStop( FILE *out ) {
+    pthread_mutex_lock(&epTraceMutex);
+
+    if (!epTraceRecording) {
+        pthread_mutex_unlock(&epTraceMutex);
+        return false;
+    }
+
+    __atomic_store_n(&epTraceRecording, false, __ATOMIC_RELAXED);
+
+    EpTraceBuffer *buffers = epTraceBuffers;
+
+    epTraceBuffers = NULL;
+    pthread_mutex_unlock(&epTraceMutex);
+
+    bool written = true;
+
+    if (out != NULL) {
+        uint64_t overwritten = 0;
+        bool first = true;
+
+        fprintf(out, "{\"traceEvents\":[");
+        for (const EpTraceBuffer *buffer = buffers; buffer != NULL; buffer = buffer->next)
+            overwritten += epTraceDumpBuffer(out, buffer, &first);
+        fprintf(out, "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"overwrittenEvents\":\"%llu\"}}\n", (unsigned long long)overwritten);
+
+        written = !ferror(out);
+    }
+
+    while (buffers != NULL) {
+        EpTraceBuffer *next = buffers->next;
+
+        free(buffers);
+        buffers = next;
+    }
+
+    return written;
+} // epTraceStop
+
+// ep_trace.c